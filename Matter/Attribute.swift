@@ -5,12 +5,87 @@
 //  Created by yonatan on 2024-07-28.
 //
 
-public final class Attribute {
-    private var attribute: esp_matter_attribute_t?
-    
-    public init(
-        _ attribute: esp_matter_attribute_t?
-    ) {
-        self.attribute = attribute
+/// A value an `Attribute` can hold. The C++ shim converts it to the type the
+/// attribute was created with (bool, enum, bitmap, int or string).
+public protocol AttributeValue {
+    static func write(_ handle: OpaquePointer, _ value: Self) -> Bool
+}
+
+extension Bool: AttributeValue {
+    public static func write(_ handle: OpaquePointer, _ value: Bool) -> Bool {
+        matter_attribute_set_uint(handle, value ? 1 : 0)
+    }
+}
+
+extension UInt8: AttributeValue {
+    public static func write(_ handle: OpaquePointer, _ value: UInt8) -> Bool {
+        matter_attribute_set_uint(handle, UInt32(value))
+    }
+}
+
+extension UInt16: AttributeValue {
+    public static func write(_ handle: OpaquePointer, _ value: UInt16) -> Bool {
+        matter_attribute_set_uint(handle, UInt32(value))
+    }
+}
+
+extension UInt32: AttributeValue {
+    public static func write(_ handle: OpaquePointer, _ value: UInt32) -> Bool {
+        matter_attribute_set_uint(handle, value)
+    }
+}
+
+extension Int8: AttributeValue {
+    public static func write(_ handle: OpaquePointer, _ value: Int8) -> Bool {
+        matter_attribute_set_int(handle, Int32(value))
+    }
+}
+
+extension Int16: AttributeValue {
+    public static func write(_ handle: OpaquePointer, _ value: Int16) -> Bool {
+        matter_attribute_set_int(handle, Int32(value))
+    }
+}
+
+extension Int32: AttributeValue {
+    public static func write(_ handle: OpaquePointer, _ value: Int32) -> Bool {
+        matter_attribute_set_int(handle, value)
+    }
+}
+
+/// Raw bytes for an octet or char string attribute; no String bridging.
+public struct Octets: AttributeValue {
+    public var bytes: [UInt8]
+
+    public init(_ bytes: [UInt8]) {
+        self.bytes = bytes
+    }
+
+    public static func write(_ handle: OpaquePointer, _ value: Octets) -> Bool {
+        value.bytes.withUnsafeBufferPointer {
+            matter_attribute_set_bytes(handle, $0.baseAddress, UInt16(truncatingIfNeeded: $0.count))
+        }
+    }
+}
+
+/// One attribute, resolved once when bound. `set` is a single C call: no
+/// endpoint/cluster/attribute lookup, unchanged values are not reported.
+public final class Attribute<Value: AttributeValue> {
+    private let handle: OpaquePointer
+
+    /// nil if the attribute does not exist on the endpoint
+    public init?(endpoint: UInt16, cluster: UInt32, id: UInt32) {
+        guard let handle = matter_attribute_bind(endpoint, cluster, id) else { return nil }
+        self.handle = handle
+    }
+
+    public convenience init?<C: Cluster>(endpoint: UInt16, cluster: C, id: UInt32) {
+        self.init(endpoint: endpoint, cluster: cluster.clusterId, id: id)
+    }
+
+    /// false if the value does not fit the attribute's type
+    @discardableResult
+    public func set(_ value: Value) -> Bool {
+        Value.write(handle, value)
     }
 }
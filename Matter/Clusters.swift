@@ -1,3 +1,20 @@
 public protocol Cluster {
     var clusterId: UInt32 { get }
-}
\ No newline at end of file
+}
+
+public struct OccupancySensingCluster: Cluster {
+    public let clusterId: UInt32 = 0x0406
+
+    public enum AttributeId {
+        public static let occupancy: UInt32 = 0x0000 // bitmap8, bit 0 = occupied
+    }
+
+    public init() {}
+}
+
+/// LD2410C vendor cluster; attribute ids are the LD2410C_ATTR_* in MatterInterface.h
+public struct LD2410CCluster: Cluster {
+    public let clusterId: UInt32 = 0xFC00
+
+    public init() {}
+}
@@ -0,0 +1,88 @@
+// Serves the LD2410C frame history (ld2410_history.h) as the EndUserSupport
+// diagnostic log. Logs larger than the inline response limit are pulled by
+// the controller over BDX (CONFIG_CHIP_ENABLE_BDX_LOG_TRANSFER).
+#include <esp_matter.h>
+#include <esp_matter_cluster.h>
+#include <esp_timer.h>
+#include <lib/support/CodeUtils.h>
+#include <app/clusters/diagnostic-logs-server/diagnostic-logs-server.h>
+#include <app/clusters/diagnostic-logs-server/DiagnosticLogsProviderDelegate.h>
+#include "MatterInterface.h"
+#include "ld2410c_wrapper.h"
+
+using namespace chip;
+using namespace chip::app::Clusters;
+using namespace chip::app::Clusters::DiagnosticLogs;
+using namespace esp_matter;
+
+namespace {
+
+class LD2410CLogProvider : public DiagnosticLogsProviderDelegate {
+public:
+    CHIP_ERROR StartLogCollection(IntentEnum intent, LogSessionHandle &outHandle, Optional<uint64_t> &outTimeStamp,
+                                  Optional<uint64_t> &outTimeSinceBoot) override
+    {
+        if (intent != IntentEnum::kEndUserSupport) return CHIP_ERROR_NOT_FOUND;
+        // The history has a single export cursor: one transfer at a time
+        if (mSession != kInvalidLogSessionHandle) return CHIP_ERROR_BUSY;
+        if (!ld2410c_history_export_begin()) return CHIP_ERROR_INCORRECT_STATE;
+        mSession = ++mNextSession;
+        if (mSession == kInvalidLogSessionHandle) mSession = ++mNextSession;
+        outHandle = mSession;
+        outTimeSinceBoot.SetValue(static_cast<uint64_t>(esp_timer_get_time()));
+        return CHIP_NO_ERROR;
+    }
+
+    CHIP_ERROR EndLogCollection(LogSessionHandle sessionHandle) override
+    {
+        if (sessionHandle != mSession) return CHIP_ERROR_INVALID_ARGUMENT;
+        mSession = kInvalidLogSessionHandle;
+        return CHIP_NO_ERROR;
+    }
+
+    CHIP_ERROR CollectLog(LogSessionHandle sessionHandle, MutableByteSpan &outBuffer, bool &outIsEndOfLog) override
+    {
+        if (sessionHandle != mSession) return CHIP_ERROR_INVALID_ARGUMENT;
+        bool done = false;
+        size_t n = ld2410c_history_export_read(outBuffer.data(), outBuffer.size(), &done);
+        outBuffer.reduce_size(n);
+        outIsEndOfLog = done;
+        return CHIP_NO_ERROR;
+    }
+
+    size_t GetSizeForIntent(IntentEnum intent) override
+    {
+        return (intent == IntentEnum::kEndUserSupport) ? ld2410c_history_export_size() : 0;
+    }
+
+    CHIP_ERROR GetLogForIntent(IntentEnum intent, MutableByteSpan &outBuffer, Optional<uint64_t> &outTimeStamp,
+                               Optional<uint64_t> &outTimeSinceBoot) override
+    {
+        LogSessionHandle handle = kInvalidLogSessionHandle;
+        ReturnErrorOnFailure(StartLogCollection(intent, handle, outTimeStamp, outTimeSinceBoot));
+        bool end = false;
+        CHIP_ERROR err = CollectLog(handle, outBuffer, end);
+        EndLogCollection(handle);
+        if (err == CHIP_NO_ERROR && !end) err = CHIP_ERROR_BUFFER_TOO_SMALL;
+        return err;
+    }
+
+private:
+    LogSessionHandle mSession = kInvalidLogSessionHandle;
+    LogSessionHandle mNextSession = 0;
+};
+
+LD2410CLogProvider g_log_provider;
+
+} // namespace
+
+void ld2410c_register_diagnostic_logs(node_t *node)
+{
+    endpoint_t *root = endpoint::get(node, 0);
+    if (!root) return;
+    if (!cluster::get(root, DiagnosticLogs::Id)) {
+        cluster::diagnostic_logs::config_t config;
+        cluster::diagnostic_logs::create(root, &config, CLUSTER_FLAG_SERVER);
+    }
+    DiagnosticLogsServer::Instance().SetDiagnosticLogsProviderDelegate(endpoint::get_id(root), &g_log_provider);
+}
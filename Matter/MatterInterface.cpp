@@ -2,13 +2,27 @@
 #include <esp_matter_cluster.h>
 #include <esp_matter_endpoint.h>
 #include <app/server/Server.h>
+#include <lib/core/TLVReader.h>
+#include <app/reporting/reporting.h>
+#include <app/InteractionModelEngine.h>
 #include "MatterInterface.h"
+#include "ld2410c_wrapper.h"
 #include <esp_matter_core.h>
 #include <functional>
+#include <cstring>
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+#include <freertos/semphr.h>
+#include <esp_log.h>
 
 using namespace chip::app::Clusters;
 using namespace esp_matter;
 
+static const char *TAG_MATTER = "ld2410_matter";
+
+// Diagnostic Logs provider for the LD2410C frame history (DiagnosticLogProvider.cpp)
+void ld2410c_register_diagnostic_logs(node_t *node);
+
 // Global callback pointer
 static device_event_callback_t g_device_event_callback = nullptr;
 
@@ -20,12 +34,266 @@ void event_callback(const chip::DeviceLayer::ChipDeviceEvent *event, intptr_t ar
     }
 }
 
+static esp_err_t ld2410c_queue_command(const ld2410c_command_t &cmd) {
+    // Published before queueing so the sensor task's result always lands last
+    ld2410c_update_vendor_command_status(cmd.id, LD2410C_CMD_STATUS_PENDING);
+    if (!ld2410c_submit_command(&cmd)) {
+        ld2410c_update_vendor_command_status(cmd.id, LD2410C_CMD_STATUS_BUSY);
+        return ESP_ERR_NO_MEM;
+    }
+    return ESP_OK;
+}
+
+// Vendor cluster commands. Fields are context tags 0..2 (unsigned or bool),
+// mapped onto ld2410c_command_t args. The UART work runs on the sensor task;
+// the command only gets validated and queued here.
+static esp_err_t ld2410c_vendor_command_cb(const chip::app::ConcreteCommandPath &path, chip::TLV::TLVReader &tlv, void *opaque) {
+    (void)opaque;
+    ld2410c_command_t cmd = {};
+    cmd.id = (uint8_t)path.mCommandId;
+    if (tlv.GetType() == chip::TLV::kTLVType_Structure) {
+        chip::TLV::TLVType outer;
+        if (tlv.EnterContainer(outer) != CHIP_NO_ERROR) return ESP_ERR_INVALID_ARG;
+        while (tlv.Next() == CHIP_NO_ERROR) {
+            if (!chip::TLV::IsContextTag(tlv.GetTag())) continue;
+            uint32_t tag = chip::TLV::TagNumFromTag(tlv.GetTag());
+            if (tag >= sizeof(cmd.args) / sizeof(cmd.args[0])) continue;
+            uint16_t v = 0;
+            bool b = false;
+            if (tlv.Get(v) == CHIP_NO_ERROR) cmd.args[tag] = v;
+            else if (tlv.Get(b) == CHIP_NO_ERROR) cmd.args[tag] = b;
+            else return ESP_ERR_INVALID_ARG;
+        }
+        tlv.ExitContainer(outer);
+    }
+    const uint16_t *a = cmd.args;
+    // Only the SetZone cm bounds are 16-bit
+    for (uint8_t i = 0; i < sizeof(cmd.args) / sizeof(cmd.args[0]); i++) {
+        if (a[i] > 0xFF && !(cmd.id == LD2410C_CMD_SET_ZONE && (i == 1 || i == 2))) return ESP_ERR_INVALID_ARG;
+    }
+    switch (cmd.id) {
+        case LD2410C_CMD_SET_GATE_THRESHOLDS:
+            if ((a[0] > 8 && a[0] != 0xFF) || a[1] > 100 || a[2] > 100) return ESP_ERR_INVALID_ARG;
+            break;
+        case LD2410C_CMD_SET_MAX_GATES:
+            if (a[0] > 8 || a[1] > 8) return ESP_ERR_INVALID_ARG;
+            break;
+        case LD2410C_CMD_SET_RESOLUTION:
+            if (a[0] > 1) return ESP_ERR_INVALID_ARG;
+            break;
+        case LD2410C_CMD_SELECT_PROFILE:
+        case LD2410C_CMD_SAVE_PROFILE:
+            if (a[0] >= LD2410C_PROFILE_COUNT) return ESP_ERR_INVALID_ARG;
+            break;
+        case LD2410C_CMD_SET_ZONE:
+            if (a[0] >= LD2410C_ZONE_MAX || a[2] < a[1] || a[3] > 100 || a[4] > 100) return ESP_ERR_INVALID_ARG;
+            break;
+        default:
+            break;
+    }
+    return ld2410c_queue_command(cmd);
+}
+
+// Writable vendor attributes. A write to ActiveProfile becomes a
+// SelectProfile command; the sensor task publishes the slot it ends up on.
+static esp_err_t ld2410c_attribute_cb(attribute::callback_type_t type, uint16_t endpoint_id, uint32_t cluster_id,
+                                      uint32_t attribute_id, esp_matter_attr_val_t *val, void *priv_data) {
+    (void)endpoint_id; (void)priv_data;
+    if (type != attribute::PRE_UPDATE || cluster_id != LD2410C_CLUSTER_ID || attribute_id != LD2410C_ATTR_ACTIVE_PROFILE) return ESP_OK;
+    if (val->type != ESP_MATTER_VAL_TYPE_UINT8 || val->val.u8 >= LD2410C_PROFILE_COUNT) return ESP_ERR_INVALID_ARG;
+    ld2410c_command_t cmd = {};
+    cmd.id = LD2410C_CMD_SELECT_PROFILE;
+    cmd.args[0] = val->val.u8;
+    return ld2410c_queue_command(cmd);
+}
+
+// ---------------- Attribute handles ----------------
+// A handle is the attribute_t plus its path, resolved once. Writes convert
+// to the type the attribute was created with and skip unchanged values.
+// Vendor attributes are stored with set_val and their path marked for
+// reporting: no endpoint/cluster/attribute lookup per write. Standard
+// clusters go through attribute::update so the application callback still
+// sees PRE/POST_UPDATE (Occupancy and the like).
+#define MATTER_ATTR_HANDLES 16
+
+struct matter_attribute_handle_s {
+    attribute_t *attr;
+    uint16_t endpoint_id;
+    uint32_t cluster_id;
+    uint32_t attribute_id;
+};
+static matter_attribute_handle_s g_attr_handles[MATTER_ATTR_HANDLES];
+static uint8_t g_attr_handles_used = 0;
+// Binds come from the Swift main task and the sensor task (zone endpoints)
+static SemaphoreHandle_t g_attr_handles_lock = nullptr;
+
+static bool resolve_handle(matter_attribute_handle_s *h, uint16_t endpoint_id, uint32_t cluster_id, uint32_t attribute_id) {
+    node_t *node = node::get();
+    cluster_t *cluster = node ? cluster::get(endpoint::get(node, endpoint_id), cluster_id) : nullptr;
+    h->attr = cluster ? attribute::get(cluster, attribute_id) : nullptr;
+    h->endpoint_id = endpoint_id;
+    h->cluster_id = cluster_id;
+    h->attribute_id = attribute_id;
+    return h->attr != nullptr;
+}
+
+static bool same_value(const esp_matter_attr_val_t &a, const esp_matter_attr_val_t &b) {
+    if (a.type != b.type) return false;
+    switch (a.type) {
+        case ESP_MATTER_VAL_TYPE_BOOLEAN: return a.val.b == b.val.b;
+        case ESP_MATTER_VAL_TYPE_INT8: return a.val.i8 == b.val.i8;
+        case ESP_MATTER_VAL_TYPE_INT16: return a.val.i16 == b.val.i16;
+        case ESP_MATTER_VAL_TYPE_INT32: return a.val.i32 == b.val.i32;
+        case ESP_MATTER_VAL_TYPE_UINT8: case ESP_MATTER_VAL_TYPE_ENUM8: case ESP_MATTER_VAL_TYPE_BITMAP8: return a.val.u8 == b.val.u8;
+        case ESP_MATTER_VAL_TYPE_UINT16: case ESP_MATTER_VAL_TYPE_BITMAP16: return a.val.u16 == b.val.u16;
+        case ESP_MATTER_VAL_TYPE_UINT32: case ESP_MATTER_VAL_TYPE_BITMAP32: return a.val.u32 == b.val.u32;
+        case ESP_MATTER_VAL_TYPE_CHAR_STRING: case ESP_MATTER_VAL_TYPE_OCTET_STRING:
+            return a.val.a.s == b.val.a.s && (a.val.a.s == 0 || memcmp(a.val.a.b, b.val.a.b, a.val.a.s) == 0);
+        default: return false;
+    }
+}
+
+// Caller holds the CHIP stack lock
+static esp_err_t write_handle_locked(const matter_attribute_handle_s *h, esp_matter_attr_val_t *val) {
+    if (!h || !h->attr) return ESP_ERR_INVALID_ARG;
+    esp_matter_attr_val_t cur;
+    if (attribute::get_val(h->attr, &cur) == ESP_OK && same_value(cur, *val)) return ESP_OK;
+    // Manufacturer-specific cluster ids are 0xFC00..0xFFFE in the low 16 bits
+    if ((h->cluster_id & 0xFFFF) < 0xFC00) return attribute::update(h->endpoint_id, h->cluster_id, h->attribute_id, val);
+    esp_err_t err = attribute::set_val(h->attr, val);
+    if (err == ESP_OK) MatterReportingAttributeChangeCallback(h->endpoint_id, h->cluster_id, h->attribute_id);
+    return err;
+}
+
+static esp_err_t write_handle(const matter_attribute_handle_s *h, esp_matter_attr_val_t *val) {
+    lock::status_t st = lock::chip_stack_lock(portMAX_DELAY);
+    if (st == lock::FAILED) return ESP_FAIL;
+    esp_err_t err = write_handle_locked(h, val);
+    if (st == lock::SUCCESS) lock::chip_stack_unlock();
+    return err;
+}
+
+// Integer in the attribute's own type (bool, enum8, bitmapN, uintN, intN)
+static bool convert_int(attribute_t *attr, int64_t v, esp_matter_attr_val_t *out) {
+    if (!attr || attribute::get_val(attr, out) != ESP_OK) return false;
+    switch (out->type) {
+        case ESP_MATTER_VAL_TYPE_BOOLEAN: out->val.b = v != 0; return true;
+        case ESP_MATTER_VAL_TYPE_INT8: out->val.i8 = (int8_t)v; return true;
+        case ESP_MATTER_VAL_TYPE_INT16: out->val.i16 = (int16_t)v; return true;
+        case ESP_MATTER_VAL_TYPE_INT32: out->val.i32 = (int32_t)v; return true;
+        case ESP_MATTER_VAL_TYPE_UINT8: case ESP_MATTER_VAL_TYPE_ENUM8: case ESP_MATTER_VAL_TYPE_BITMAP8: out->val.u8 = (uint8_t)v; return true;
+        case ESP_MATTER_VAL_TYPE_UINT16: case ESP_MATTER_VAL_TYPE_BITMAP16: out->val.u16 = (uint16_t)v; return true;
+        case ESP_MATTER_VAL_TYPE_UINT32: case ESP_MATTER_VAL_TYPE_BITMAP32: out->val.u32 = (uint32_t)v; return true;
+        default: return false;
+    }
+}
+
+// ---------------- Read-through vendor attributes ----------------
+// The gate arrays, thresholds, firmware string and max range are large or
+// rarely read, so the data model does not store them: they are created with
+// ATTRIBUTE_FLAG_OVERRIDE, publishing copies them into this snapshot and
+// marks changed paths dirty, and a read or report pulls the value from here.
+enum LazyAttr : uint8_t {
+    LAZY_MOVING_SIGNALS, LAZY_STATIONARY_SIGNALS, LAZY_MOVING_THRESHOLDS, LAZY_STATIONARY_THRESHOLDS,
+    LAZY_FIRMWARE_VERSION, LAZY_MAX_RANGE, LAZY_COUNT
+};
+static const uint32_t g_lazy_ids[LAZY_COUNT] = {
+    LD2410C_ATTR_MOVING_GATES_SIGNALS, LD2410C_ATTR_STATIONARY_GATES_SIGNALS, LD2410C_ATTR_MOVING_THRESHOLDS,
+    LD2410C_ATTR_STATIONARY_THRESHOLDS, LD2410C_ATTR_FIRMWARE_VERSION, LD2410C_ATTR_MAX_RANGE_CM,
+};
+#define LD2410C_LAZY_MAX 32
+
+struct LazyValue {
+    uint8_t len;
+    uint8_t bytes[LD2410C_LAZY_MAX];
+};
+static LazyValue g_lazy[LAZY_COUNT];      // written by the publishing task
+static LazyValue g_lazy_read[LAZY_COUNT]; // CHIP thread: what the last read of each handed out
+static SemaphoreHandle_t g_lazy_lock = nullptr;
+
+// Copies into the snapshot; true when the value changed
+static bool lazy_store(LazyAttr a, const void *buf, uint8_t len) {
+    if (!g_lazy_lock || len > LD2410C_LAZY_MAX) return false;
+    LazyValue &v = g_lazy[a];
+    xSemaphoreTake(g_lazy_lock, portMAX_DELAY);
+    bool changed = v.len != len || memcmp(v.bytes, buf, len) != 0;
+    if (changed) {
+        memcpy(v.bytes, buf, len);
+        v.len = len;
+    }
+    xSemaphoreGive(g_lazy_lock);
+    return changed;
+}
+
+// Override callback, on the CHIP thread for every read and report of a
+// read-through attribute. val points into g_lazy_read until the next read.
+static esp_err_t ld2410c_lazy_read_cb(attribute::callback_type_t type, uint16_t endpoint_id, uint32_t cluster_id,
+                                      uint32_t attribute_id, esp_matter_attr_val_t *val, void *priv_data) {
+    (void)endpoint_id; (void)priv_data;
+    int i = 0;
+    while (i < LAZY_COUNT && g_lazy_ids[i] != attribute_id) i++;
+    if (type != attribute::READ || cluster_id != LD2410C_CLUSTER_ID || i == LAZY_COUNT || !g_lazy_lock) return ESP_ERR_NOT_SUPPORTED;
+    LazyValue &r = g_lazy_read[i];
+    xSemaphoreTake(g_lazy_lock, portMAX_DELAY);
+    r = g_lazy[i];
+    xSemaphoreGive(g_lazy_lock);
+    if (i == LAZY_MAX_RANGE) *val = esp_matter_uint16(r.len == 2 ? (uint16_t)(r.bytes[0] | (r.bytes[1] << 8)) : 0);
+    else if (i == LAZY_FIRMWARE_VERSION) *val = esp_matter_char_str((char*)r.bytes, r.len);
+    else *val = esp_matter_octet_str(r.bytes, r.len);
+    return ESP_OK;
+}
+
+static void create_lazy(cluster_t *cluster, uint32_t attribute_id, esp_matter_attr_val_t val) {
+    attribute_t *a = attribute::create(cluster, attribute_id, ATTRIBUTE_FLAG_OVERRIDE, val);
+    if (a) attribute::set_override_callback(a, ld2410c_lazy_read_cb);
+}
+
 extern "C" {
 
+matter_attribute_handle_t *matter_attribute_bind(uint16_t endpoint_id, uint32_t cluster_id, uint32_t attribute_id) {
+    if (!g_attr_handles_lock) return nullptr; // no node yet
+    matter_attribute_handle_s *found = nullptr;
+    xSemaphoreTake(g_attr_handles_lock, portMAX_DELAY);
+    for (uint8_t i = 0; i < g_attr_handles_used && !found; i++) {
+        matter_attribute_handle_s *h = &g_attr_handles[i];
+        if (h->endpoint_id == endpoint_id && h->cluster_id == cluster_id && h->attribute_id == attribute_id) found = h;
+    }
+    if (!found && g_attr_handles_used < MATTER_ATTR_HANDLES) {
+        matter_attribute_handle_s *h = &g_attr_handles[g_attr_handles_used];
+        if (resolve_handle(h, endpoint_id, cluster_id, attribute_id)) {
+            g_attr_handles_used++;
+            found = h;
+        }
+    }
+    xSemaphoreGive(g_attr_handles_lock);
+    return found;
+}
+
+bool matter_attribute_set_uint(matter_attribute_handle_t *h, uint32_t value) {
+    esp_matter_attr_val_t val;
+    return h && convert_int(h->attr, value, &val) && write_handle(h, &val) == ESP_OK;
+}
+
+bool matter_attribute_set_int(matter_attribute_handle_t *h, int32_t value) {
+    esp_matter_attr_val_t val;
+    return h && convert_int(h->attr, value, &val) && write_handle(h, &val) == ESP_OK;
+}
+
+bool matter_attribute_set_bytes(matter_attribute_handle_t *h, const uint8_t *bytes, uint16_t len) {
+    esp_matter_attr_val_t val;
+    if (!h || (!bytes && len) || attribute::get_val(h->attr, &val) != ESP_OK) return false;
+    if (val.type == ESP_MATTER_VAL_TYPE_CHAR_STRING) val = esp_matter_char_str((char*)bytes, len);
+    else if (val.type == ESP_MATTER_VAL_TYPE_OCTET_STRING) val = esp_matter_octet_str((uint8_t*)bytes, len);
+    else return false;
+    return write_handle(h, &val) == ESP_OK;
+}
+
 esp_matter_node_t *esp_matter_node_create_wrapper() {
     // First, create a node
     node::config_t node_config;
-    node_t *node = node::create(&node_config, nullptr, nullptr);
+    node_t *node = node::create(&node_config, ld2410c_attribute_cb, nullptr);
+    if (!g_attr_handles_lock) g_attr_handles_lock = xSemaphoreCreateMutex();
+    if (node) ld2410c_register_diagnostic_logs(node);
     return reinterpret_cast<esp_matter_node_t*>(node);
 }
 
@@ -45,88 +313,285 @@ uint16_t create_occupancy_sensor_endpoint(esp_matter_node_t *node, const char* r
     // Create vendor-specific LD2410C cluster and all attributes upfront to avoid runtime creation races
     cluster_t *vendor_cluster = cluster::create(endpoint, LD2410C_CLUSTER_ID, CLUSTER_FLAG_SERVER);
     if (vendor_cluster) {
+        if (!g_lazy_lock) g_lazy_lock = xSemaphoreCreateMutex();
         attribute::create(vendor_cluster, LD2410C_ATTR_MOVING_TARGET_DISTANCE_CM, 0, esp_matter_uint16(0));
         attribute::create(vendor_cluster, LD2410C_ATTR_MOVING_TARGET_SIGNAL, 0, esp_matter_uint8(0));
         attribute::create(vendor_cluster, LD2410C_ATTR_STATIONARY_TARGET_DISTANCE_CM, 0, esp_matter_uint16(0));
         attribute::create(vendor_cluster, LD2410C_ATTR_STATIONARY_TARGET_SIGNAL, 0, esp_matter_uint8(0));
         attribute::create(vendor_cluster, LD2410C_ATTR_COMBINED_DISTANCE_CM, 0, esp_matter_uint16(0));
         attribute::create(vendor_cluster, LD2410C_ATTR_ENHANCED_MODE, 0, esp_matter_bool(false));
-        attribute::create(vendor_cluster, LD2410C_ATTR_MAX_RANGE_CM, 0, esp_matter_uint16(0));
+        create_lazy(vendor_cluster, LD2410C_ATTR_MAX_RANGE_CM, esp_matter_uint16(0));
         attribute::create(vendor_cluster, LD2410C_ATTR_LIGHT_LEVEL, 0, esp_matter_uint8(0));
         attribute::create(vendor_cluster, LD2410C_ATTR_LIGHT_THRESHOLD, 0, esp_matter_uint8(0));
         attribute::create(vendor_cluster, LD2410C_ATTR_OUTPUT_LEVEL, 0, esp_matter_uint8(0));
         attribute::create(vendor_cluster, LD2410C_ATTR_AUTO_THRESHOLD_STATUS, 0, esp_matter_uint8(0));
+        attribute::create(vendor_cluster, LD2410C_ATTR_TRACKED_MOVING_DISTANCE_CM, 0, esp_matter_uint16(0));
+        attribute::create(vendor_cluster, LD2410C_ATTR_MOVING_VELOCITY_CM_S, 0, esp_matter_int16(0));
+        attribute::create(vendor_cluster, LD2410C_ATTR_TRACKED_STATIONARY_DISTANCE_CM, 0, esp_matter_uint16(0));
+        attribute::create(vendor_cluster, LD2410C_ATTR_TRACKED_COMBINED_DISTANCE_CM, 0, esp_matter_uint16(0));
+        attribute::create(vendor_cluster, LD2410C_ATTR_TRACKING_ENABLED, 0, esp_matter_bool(false));
+        attribute::create(vendor_cluster, LD2410C_ATTR_SUPPORTED_CAPABILITIES, 0, esp_matter_bitmap32(0));
         // Empty strings/arrays
         static uint8_t empty_octets[1] = {0};
-        attribute::create(vendor_cluster, LD2410C_ATTR_MOVING_GATES_SIGNALS, 0, esp_matter_octet_str(empty_octets, 0));
-        attribute::create(vendor_cluster, LD2410C_ATTR_STATIONARY_GATES_SIGNALS, 0, esp_matter_octet_str(empty_octets, 0));
-        attribute::create(vendor_cluster, LD2410C_ATTR_MOVING_THRESHOLDS, 0, esp_matter_octet_str(empty_octets, 0));
-        attribute::create(vendor_cluster, LD2410C_ATTR_STATIONARY_THRESHOLDS, 0, esp_matter_octet_str(empty_octets, 0));
-        attribute::create(vendor_cluster, LD2410C_ATTR_FIRMWARE_VERSION, 0, esp_matter_char_str((char*)"", 0));
+        create_lazy(vendor_cluster, LD2410C_ATTR_MOVING_GATES_SIGNALS, esp_matter_octet_str(empty_octets, 0));
+        create_lazy(vendor_cluster, LD2410C_ATTR_STATIONARY_GATES_SIGNALS, esp_matter_octet_str(empty_octets, 0));
+        create_lazy(vendor_cluster, LD2410C_ATTR_MOVING_THRESHOLDS, esp_matter_octet_str(empty_octets, 0));
+        create_lazy(vendor_cluster, LD2410C_ATTR_STATIONARY_THRESHOLDS, esp_matter_octet_str(empty_octets, 0));
+        create_lazy(vendor_cluster, LD2410C_ATTR_FIRMWARE_VERSION, esp_matter_char_str((char*)"", 0));
+        attribute::create(vendor_cluster, LD2410C_ATTR_COMMAND_RTT_STATS, 0, esp_matter_octet_str(empty_octets, 0));
+        attribute::create(vendor_cluster, LD2410C_ATTR_LAST_COMMAND_ID, 0, esp_matter_uint8(LD2410C_CMD_STATUS_NONE));
+        attribute::create(vendor_cluster, LD2410C_ATTR_LAST_COMMAND_STATUS, 0, esp_matter_uint8(LD2410C_CMD_STATUS_NONE));
+        attribute::create(vendor_cluster, LD2410C_ATTR_RECOVERY_COUNT, 0, esp_matter_uint32(0));
+        attribute::create(vendor_cluster, LD2410C_ATTR_RECOVERY_STAGE, 0, esp_matter_uint8(0));
+        attribute::create(vendor_cluster, LD2410C_ATTR_ACTIVE_PROFILE, ATTRIBUTE_FLAG_WRITABLE, esp_matter_uint8(0xFF));
+        attribute::create(vendor_cluster, LD2410C_ATTR_PROFILE_SWITCH_MS, 0, esp_matter_uint16(0));
+        attribute::create(vendor_cluster, LD2410C_ATTR_TRAJECTORY_STATE, 0, esp_matter_uint8(0));
+        attribute::create(vendor_cluster, LD2410C_ATTR_FRAME_REPEAT_PERCENT, 0, esp_matter_uint8(0));
+        attribute::create(vendor_cluster, LD2410C_ATTR_MODE_SWITCHES, 0, esp_matter_uint32(0));
+        attribute::create(vendor_cluster, LD2410C_ATTR_MODE_SWITCH_MS, 0, esp_matter_uint16(0));
+        attribute::create(vendor_cluster, LD2410C_ATTR_ENGINEERING_PERCENT, 0, esp_matter_uint8(0));
+        attribute::create(vendor_cluster, LD2410C_ATTR_SUBGATE_DISTANCE_CM, 0, esp_matter_uint16(0));
+        attribute::create(vendor_cluster, LD2410C_ATTR_BOOT_FIRST_FRAME_MS, 0, esp_matter_uint16(0));
+        attribute::create(vendor_cluster, LD2410C_ATTR_START_KIND, 0, esp_matter_uint8(0));
+        for (uint32_t id = 0; id < LD2410C_CMD_COUNT; id++) {
+            command::create(vendor_cluster, id, COMMAND_FLAG_ACCEPTED, ld2410c_vendor_command_cb);
+        }
     }
     return endpoint::get_id(endpoint);
 }
 
+uint16_t create_zone_occupancy_endpoint(esp_matter_node_t *node) {
+    node_t *cpp_node = reinterpret_cast<node_t*>(node);
+    if (!cpp_node) {
+        return 0;
+    }
+    using namespace esp_matter::endpoint;
+    // Same sensing config as the main endpoint, without the vendor cluster
+    occupancy_sensor::config_t cfg;
+    cfg.occupancy_sensing.feature_flags = (1 << 0) | (1 << 1);
+    cfg.occupancy_sensing.occupancy_sensor_type = 0x04;
+    cfg.occupancy_sensing.occupancy_sensor_type_bitmap = (1 << 2);
+    endpoint_t *endpoint = occupancy_sensor::create(cpp_node, &cfg, ENDPOINT_FLAG_NONE, nullptr);
+    if (!endpoint) return 0;
+    return endpoint::get_id(endpoint);
+}
+
 void set_occupancy_attribute_value(uint16_t endpoint_id, bool occupied) {
-    node_t *node = node::get();
-    if (!node) return;
-    endpoint_t *endpoint = endpoint::get(node, endpoint_id);
-    if (!endpoint) {
-        return;
+    // Bound once per endpoint; later calls find the handle in the pool
+    matter_attribute_set_uint(matter_attribute_bind(endpoint_id, OccupancySensing::Id, OccupancySensing::Attributes::Occupancy::Id), occupied);
+}
+
+// ---------------- Vendor Cluster Support ----------------
+static uint16_t g_ld2410c_vendor_endpoint = 0xFFFF;
+
+// Subscriptions that cover the gate signal attributes, or the sub-gate
+// distance computed from them, keep the sensor in engineering mode.
+// Wildcard paths count: they receive those attributes too.
+// Counted, not tracked: the engine calls Terminated once for every
+// Established, with the handler's path list still attached, so the same
+// test finds the same answer. The engine holds a single application
+// callback; the one registered before this watch gets every call forwarded.
+class GateSubscriptionWatch : public chip::app::ReadHandler::ApplicationCallback {
+public:
+    chip::app::ReadHandler::ApplicationCallback *next = nullptr;
+
+    CHIP_ERROR OnSubscriptionRequested(chip::app::ReadHandler &handler, chip::Transport::SecureSession &session) override {
+        return next ? next->OnSubscriptionRequested(handler, session) : CHIP_NO_ERROR;
     }
-    cluster_t *cluster = cluster::get(endpoint, OccupancySensing::Id);
-    if (!cluster) {
-        return;
+    void OnSubscriptionEstablished(chip::app::ReadHandler &handler) override {
+        if (covers(handler)) {
+            covering++;
+            ld2410c_set_gate_demand(LD2410C_GATE_DEMAND_SUBSCRIPTION, true);
+        }
+        if (next) next->OnSubscriptionEstablished(handler);
     }
-    attribute_t *attribute = attribute::get(cluster, OccupancySensing::Attributes::Occupancy::Id);
-    if (!attribute) {
-        return;
+    void OnSubscriptionTerminated(chip::app::ReadHandler &handler) override {
+        if (covers(handler) && covering && !--covering) ld2410c_set_gate_demand(LD2410C_GATE_DEMAND_SUBSCRIPTION, false);
+        if (next) next->OnSubscriptionTerminated(handler);
     }
-    esp_matter_attr_val_t val = esp_matter_bool(occupied);
-    attribute::update(endpoint_id, OccupancySensing::Id, OccupancySensing::Attributes::Occupancy::Id, &val);
-}
+
+private:
+    uint32_t covering = 0; // only touched on the CHIP thread
+
+    static bool covers(const chip::app::ReadHandler &handler) {
+        for (auto *n = handler.GetAttributePathList(); n; n = n->mpNext) {
+            const chip::app::AttributePathParams &p = n->mValue;
+            if (!p.HasWildcardEndpointId() && p.mEndpointId != g_ld2410c_vendor_endpoint) continue;
+            if (!p.HasWildcardClusterId() && p.mClusterId != LD2410C_CLUSTER_ID) continue;
+            if (p.HasWildcardAttributeId() || p.mAttributeId == LD2410C_ATTR_MOVING_GATES_SIGNALS ||
+                p.mAttributeId == LD2410C_ATTR_STATIONARY_GATES_SIGNALS ||
+                p.mAttributeId == LD2410C_ATTR_SUBGATE_DISTANCE_CM) return true;
+        }
+        return false;
+    }
+};
+static GateSubscriptionWatch g_gate_watch;
 
 void esp_matter_start_wrapper(device_event_callback_t callback)
 {
     g_device_event_callback = callback;
     esp_matter::start(event_callback);
+    if (lock::chip_stack_lock(portMAX_DELAY) != lock::SUCCESS) {
+        ESP_LOGE(TAG_MATTER, "No CHIP stack lock: gate subscriptions will not switch engineering mode");
+        return;
+    }
+    chip::app::InteractionModelEngine *engine = chip::app::InteractionModelEngine::GetInstance();
+    if (engine->GetAppCallback() != &g_gate_watch) {
+        g_gate_watch.next = engine->GetAppCallback();
+        engine->RegisterReadHandlerAppCallback(&g_gate_watch);
+    }
+    lock::chip_stack_unlock();
 }
 
-// ---------------- Vendor Cluster Support ----------------
-static uint16_t g_ld2410c_vendor_endpoint = 0xFFFF;
+// Publish batching. Between ld2410c_vendor_publish_begin/commit, vendor
+// updates from the opening task are checked against a shadow of the last
+// applied value, staged in a fixed buffer when they differ, and applied
+// together under one CHIP stack lock, along with the dirty marks of changed
+// read-through attributes. Any other update is applied at once.
+#define LD2410C_BATCH_MAX 24
+#define LD2410C_BATCH_BYTES 160
+#define LD2410C_SHADOW_ATTRS 0x28  // vendor attribute ids below this are shadowed
+#define LD2410C_SHADOW_STRINGS 2
+#define LD2410C_SHADOW_STR_MAX 32
+
+struct StagedUpdate {
+    uint32_t attr_id;
+    esp_matter_attr_val_t val;
+};
+static StagedUpdate g_batch[LD2410C_BATCH_MAX];
+static uint8_t g_batch_len = 0;
+static uint8_t g_batch_bytes[LD2410C_BATCH_BYTES];
+static uint16_t g_batch_bytes_used = 0;
+static TaskHandle_t g_batch_owner = nullptr;
+static uint8_t g_lazy_dirty = 0; // LazyAttr bits
 
-// All attributes pre-created; helper no longer needed.
+struct Shadow {
+    bool valid;
+    int8_t str;      // slot in g_shadow_str, -1 = none
+    uint8_t len;
+    uint32_t scalar;
+};
+static Shadow g_shadow[LD2410C_SHADOW_ATTRS];
+static matter_attribute_handle_s g_vendor_attrs[LD2410C_SHADOW_ATTRS]; // bound by ld2410c_set_vendor_endpoint
+static uint8_t g_shadow_str[LD2410C_SHADOW_STRINGS][LD2410C_SHADOW_STR_MAX];
+static uint8_t g_shadow_str_used = 0;
+
+static bool is_string_val(const esp_matter_attr_val_t &v) {
+    return v.type == ESP_MATTER_VAL_TYPE_CHAR_STRING || v.type == ESP_MATTER_VAL_TYPE_OCTET_STRING;
+}
+
+static uint32_t scalar_bits(const esp_matter_attr_val_t &v) {
+    switch (v.type) {
+        case ESP_MATTER_VAL_TYPE_BOOLEAN: return v.val.b;
+        case ESP_MATTER_VAL_TYPE_UINT8: return v.val.u8;
+        case ESP_MATTER_VAL_TYPE_UINT16: return v.val.u16;
+        case ESP_MATTER_VAL_TYPE_INT8: return (uint8_t)v.val.i8;
+        case ESP_MATTER_VAL_TYPE_INT16: return (uint16_t)v.val.i16;
+        default: return v.val.u32;
+    }
+}
+
+static bool shadow_matches(uint32_t attr_id, const esp_matter_attr_val_t &v) {
+    if (attr_id >= LD2410C_SHADOW_ATTRS || !g_shadow[attr_id].valid) return false;
+    const Shadow &sh = g_shadow[attr_id];
+    if (!is_string_val(v)) return sh.scalar == scalar_bits(v);
+    return sh.str >= 0 && sh.len == v.val.a.s && memcmp(g_shadow_str[sh.str], v.val.a.b, sh.len) == 0;
+}
+
+static void shadow_store(uint32_t attr_id, const esp_matter_attr_val_t &v) {
+    if (attr_id >= LD2410C_SHADOW_ATTRS) return;
+    Shadow &sh = g_shadow[attr_id];
+    if (!is_string_val(v)) {
+        sh.scalar = scalar_bits(v);
+        sh.valid = true;
+        return;
+    }
+    if (!sh.valid) sh.str = -1;
+    if (sh.str < 0 && g_shadow_str_used < LD2410C_SHADOW_STRINGS) sh.str = (int8_t)g_shadow_str_used++;
+    if (sh.str < 0 || v.val.a.s > LD2410C_SHADOW_STR_MAX) { sh.valid = false; return; } // not shadowed
+    memcpy(g_shadow_str[sh.str], v.val.a.b, v.val.a.s);
+    sh.len = (uint8_t)v.val.a.s;
+    sh.valid = true;
+}
 
-static void update_attr_uint16(uint16_t endpoint_id, uint32_t cluster_id, uint32_t attr_id, uint16_t v) {
-    esp_matter_attr_val_t val = esp_matter_uint16(v);
-    node_t *node = node::get(); if (!node) return; endpoint_t *ep = endpoint::get(node, endpoint_id); if (!ep) return; cluster_t *cl = cluster::get(ep, cluster_id); if (!cl) return; attribute_t *attr = attribute::get(cl, attr_id); if (!attr) return; attribute::update(endpoint_id, cluster_id, attr_id, &val);
+static esp_err_t apply_one(StagedUpdate &u) {
+    if (u.attr_id < LD2410C_SHADOW_ATTRS) return write_handle_locked(&g_vendor_attrs[u.attr_id], &u.val);
+    return attribute::update(g_ld2410c_vendor_endpoint, LD2410C_CLUSTER_ID, u.attr_id, &u.val);
 }
-static void update_attr_uint8(uint16_t endpoint_id, uint32_t cluster_id, uint32_t attr_id, uint8_t v) {
-    esp_matter_attr_val_t val = esp_matter_uint8(v);
-    node_t *node = node::get(); if (!node) return; endpoint_t *ep = endpoint::get(node, endpoint_id); if (!ep) return; cluster_t *cl = cluster::get(ep, cluster_id); if (!cl) return; attribute_t *attr = attribute::get(cl, attr_id); if (!attr) return; attribute::update(endpoint_id, cluster_id, attr_id, &val);
+
+static void apply_updates(StagedUpdate *u, uint8_t n, bool shadow, uint8_t lazy_dirty = 0) {
+    if (!n && !lazy_dirty) return;
+    lock::status_t st = lock::chip_stack_lock(portMAX_DELAY);
+    if (st == lock::FAILED) return;
+    for (uint8_t i = 0; i < n; i++) {
+        if (apply_one(u[i]) == ESP_OK && shadow) shadow_store(u[i].attr_id, u[i].val);
+    }
+    for (uint8_t i = 0; i < LAZY_COUNT; i++) {
+        if (lazy_dirty & (1u << i)) MatterReportingAttributeChangeCallback(g_ld2410c_vendor_endpoint, LD2410C_CLUSTER_ID, g_lazy_ids[i]);
+    }
+    if (st == lock::SUCCESS) lock::chip_stack_unlock();
 }
-static void update_attr_bool(uint16_t endpoint_id, uint32_t cluster_id, uint32_t attr_id, bool v) {
-    esp_matter_attr_val_t val = esp_matter_bool(v);
-    node_t *node = node::get(); if (!node) return; endpoint_t *ep = endpoint::get(node, endpoint_id); if (!ep) return; cluster_t *cl = cluster::get(ep, cluster_id); if (!cl) return; attribute_t *attr = attribute::get(cl, attr_id); if (!attr) return; attribute::update(endpoint_id, cluster_id, attr_id, &val);
+
+static void flush_batch() {
+    apply_updates(g_batch, g_batch_len, true, g_lazy_dirty);
+    g_lazy_dirty = 0;
+    g_batch_len = 0;
+    g_batch_bytes_used = 0;
 }
-static void update_attr_string(uint16_t endpoint_id, uint32_t cluster_id, uint32_t attr_id, const char *s) {
-    if (!s) return;
-    size_t len = strlen(s);
-    esp_matter_attr_val_t val = esp_matter_char_str((char*)s, len);
-    node_t *node = node::get(); if (!node) return; endpoint_t *ep = endpoint::get(node, endpoint_id); if (!ep) return; cluster_t *cl = cluster::get(ep, cluster_id); if (!cl) return; attribute_t *attr = attribute::get(cl, attr_id); if (!attr) return; attribute::update(endpoint_id, cluster_id, attr_id, &val);
+
+static void stage(uint32_t attr_id, esp_matter_attr_val_t val) {
+    if (!g_batch_owner || g_batch_owner != xTaskGetCurrentTaskHandle()) {
+        StagedUpdate u = {attr_id, val};
+        apply_updates(&u, 1, false);
+        return;
+    }
+    if (shadow_matches(attr_id, val)) return;
+    uint16_t len = is_string_val(val) ? val.val.a.s : 0;
+    if (g_batch_len == LD2410C_BATCH_MAX || g_batch_bytes_used + len > LD2410C_BATCH_BYTES) flush_batch();
+    if (len) { // the caller's buffer may change before commit
+        uint8_t *copy = g_batch_bytes + g_batch_bytes_used;
+        memcpy(copy, val.val.a.b, len);
+        val.val.a.b = copy;
+        g_batch_bytes_used += len;
+    }
+    g_batch[g_batch_len++] = {attr_id, val};
 }
-static void update_attr_octets(uint16_t endpoint_id, uint32_t cluster_id, uint32_t attr_id, const uint8_t *buf, uint8_t len) {
+
+static void stage_uint8(uint32_t attr_id, uint8_t v) { stage(attr_id, esp_matter_uint8(v)); }
+static void stage_uint16(uint32_t attr_id, uint16_t v) { stage(attr_id, esp_matter_uint16(v)); }
+static void stage_int16(uint32_t attr_id, int16_t v) { stage(attr_id, esp_matter_int16(v)); }
+static void stage_bool(uint32_t attr_id, bool v) { stage(attr_id, esp_matter_bool(v)); }
+static void stage_octets(uint32_t attr_id, const uint8_t *buf, uint8_t len) {
     if (!buf || len == 0) return;
-    esp_matter_attr_val_t val = esp_matter_octet_str((uint8_t*)buf, len);
-    node_t *node = node::get(); if (!node) return; endpoint_t *ep = endpoint::get(node, endpoint_id); if (!ep) return; cluster_t *cl = cluster::get(ep, cluster_id); if (!cl) return; attribute_t *attr = attribute::get(cl, attr_id); if (!attr) return; attribute::update(endpoint_id, cluster_id, attr_id, &val);
+    stage(attr_id, esp_matter_octet_str((uint8_t*)buf, len));
+}
+// Read-through attributes: snapshot only, the path is marked dirty with the batch
+static void stage_lazy(LazyAttr a, const void *buf, uint8_t len) {
+    if (!lazy_store(a, buf, len)) return;
+    if (g_batch_owner && g_batch_owner == xTaskGetCurrentTaskHandle()) g_lazy_dirty |= 1u << a;
+    else apply_updates(nullptr, 0, false, 1u << a);
 }
 
 extern "C" {
 
 void ld2410c_set_vendor_endpoint(uint16_t endpoint_id) {
+    for (uint32_t id = 0; id < LD2410C_SHADOW_ATTRS; id++) resolve_handle(&g_vendor_attrs[id], endpoint_id, LD2410C_CLUSTER_ID, id);
     g_ld2410c_vendor_endpoint = endpoint_id;
 }
 
+void ld2410c_vendor_publish_begin() {
+    g_batch_owner = xTaskGetCurrentTaskHandle();
+}
+
+void ld2410c_vendor_publish_commit() {
+    if (g_batch_owner != xTaskGetCurrentTaskHandle()) return;
+    if (g_ld2410c_vendor_endpoint != 0xFFFF) flush_batch();
+    g_batch_len = 0;
+    g_batch_bytes_used = 0;
+    g_lazy_dirty = 0;
+    g_batch_owner = nullptr;
+}
+
 void ld2410c_update_vendor_scalars(
     uint16_t moving_dist_cm,
     uint8_t moving_sig,
@@ -141,17 +606,18 @@ void ld2410c_update_vendor_scalars(
     uint8_t auto_threshold_status
 ) {
     if (g_ld2410c_vendor_endpoint == 0xFFFF) return;
-    update_attr_uint16(g_ld2410c_vendor_endpoint, LD2410C_CLUSTER_ID, LD2410C_ATTR_MOVING_TARGET_DISTANCE_CM, moving_dist_cm);
-    update_attr_uint8 (g_ld2410c_vendor_endpoint, LD2410C_CLUSTER_ID, LD2410C_ATTR_MOVING_TARGET_SIGNAL, moving_sig);
-    update_attr_uint16(g_ld2410c_vendor_endpoint, LD2410C_CLUSTER_ID, LD2410C_ATTR_STATIONARY_TARGET_DISTANCE_CM, stationary_dist_cm);
-    update_attr_uint8 (g_ld2410c_vendor_endpoint, LD2410C_CLUSTER_ID, LD2410C_ATTR_STATIONARY_TARGET_SIGNAL, stationary_sig);
-    update_attr_uint16(g_ld2410c_vendor_endpoint, LD2410C_CLUSTER_ID, LD2410C_ATTR_COMBINED_DISTANCE_CM, combined_dist_cm);
-    update_attr_bool (g_ld2410c_vendor_endpoint, LD2410C_CLUSTER_ID, LD2410C_ATTR_ENHANCED_MODE, enhanced_mode);
-    update_attr_uint16(g_ld2410c_vendor_endpoint, LD2410C_CLUSTER_ID, LD2410C_ATTR_MAX_RANGE_CM, max_range_cm);
-    update_attr_uint8 (g_ld2410c_vendor_endpoint, LD2410C_CLUSTER_ID, LD2410C_ATTR_LIGHT_LEVEL, light_level);
-    update_attr_uint8 (g_ld2410c_vendor_endpoint, LD2410C_CLUSTER_ID, LD2410C_ATTR_LIGHT_THRESHOLD, light_threshold);
-    update_attr_uint8 (g_ld2410c_vendor_endpoint, LD2410C_CLUSTER_ID, LD2410C_ATTR_OUTPUT_LEVEL, output_level);
-    update_attr_uint8 (g_ld2410c_vendor_endpoint, LD2410C_CLUSTER_ID, LD2410C_ATTR_AUTO_THRESHOLD_STATUS, auto_threshold_status);
+    stage_uint16(LD2410C_ATTR_MOVING_TARGET_DISTANCE_CM, moving_dist_cm);
+    stage_uint8(LD2410C_ATTR_MOVING_TARGET_SIGNAL, moving_sig);
+    stage_uint16(LD2410C_ATTR_STATIONARY_TARGET_DISTANCE_CM, stationary_dist_cm);
+    stage_uint8(LD2410C_ATTR_STATIONARY_TARGET_SIGNAL, stationary_sig);
+    stage_uint16(LD2410C_ATTR_COMBINED_DISTANCE_CM, combined_dist_cm);
+    stage_bool(LD2410C_ATTR_ENHANCED_MODE, enhanced_mode);
+    const uint8_t range[2] = {(uint8_t)(max_range_cm & 0xFF), (uint8_t)(max_range_cm >> 8)};
+    stage_lazy(LAZY_MAX_RANGE, range, sizeof(range));
+    stage_uint8(LD2410C_ATTR_LIGHT_LEVEL, light_level);
+    stage_uint8(LD2410C_ATTR_LIGHT_THRESHOLD, light_threshold);
+    stage_uint8(LD2410C_ATTR_OUTPUT_LEVEL, output_level);
+    stage_uint8(LD2410C_ATTR_AUTO_THRESHOLD_STATUS, auto_threshold_status);
 }
 
 void ld2410c_update_vendor_arrays(
@@ -163,22 +629,102 @@ void ld2410c_update_vendor_arrays(
 ) {
     if (g_ld2410c_vendor_endpoint == 0xFFFF) return;
     if (moving_signals && moving_len) {
-        update_attr_octets(g_ld2410c_vendor_endpoint, LD2410C_CLUSTER_ID, LD2410C_ATTR_MOVING_GATES_SIGNALS, moving_signals, moving_len);
+        stage_lazy(LAZY_MOVING_SIGNALS, moving_signals, moving_len);
     }
     if (stationary_signals && stationary_len) {
-        update_attr_octets(g_ld2410c_vendor_endpoint, LD2410C_CLUSTER_ID, LD2410C_ATTR_STATIONARY_GATES_SIGNALS, stationary_signals, stationary_len);
+        stage_lazy(LAZY_STATIONARY_SIGNALS, stationary_signals, stationary_len);
     }
     if (moving_thresholds && mt_len) {
-        update_attr_octets(g_ld2410c_vendor_endpoint, LD2410C_CLUSTER_ID, LD2410C_ATTR_MOVING_THRESHOLDS, moving_thresholds, mt_len);
+        stage_lazy(LAZY_MOVING_THRESHOLDS, moving_thresholds, mt_len);
     }
     if (stationary_thresholds && st_len) {
-        update_attr_octets(g_ld2410c_vendor_endpoint, LD2410C_CLUSTER_ID, LD2410C_ATTR_STATIONARY_THRESHOLDS, stationary_thresholds, st_len);
+        stage_lazy(LAZY_STATIONARY_THRESHOLDS, stationary_thresholds, st_len);
     }
     if (fw_str) {
-        update_attr_string(g_ld2410c_vendor_endpoint, LD2410C_CLUSTER_ID, LD2410C_ATTR_FIRMWARE_VERSION, fw_str);
+        size_t len = strlen(fw_str);
+        stage_lazy(LAZY_FIRMWARE_VERSION, fw_str, (uint8_t)(len > LD2410C_LAZY_MAX ? LD2410C_LAZY_MAX : len));
     }
 }
 
+void ld2410c_update_vendor_capabilities(uint32_t capabilities) {
+    if (g_ld2410c_vendor_endpoint == 0xFFFF) return;
+    stage(LD2410C_ATTR_SUPPORTED_CAPABILITIES, esp_matter_bitmap32(capabilities));
+}
+
+void ld2410c_update_vendor_rtt_stats(const uint8_t *stats, uint8_t len) {
+    if (g_ld2410c_vendor_endpoint == 0xFFFF) return;
+    stage_octets(LD2410C_ATTR_COMMAND_RTT_STATS, stats, len);
+}
+
+void ld2410c_update_vendor_command_status(uint8_t command_id, uint8_t status) {
+    if (g_ld2410c_vendor_endpoint == 0xFFFF) return;
+    // Written from the Matter task and the sensor task, so never shadowed
+    StagedUpdate u[2] = {
+        {LD2410C_ATTR_LAST_COMMAND_ID, esp_matter_uint8(command_id)},
+        {LD2410C_ATTR_LAST_COMMAND_STATUS, esp_matter_uint8(status)},
+    };
+    apply_updates(u, 2, false);
+}
+
+void ld2410c_update_vendor_recovery(uint32_t recoveries, uint8_t recovery_stage) {
+    if (g_ld2410c_vendor_endpoint == 0xFFFF) return;
+    stage(LD2410C_ATTR_RECOVERY_COUNT, esp_matter_uint32(recoveries));
+    stage_uint8(LD2410C_ATTR_RECOVERY_STAGE, recovery_stage);
+}
+
+void ld2410c_update_vendor_profile(uint8_t active_profile, uint16_t switch_ms) {
+    if (g_ld2410c_vendor_endpoint == 0xFFFF) return;
+    // Not shadowed: a controller write may have stored a slot the switch never reached
+    StagedUpdate u[2] = {
+        {LD2410C_ATTR_ACTIVE_PROFILE, esp_matter_uint8(active_profile)},
+        {LD2410C_ATTR_PROFILE_SWITCH_MS, esp_matter_uint16(switch_ms)},
+    };
+    apply_updates(u, 2, false);
+}
+
+void ld2410c_update_vendor_trajectory(uint8_t state) {
+    if (g_ld2410c_vendor_endpoint == 0xFFFF) return;
+    stage_uint8(LD2410C_ATTR_TRAJECTORY_STATE, state);
+}
+
+void ld2410c_update_vendor_frame_repeats(uint8_t percent) {
+    if (g_ld2410c_vendor_endpoint == 0xFFFF) return;
+    stage_uint8(LD2410C_ATTR_FRAME_REPEAT_PERCENT, percent);
+}
+
+void ld2410c_update_vendor_mode_stats(uint32_t switches, uint16_t last_switch_ms, uint8_t engineering_percent) {
+    if (g_ld2410c_vendor_endpoint == 0xFFFF) return;
+    stage(LD2410C_ATTR_MODE_SWITCHES, esp_matter_uint32(switches));
+    stage_uint16(LD2410C_ATTR_MODE_SWITCH_MS, last_switch_ms);
+    stage_uint8(LD2410C_ATTR_ENGINEERING_PERCENT, engineering_percent);
+}
+
+void ld2410c_update_vendor_subgate_distance(uint16_t distance_cm) {
+    if (g_ld2410c_vendor_endpoint == 0xFFFF) return;
+    stage_uint16(LD2410C_ATTR_SUBGATE_DISTANCE_CM, distance_cm);
+}
+
+void ld2410c_update_vendor_boot(uint16_t first_frame_ms, uint8_t start_kind) {
+    if (g_ld2410c_vendor_endpoint == 0xFFFF) return;
+    stage_uint16(LD2410C_ATTR_BOOT_FIRST_FRAME_MS, first_frame_ms);
+    stage_uint8(LD2410C_ATTR_START_KIND, start_kind);
+}
+
+void ld2410c_update_vendor_tracking(
+    uint16_t moving_dist_cm,
+    int16_t moving_velocity_cm_s,
+    uint16_t stationary_dist_cm,
+    uint16_t combined_dist_cm,
+    bool tracking_enabled
+) {
+    if (g_ld2410c_vendor_endpoint == 0xFFFF) return;
+    stage_uint16(LD2410C_ATTR_TRACKED_MOVING_DISTANCE_CM, moving_dist_cm);
+    stage_int16(LD2410C_ATTR_MOVING_VELOCITY_CM_S, moving_velocity_cm_s);
+    stage_uint16(LD2410C_ATTR_TRACKED_STATIONARY_DISTANCE_CM, stationary_dist_cm);
+    stage_uint16(LD2410C_ATTR_TRACKED_COMBINED_DISTANCE_CM, combined_dist_cm);
+    stage_bool(LD2410C_ATTR_TRACKING_ENABLED, tracking_enabled);
+}
+
 } // extern "C"
 
 }
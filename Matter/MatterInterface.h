@@ -15,10 +15,25 @@ typedef struct esp_matter_node_s esp_matter_node_t;
 typedef void (*device_event_callback_t)(const void *event, intptr_t arg);
 
 uint16_t create_occupancy_sensor_endpoint(esp_matter_node_t *node, const char *room_name);
+// OccupancySensing endpoint for one LD2410C distance zone; the caller maps it
+// onto the zone with ld2410c_set_zone_endpoint()
+uint16_t create_zone_occupancy_endpoint(esp_matter_node_t *node);
 void set_occupancy_attribute_value(uint16_t endpoint_id, bool occupied);
 esp_matter_node_t *esp_matter_node_create_wrapper();
 void esp_matter_start_wrapper(device_event_callback_t callback);
 
+// Attribute handles (Attribute.swift). Bind resolves endpoint/cluster/attribute
+// once (nullptr if missing or the pool is full; the same path returns the
+// same handle; safe from any task). Setters convert to the attribute's own
+// type, skip unchanged values and report; false on a type mismatch. Vendor
+// cluster writes skip attribute::update and with it the PRE/POST_UPDATE
+// callback; standard cluster writes keep both.
+typedef struct matter_attribute_handle_s matter_attribute_handle_t;
+matter_attribute_handle_t *matter_attribute_bind(uint16_t endpoint_id, uint32_t cluster_id, uint32_t attribute_id);
+bool matter_attribute_set_uint(matter_attribute_handle_t *handle, uint32_t value); // bool, enum, bitmap, uint
+bool matter_attribute_set_int(matter_attribute_handle_t *handle, int32_t value);
+bool matter_attribute_set_bytes(matter_attribute_handle_t *handle, const uint8_t *bytes, uint16_t len); // char/octet string
+
 // Vendor (LD2410C) cluster metadata
 #define LD2410C_CLUSTER_ID 0xFC00
 // Attribute IDs
@@ -38,9 +53,36 @@ void esp_matter_start_wrapper(device_event_callback_t callback);
 #define LD2410C_ATTR_LIGHT_THRESHOLD                0x000E
 #define LD2410C_ATTR_OUTPUT_LEVEL                   0x000F
 #define LD2410C_ATTR_AUTO_THRESHOLD_STATUS          0x0010
+#define LD2410C_ATTR_TRACKED_MOVING_DISTANCE_CM     0x0011 // alpha-beta tracked, deadbanded
+#define LD2410C_ATTR_MOVING_VELOCITY_CM_S           0x0012 // int16, positive = moving away
+#define LD2410C_ATTR_TRACKED_STATIONARY_DISTANCE_CM 0x0013
+#define LD2410C_ATTR_TRACKED_COMBINED_DISTANCE_CM   0x0014
+#define LD2410C_ATTR_TRACKING_ENABLED               0x0015
+#define LD2410C_ATTR_SUPPORTED_CAPABILITIES         0x0016 // bitmap32, LD2410Capability bits
+#define LD2410C_ATTR_COMMAND_RTT_STATS              0x0017 // octet string, 8 bytes per command class
+#define LD2410C_ATTR_LAST_COMMAND_ID                0x0018 // ld2410c_command_id_t, 0xFF = none
+#define LD2410C_ATTR_LAST_COMMAND_STATUS            0x0019 // ld2410c_command_status_t
+#define LD2410C_ATTR_RECOVERY_COUNT                 0x001A // uint32, watchdog recovery stages run
+#define LD2410C_ATTR_RECOVERY_STAGE                 0x001B // LD2410Watchdog::Stage of the current outage, 0 = link ok
+#define LD2410C_ATTR_ACTIVE_PROFILE                 0x001C // uint8, writable: threshold profile slot, 0xFF = none
+#define LD2410C_ATTR_PROFILE_SWITCH_MS              0x001D // uint16, config-mode time of the last profile switch
+#define LD2410C_ATTR_TRAJECTORY_STATE               0x001E // uint8, LD2410Trajectory::State (4 = cleared on walk-out)
+#define LD2410C_ATTR_FRAME_REPEAT_PERCENT           0x001F // uint8, data frames identical to the previous one, last 600 frames
+#define LD2410C_ATTR_MODE_SWITCHES                  0x0020 // uint32, engineering/basic mode switches since boot
+#define LD2410C_ATTR_MODE_SWITCH_MS                 0x0021 // uint16, config-mode time of the last switch
+#define LD2410C_ATTR_ENGINEERING_PERCENT            0x0022 // uint8, share of time in engineering mode since boot
+#define LD2410C_ATTR_SUBGATE_DISTANCE_CM            0x0023 // uint16, target distance between gate centers (engineering mode), 0 = none
+#define LD2410C_ATTR_BOOT_FIRST_FRAME_MS            0x0024 // uint16, ms from boot to the first valid data frame, 0 = none yet
+#define LD2410C_ATTR_START_KIND                     0x0025 // uint8, LD2410C_START_* (cold / warm / warm, sensor changed)
+// Command IDs: ld2410c_command_id_t (ld2410c_wrapper.h)
 
 // Set endpoint id for LD2410C vendor cluster updates (called from Swift after creation)
 void ld2410c_set_vendor_endpoint(uint16_t endpoint_id);
+// Vendor updates made by the calling task between begin and commit are
+// applied together under one CHIP stack lock; values equal to the last
+// applied one are dropped. Updates outside a batch apply immediately.
+void ld2410c_vendor_publish_begin(void);
+void ld2410c_vendor_publish_commit(void);
 // Update core scalar attributes
 void ld2410c_update_vendor_scalars(
 	uint16_t moving_dist_cm,
@@ -64,6 +106,36 @@ void ld2410c_update_vendor_arrays(
 	const char *fw_str
 );
 
+// Capability bitmap of the attached sensor firmware (published once)
+void ld2410c_update_vendor_capabilities(uint32_t capabilities);
+// Command round-trip stats: per class (config, query, write, system) u16 LE
+// srtt in 0.1 ms, u16 LE rttvar in 0.1 ms, u16 LE deadline ms, u8 retries, u8 timeouts
+void ld2410c_update_vendor_rtt_stats(const uint8_t *stats, uint8_t len);
+// Result of the last vendor command (PENDING while queued/running)
+void ld2410c_update_vendor_command_status(uint8_t command_id, uint8_t status);
+// Link watchdog: recovery stages run since boot, stage of the current outage
+void ld2410c_update_vendor_recovery(uint32_t recoveries, uint8_t recovery_stage);
+// Threshold profile the sensor holds and the presence blackout of the last switch
+void ld2410c_update_vendor_profile(uint8_t active_profile, uint16_t switch_ms);
+// Approach / departure classification of the moving target (ld2410_trajectory.h)
+void ld2410c_update_vendor_trajectory(uint8_t state);
+// Share of repeated data frames (decode and publish skipped), percent
+void ld2410c_update_vendor_frame_repeats(uint8_t percent);
+// Engineering mode on demand (ld2410_mode_arbiter.h)
+void ld2410c_update_vendor_mode_stats(uint32_t switches, uint16_t last_switch_ms, uint8_t engineering_percent);
+// Target distance interpolated between gate centers (ld2410_subgate.h)
+void ld2410c_update_vendor_subgate_distance(uint16_t distance_cm);
+// Boot-to-first-frame time and how the driver state was obtained (ld2410c_boot_stats)
+void ld2410c_update_vendor_boot(uint16_t first_frame_ms, uint8_t start_kind);
+// Update tracked distances / velocity (ld2410_tracker.h)
+void ld2410c_update_vendor_tracking(
+	uint16_t moving_dist_cm,
+	int16_t moving_velocity_cm_s,
+	uint16_t stationary_dist_cm,
+	uint16_t combined_dist_cm,
+	bool tracking_enabled
+);
+
 // Define event constants for Swift
 #define MATTER_EVENT_POST_ATTRIBUTE_UPDATE 10 // Corresponds to ESP_MATTER_EVENT_POST_ATTRIBUTE_UPDATE
 
@@ -1,19 +1,24 @@
 public class OccupancySensor: Device {
     public var endpointId: UInt16
     private var occupied: Bool = false
+    private let occupancy: Attribute<UInt8>?
 
     public init(roomName: String) {
         let node = Node()
         self.endpointId = create_occupancy_sensor_endpoint(node?.getRaw(), roomName)
     // Register endpoint for vendor LD2410C telemetry updates
     ld2410c_set_vendor_endpoint(self.endpointId)
+        // One OccupancySensing endpoint per LD2410C distance zone the gates reach
+        for zone in 0..<ld2410c_zone_count() where ld2410c_zone_reachable(zone) {
+            ld2410c_set_zone_endpoint(zone, create_zone_occupancy_endpoint(node?.getRaw()))
+        }
+        let sensing = OccupancySensingCluster()
+        self.occupancy = Attribute(endpoint: endpointId, cluster: sensing, id: OccupancySensingCluster.AttributeId.occupancy)
         super.init(node: node)
     }
 
     public func setOccupied(_ occupied: Bool) {
         self.occupied = occupied
-        set_occupancy_attribute_value(endpointId, occupied)
+        occupancy?.set(occupied ? 1 : 0)
     }
 }
-
-        
\ No newline at end of file
@@ -0,0 +1,401 @@
+// Offline analysis of raw LD2410 UART captures: header search, bulk decode
+// through LD2410Driver::decodeDataFrame into columns, per-gate statistics
+// and occupancy timelines.
+//
+//   capture_scan [--rate hz] [--bench] capture.bin...   bytes as read from the sensor UART
+//   capture_scan --synth MB [--bench]                    synthetic capture (frames, ACKs, line noise)
+//
+// Header search (F4F3F2F1 data, FDFCFBFA config) compares the first and
+// last header byte at 16 (SSE2) or 32 (AVX2) offsets at once and verifies
+// the few candidates; the scalar path is the driver's 4-byte shift register.
+// --bench times each path over the same bytes and checks they agree.
+// Captures carry no timestamps: timelines count frames at --rate (default 10).
+#include "ld2410_driver.h"
+#include "ld2410_sim.h"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <string>
+#include <vector>
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define CAPTURE_SCAN_X86 1
+#endif
+
+static const uint32_t HEAD_DATA = 0xF1F2F3F4; // little-endian load of F4 F3 F2 F1
+static const uint32_t HEAD_CFG = 0xFAFBFCFD;
+static const uint8_t TAIL_DATA[4] = {0xF8, 0xF7, 0xF6, 0xF5};
+static const uint8_t TAIL_CFG[4] = {0x04, 0x03, 0x02, 0x01};
+static const size_t CHUNK = 16u << 20;
+
+// Factory thresholds (home profile); 0 = the gate never detects
+static const uint8_t M_THR[9] = {50, 50, 40, 30, 20, 15, 15, 15, 15};
+static const uint8_t S_THR[9] = {0, 0, 40, 40, 30, 30, 20, 20, 20};
+
+// Header offsets, bit 0 set for config frames
+typedef std::vector<uint32_t> Hits;
+
+static inline uint32_t load32(const uint8_t *p) { uint32_t v; memcpy(&v, p, 4); return v; }
+
+static inline void verify(const uint8_t *buf, size_t i, Hits &out) {
+    uint32_t w = load32(buf + i);
+    if (w == HEAD_DATA) out.push_back((uint32_t)i << 1);
+    else if (w == HEAD_CFG) out.push_back((uint32_t)i << 1 | 1);
+}
+
+static void scan_scalar(const uint8_t *buf, size_t len, Hits &out) {
+    uint32_t w = 0;
+    for (size_t i = 0; i < len; i++) {
+        w = (w >> 8) | ((uint32_t)buf[i] << 24);
+        if (i >= 3 && (w == HEAD_DATA || w == HEAD_CFG)) out.push_back((uint32_t)(i - 3) << 1 | (w == HEAD_CFG));
+    }
+}
+
+#ifdef CAPTURE_SCAN_X86
+static void scan_sse2(const uint8_t *buf, size_t len, Hits &out) {
+    const __m128i f4 = _mm_set1_epi8((char)0xF4), f1 = _mm_set1_epi8((char)0xF1);
+    const __m128i fd = _mm_set1_epi8((char)0xFD), fa = _mm_set1_epi8((char)0xFA);
+    size_t i = 0;
+    for (; i + 16 + 3 <= len; i += 16) {
+        __m128i a = _mm_loadu_si128((const __m128i *)(buf + i));
+        __m128i b = _mm_loadu_si128((const __m128i *)(buf + i + 3));
+        __m128i d = _mm_and_si128(_mm_cmpeq_epi8(a, f4), _mm_cmpeq_epi8(b, f1));
+        __m128i c = _mm_and_si128(_mm_cmpeq_epi8(a, fd), _mm_cmpeq_epi8(b, fa));
+        uint32_t m = (uint32_t)_mm_movemask_epi8(_mm_or_si128(d, c));
+        for (; m; m &= m - 1) verify(buf, i + __builtin_ctz(m), out);
+    }
+    for (; i + 4 <= len; i++) verify(buf, i, out);
+}
+
+__attribute__((target("avx2")))
+static void scan_avx2(const uint8_t *buf, size_t len, Hits &out) {
+    const __m256i f4 = _mm256_set1_epi8((char)0xF4), f1 = _mm256_set1_epi8((char)0xF1);
+    const __m256i fd = _mm256_set1_epi8((char)0xFD), fa = _mm256_set1_epi8((char)0xFA);
+    size_t i = 0;
+    for (; i + 32 + 3 <= len; i += 32) {
+        __m256i a = _mm256_loadu_si256((const __m256i *)(buf + i));
+        __m256i b = _mm256_loadu_si256((const __m256i *)(buf + i + 3));
+        __m256i d = _mm256_and_si256(_mm256_cmpeq_epi8(a, f4), _mm256_cmpeq_epi8(b, f1));
+        __m256i c = _mm256_and_si256(_mm256_cmpeq_epi8(a, fd), _mm256_cmpeq_epi8(b, fa));
+        uint32_t m = (uint32_t)_mm256_movemask_epi8(_mm256_or_si256(d, c));
+        for (; m; m &= m - 1) verify(buf, i + __builtin_ctz(m), out);
+    }
+    for (; i + 4 <= len; i++) verify(buf, i, out);
+}
+#endif
+
+typedef void (*ScanFn)(const uint8_t *, size_t, Hits &);
+struct ScanPath { const char *name; ScanFn fn; };
+
+static std::vector<ScanPath> scan_paths() {
+    std::vector<ScanPath> p = {{"scalar", scan_scalar}};
+#ifdef CAPTURE_SCAN_X86
+    p.push_back({"sse2", scan_sse2});
+    if (__builtin_cpu_supports("avx2")) p.push_back({"avx2", scan_avx2});
+#endif
+    return p;
+}
+
+// Decoded data frames, one column per field
+struct Columns {
+    std::vector<uint8_t> status;
+    std::vector<uint16_t> movingCm, stationaryCm, distanceCm;
+    std::vector<uint8_t> movingSignal, stationarySignal;
+    std::vector<uint8_t> nGates;          // engineering frames: max moving gate + 1, 0 = basic
+    std::vector<uint8_t> mGate[9], sGate[9]; // 0 where the frame has no such gate
+
+    size_t size() const { return status.size(); }
+    void reserve(size_t n) {
+        status.reserve(n); movingCm.reserve(n); stationaryCm.reserve(n); distanceCm.reserve(n);
+        movingSignal.reserve(n); stationarySignal.reserve(n); nGates.reserve(n);
+        for (int g = 0; g < 9; g++) { mGate[g].reserve(n); sGate[g].reserve(n); }
+    }
+    void add(const LD2410Driver::SensorData &d, bool engineering) {
+        status.push_back(d.status);
+        movingCm.push_back((uint16_t)d.mTargetDistance);
+        stationaryCm.push_back((uint16_t)d.sTargetDistance);
+        distanceCm.push_back((uint16_t)d.distance);
+        movingSignal.push_back(d.mTargetSignal);
+        stationarySignal.push_back(d.sTargetSignal);
+        nGates.push_back(engineering ? d.mTargetSignals.N + 1 : 0);
+        for (uint8_t g = 0; g < 9; g++) {
+            mGate[g].push_back(engineering && g <= d.mTargetSignals.N ? d.mTargetSignals.values[g] : 0);
+            sGate[g].push_back(engineering && g <= d.sTargetSignals.N ? d.sTargetSignals.values[g] : 0);
+        }
+    }
+};
+
+struct Counts {
+    uint64_t bytes = 0;
+    uint64_t dataFrames = 0;
+    uint64_t cfgFrames = 0;
+    uint64_t badFrames = 0; // header found, frame malformed or cut off
+    uint32_t acks[0x100] = {0}; // by command id (low byte of the ACK id)
+};
+
+// Decodes the frames behind the header hits; returns the bytes consumed.
+// Unless final, a frame cut off by the end of buf is left for the next chunk.
+static size_t decode(const uint8_t *buf, size_t len, const Hits &hits, bool final, Columns &cols, Counts &cnt) {
+    size_t next = 0;
+    for (uint32_t h : hits) {
+        size_t pos = h >> 1;
+        if (pos < next) continue; // header bytes inside a frame already decoded
+        if (pos + 6 > len) { if (!final) return pos; cnt.badFrames++; continue; }
+        uint16_t plen = buf[pos + 4] | (buf[pos + 5] << 8);
+        if (plen + 4u > LD2410_BUFFER_SIZE) { cnt.badFrames++; continue; }
+        size_t end = pos + 6 + plen + 4;
+        if (end > len) { if (!final) return pos; cnt.badFrames++; continue; }
+        if (h & 1) {
+            if (memcmp(buf + end - 4, TAIL_CFG, 4) != 0 || plen < 2) { cnt.badFrames++; continue; }
+            cnt.cfgFrames++;
+            cnt.acks[buf[pos + 6]]++;
+        } else {
+            LD2410Driver::SensorData d;
+            if (memcmp(buf + end - 4, TAIL_DATA, 4) != 0 || !LD2410Driver::decodeDataFrame(buf + pos + 4, plen + 6u, d)) {
+                cnt.badFrames++;
+                continue;
+            }
+            cols.add(d, buf[pos + 6] == 0x01);
+            cnt.dataFrames++;
+        }
+        next = end;
+    }
+    if (final) return len;
+    return next > len - 3 ? next : len - 3; // a header may straddle the chunk end
+}
+
+// Whole stream in CHUNK pieces, carrying a cut-off frame into the next one
+static void analyze(FILE *fp, const std::vector<uint8_t> *mem, ScanFn scan, Columns &cols, Counts &cnt) {
+    std::vector<uint8_t> buf;
+    Hits hits;
+    size_t carry = 0, memPos = 0;
+    for (;;) {
+        buf.resize(carry + CHUNK);
+        size_t got;
+        if (mem) {
+            got = std::min(CHUNK, mem->size() - memPos);
+            memcpy(buf.data() + carry, mem->data() + memPos, got);
+            memPos += got;
+        } else {
+            got = fread(buf.data() + carry, 1, CHUNK, fp);
+        }
+        cnt.bytes += got;
+        size_t len = carry + got;
+        bool final = got < CHUNK;
+        hits.clear();
+        scan(buf.data(), len, hits);
+        size_t used = decode(buf.data(), len, hits, final, cols, cnt);
+        if (final) break;
+        carry = len - used;
+        memmove(buf.data(), buf.data() + used, carry);
+    }
+}
+
+// Synthetic capture: engineering frames of one person walking about, with
+// config ACKs, line noise and cut-off frames mixed in
+static std::vector<uint8_t> synthesize(size_t bytes) {
+    std::vector<uint8_t> out;
+    out.reserve(bytes + 256);
+    std::mt19937 rng(2410);
+    std::uniform_int_distribution<int> noise(0, 12), energy(40, 95), pct(0, 999);
+    float pos = 200, v = 0;
+    bool present = true;
+    uint32_t frame = 0;
+    while (out.size() < bytes) {
+        if (frame++ % 600 == 0) present = pct(rng) < 700; // a new minute
+        LD2410Sim::Target t;
+        for (int g = 0; g < 9; g++) { t.movingGates[g] = (uint8_t)noise(rng); t.stationaryGates[g] = (uint8_t)noise(rng); }
+        if (present) {
+            v = v * 0.9f + (pct(rng) - 500) * 0.02f;
+            pos = std::min(600.0f, std::max(30.0f, pos + v));
+            int g = std::min(8, (int)(pos / 75));
+            bool moving = v > 3 || v < -3;
+            t.movingGates[g] = (uint8_t)(moving ? energy(rng) : noise(rng));
+            t.stationaryGates[g] = (uint8_t)energy(rng);
+            t.status = moving ? 3 : 2;
+            t.movingCm = moving ? (uint16_t)pos : 0;
+            t.movingSignal = moving ? t.movingGates[g] : 0;
+            t.stationaryCm = (uint16_t)pos;
+            t.stationarySignal = t.stationaryGates[g];
+            t.distanceCm = (uint16_t)pos;
+        }
+        uint8_t f[LD2410_SIM_FRAME_MAX];
+        size_t n = LD2410Sim::encodeFrame(t, true, 8, 8, f);
+        int r = pct(rng);
+        if (r < 5) n = n / 2;                       // cut off by a reconnect
+        out.insert(out.end(), f, f + n);
+        if (r >= 5 && r < 15) {                      // line noise
+            for (int k = noise(rng) + 4; k > 0; k--) out.push_back((uint8_t)rng());
+        } else if (r >= 15 && r < 18) {              // a config exchange (ACK of 0x61)
+            static const uint8_t ack[] = {0xFD, 0xFC, 0xFB, 0xFA, 0x04, 0x00, 0x61, 0x01, 0x00, 0x00, 0x04, 0x03, 0x02, 0x01};
+            out.insert(out.end(), ack, ack + sizeof(ack));
+        }
+    }
+    return out;
+}
+
+static void print_gates(const Columns &c) {
+    size_t n = 0;
+    for (size_t i = 0; i < c.size(); i++) n += c.nGates[i] != 0;
+    printf("\nper-gate energy over %zu engineering frames (mean / p95 / max, %% of frames at or above threshold)\n", n);
+    if (!n) return;
+    printf("gate   moving                     stationary\n");
+    for (int g = 0; g < 9; g++) {
+        const std::vector<uint8_t> *cols[2] = {&c.mGate[g], &c.sGate[g]};
+        const uint8_t thr[2] = {M_THR[g], S_THR[g]};
+        printf("%4d", g);
+        for (int k = 0; k < 2; k++) {
+            uint64_t hist[256] = {0}, sum = 0, above = 0;
+            for (size_t i = 0; i < c.size(); i++) {
+                if (!c.nGates[i]) continue;
+                uint8_t e = (*cols[k])[i];
+                hist[e]++;
+                sum += e;
+                above += thr[k] && e >= thr[k];
+            }
+            int p95 = 0, max = 0;
+            uint64_t acc = 0;
+            for (int e = 0; e < 256; e++) {
+                if (!hist[e]) continue;
+                max = e;
+                if (acc < n * 95 / 100) p95 = e;
+                acc += hist[e];
+            }
+            char pctAbove[16];
+            if (thr[k]) snprintf(pctAbove, sizeof(pctAbove), "%5.1f%%", 100.0 * above / n);
+            else snprintf(pctAbove, sizeof(pctAbove), "%6s", "-");
+            printf("   %5.1f %3d %3d %s   ", (double)sum / n, p95, max, pctAbove);
+        }
+        printf("\n");
+    }
+}
+
+static void print_timeline(const Columns &c, double rate) {
+    uint64_t occupied = 0, runs = 0, printed = 0;
+    size_t start = 0;
+    bool in = false;
+    printf("\noccupancy timeline (frame index, s at %.0f Hz)\n", rate);
+    for (size_t i = 0; i <= c.size(); i++) {
+        bool p = i < c.size() && c.status[i] >= 1 && c.status[i] <= 3;
+        occupied += p;
+        if (p && !in) { start = i; in = true; }
+        else if (!p && in) {
+            in = false;
+            runs++;
+            if (printed++ < 12) printf("  occupied  frames %9zu..%9zu  %10.1f s .. %10.1f s  (%.1f s)\n", start, i - 1, start / rate, i / rate, (i - start) / rate);
+        }
+    }
+    if (printed > 12) printf("  ... %llu more\n", (unsigned long long)(printed - 12));
+    printf("  %llu occupied periods, occupied %.1f%% of %.1f h\n", (unsigned long long)runs,
+           c.size() ? 100.0 * occupied / c.size() : 0.0, c.size() / rate / 3600);
+}
+
+static double seconds_since(std::chrono::steady_clock::time_point t0) {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+}
+
+static bool bench(const std::vector<uint8_t> &cap) {
+    printf("\nbenchmark over %.1f MB (best of 5)\n", cap.size() / 1e6);
+    Hits ref;
+    bool ok = true;
+    double scalarGbs = 0;
+    for (const ScanPath &p : scan_paths()) {
+        Hits hits;
+        hits.reserve(cap.size() / 16);
+        double best = 1e9;
+        for (int rep = 0; rep < 5; rep++) {
+            hits.clear();
+            auto t0 = std::chrono::steady_clock::now();
+            p.fn(cap.data(), cap.size(), hits);
+            best = std::min(best, seconds_since(t0));
+        }
+        bool same = ref.empty() || hits == ref;
+        if (ref.empty()) ref = hits;
+        double gbs = cap.size() / best / 1e9;
+        if (!scalarGbs) scalarGbs = gbs;
+        printf("  header search %-6s %7.2f GB/s  x%5.1f  %zu headers %s\n", p.name, gbs, gbs / scalarGbs, hits.size(), same ? "" : "MISMATCH");
+        ok &= same;
+    }
+    Columns cols;
+    Counts cnt;
+    cols.reserve(ref.size());
+    auto t0 = std::chrono::steady_clock::now();
+    decode(cap.data(), cap.size(), ref, true, cols, cnt);
+    double dt = seconds_since(t0);
+    printf("  decode into columns  %7.2f Mframes/s (%.2f GB/s of capture)\n", cnt.dataFrames / dt / 1e6, cap.size() / dt / 1e9);
+    for (const ScanPath &p : scan_paths()) {
+        Columns c;
+        Counts k;
+        c.reserve(ref.size());
+        t0 = std::chrono::steady_clock::now();
+        analyze(nullptr, &cap, p.fn, c, k);
+        dt = seconds_since(t0);
+        printf("  full pipeline %-6s %7.2f GB/s\n", p.name, cap.size() / dt / 1e9);
+        ok &= k.dataFrames == cnt.dataFrames;
+    }
+    return ok;
+}
+
+int main(int argc, char **argv) {
+    double rate = 10;
+    bool doBench = false;
+    size_t synthMb = 0;
+    std::vector<const char *> files;
+    for (int i = 1; i < argc; i++) {
+        if (!strcmp(argv[i], "--bench")) doBench = true;
+        else if (!strcmp(argv[i], "--rate") && i + 1 < argc) rate = atof(argv[++i]);
+        else if (!strcmp(argv[i], "--synth") && i + 1 < argc) synthMb = (size_t)atoi(argv[++i]);
+        else files.push_back(argv[i]);
+    }
+    if (files.empty() && !synthMb) synthMb = 64;
+    ScanFn scan = scan_paths().back().fn;
+    printf("header search: %s\n", scan_paths().back().name);
+
+    Columns cols;
+    Counts total;
+    std::vector<uint8_t> synth;
+    if (synthMb) {
+        synth = synthesize(synthMb << 20);
+        Counts cnt;
+        analyze(nullptr, &synth, scan, cols, cnt);
+        printf("%-24s %10.1f MB %10llu frames %8llu config %8llu bad\n", "synthetic", cnt.bytes / 1e6,
+               (unsigned long long)cnt.dataFrames, (unsigned long long)cnt.cfgFrames, (unsigned long long)cnt.badFrames);
+        total = cnt;
+    }
+    for (const char *path : files) {
+        FILE *fp = fopen(path, "rb");
+        if (!fp) { perror(path); return 1; }
+        Counts cnt;
+        analyze(fp, nullptr, scan, cols, cnt);
+        fclose(fp);
+        printf("%-24s %10.1f MB %10llu frames %8llu config %8llu bad\n", path, cnt.bytes / 1e6,
+               (unsigned long long)cnt.dataFrames, (unsigned long long)cnt.cfgFrames, (unsigned long long)cnt.badFrames);
+        total.bytes += cnt.bytes; total.dataFrames += cnt.dataFrames;
+        total.cfgFrames += cnt.cfgFrames; total.badFrames += cnt.badFrames;
+        for (int a = 0; a < 0x100; a++) total.acks[a] += cnt.acks[a];
+    }
+    for (int a = 0; a < 0x100; a++) {
+        if (total.acks[a]) printf("  ACK 0x%02X: %u\n", a, total.acks[a]);
+    }
+    uint64_t byStatus[8] = {0};
+    for (uint8_t s : cols.status) byStatus[s & 7]++;
+    printf("status:");
+    for (int s = 0; s < 7; s++) printf(" %d=%llu", s, (unsigned long long)byStatus[s]);
+    printf("\n");
+    print_gates(cols);
+    print_timeline(cols, rate);
+
+    if (!doBench) return 0;
+    if (synth.empty()) {
+        // Bench on the first capture (up to 256 MB)
+        FILE *fp = fopen(files[0], "rb");
+        synth.resize(256u << 20);
+        synth.resize(fread(synth.data(), 1, synth.size(), fp));
+        fclose(fp);
+    }
+    bool ok = bench(synth);
+    printf("%s\n", ok ? "PASS" : "FAIL");
+    return ok ? 0 : 1;
+}
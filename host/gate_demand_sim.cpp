@@ -0,0 +1,252 @@
+// Engineering mode on demand against engineering mode all the time: the same
+// hour of room occupancy (simulated LD2410 frames at 10 Hz, zone endpoints
+// registered) runs through ld2410c_poll() and the esp_matter stand-in.
+//
+//   gate_demand_sim [minutes]   default: 60
+//
+// The always run holds the application demand bit. The on-demand run opens 20
+// subscriptions to the moving gate signals (0xFC00/0x0009) for a third of the
+// run, ends 16 of them halfway through it, and holds one to the occupancy
+// attribute for the whole run, which must not count as demand. An application
+// callback registered before the watch must still see every subscription. Checked per poll: engineering mode follows demand within
+// two polls, leaves no later than the idle timeout (plus a poll) after demand
+// went away, and the zones and the occupancy see the same edges in both runs.
+#include "ld2410c_wrapper.h"
+#include "MatterInterface.h"
+#include "esp_matter.h"
+#include "esp_matter_standin.h"
+#include "app/InteractionModelEngine.h"
+#include "esp_timer.h"
+#include "host_idf.h"
+#include "ld2410_sim.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+// DiagnosticLogProvider.cpp needs the CHIP diagnostic logs server; not built here
+void ld2410c_register_diagnostic_logs(esp_matter::node_t *node) { (void)node; }
+
+#define GATE_IDLE_MS 30000 // LD2410C_GATE_IDLE_MS
+
+static uint16_t g_occupancy_endpoint = 0xFFFF;
+static uint16_t g_zone_endpoints[4] = {0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF};
+static uint8_t g_zones = 0;
+
+// Registered before esp_matter_start_wrapper(): the watch forwards to it
+struct EarlierCallback : chip::app::ReadHandler::ApplicationCallback {
+    unsigned requested = 0, established = 0, terminated = 0;
+    CHIP_ERROR OnSubscriptionRequested(chip::app::ReadHandler &, chip::Transport::SecureSession &) override {
+        requested++;
+        return CHIP_NO_ERROR;
+    }
+    void OnSubscriptionEstablished(chip::app::ReadHandler &) override { established++; }
+    void OnSubscriptionTerminated(chip::app::ReadHandler &) override { terminated++; }
+};
+static EarlierCallback g_earlier;
+
+#define GATE_SUBSCRIPTIONS 20 // more than any fixed handler table would hold
+#define GATE_EARLY_ENDS 16
+
+static void on_occupancy(const ld2410c_occupancy_event_t *ev, void *ctx) {
+    (void)ctx;
+    set_occupancy_attribute_value(g_occupancy_endpoint, ev->present);
+}
+
+// Someone there for 1..8 min, then the room is empty for 2..10 min
+struct Room {
+    std::mt19937 rng;
+    bool occupied = false;
+    uint32_t untilMs = 0;
+    double pos = 200, vel = 50;
+    explicit Room(uint32_t seed) : rng(seed) {}
+
+    LD2410Sim::Target next(uint32_t t_ms) {
+        std::uniform_real_distribution<double> u(0, 1);
+        std::normal_distribution<double> n(0, 6);
+        if (t_ms >= untilMs) {
+            occupied = !occupied;
+            untilMs = t_ms + (uint32_t)((occupied ? 60 + u(rng) * 420 : 120 + u(rng) * 480) * 1000);
+        }
+        LD2410Sim::Target tg;
+        tg.light = 120;
+        if (!occupied) {
+            for (int g = 0; g < 9; g++) { tg.movingGates[g] = (uint8_t)(u(rng) * 10); tg.stationaryGates[g] = (uint8_t)(u(rng) * 10); }
+            return tg;
+        }
+        // Walks across the room a while, sits a while
+        bool walking = fmod(t_ms / 1000.0, 40) < 12;
+        if (walking) {
+            pos += vel * 0.1;
+            if (pos > 400 || pos < 60) vel = -vel;
+        }
+        uint16_t d = (uint16_t)std::max(1.0, pos + n(rng));
+        tg.status = walking ? 3 : 2;
+        tg.movingCm = walking ? d : 0;
+        tg.movingSignal = walking ? (uint8_t)(60 + u(rng) * 30) : 0;
+        tg.stationaryCm = (uint16_t)std::max(1.0, pos + n(rng));
+        tg.stationarySignal = (uint8_t)(40 + u(rng) * 30);
+        tg.distanceCm = d;
+        int gate = std::min(8, (int)(pos / 75));
+        for (int g = 0; g < 9; g++) {
+            int falloff = 40 * std::abs(g - gate);
+            tg.movingGates[g] = (uint8_t)std::max(0, (walking ? 90 : 5) - falloff + (int)(u(rng) * 8));
+            tg.stationaryGates[g] = (uint8_t)std::max(0, 70 - falloff + (int)(u(rng) * 8));
+        }
+        return tg;
+    }
+};
+
+struct Result {
+    uint64_t frames = 0, bytes = 0, engFrames = 0;
+    double us = 0;
+    uint32_t zoneEdges = 0, edges = 0;
+    uint32_t late = 0, overstay = 0, wrongSub = 0;
+    uint32_t maxOverstayMs = 0;
+    ld2410c_mode_stats_t ms = {};
+};
+
+static Result run(LD2410Sim &sim, uint32_t &t_ms, uint32_t durationMs, bool onDemand) {
+    Result r;
+    Room room(2410);
+    ld2410c_mode_stats_t before;
+    ld2410c_mode_stats(&before);
+    // Never covers the gate signals: not demand
+    int other = onDemand ? esp_matter_standin::subscribe(g_occupancy_endpoint, 0x0406, 0x0000) : -1;
+    std::vector<int> gates;
+    uint32_t start = t_ms, subFrom = start + durationMs / 3, subTo = start + 2 * durationMs / 3;
+    uint32_t subMid = (subFrom + subTo) / 2;
+    bool opened = false, thinned = false;
+    bool zonePrev[4] = {};
+    bool present = ld2410c_is_present();
+    uint32_t wanting = 0, releasedMs = t_ms;
+    bool wanted = false;
+    for (uint32_t end = t_ms + durationMs; t_ms < end; t_ms += 100) {
+        if (esp_timer_get_time() < (int64_t)t_ms * 1000) host_clock_set_us((int64_t)t_ms * 1000);
+        if (onDemand && !opened && t_ms >= subFrom) {
+            opened = true;
+            for (int i = 0; i < GATE_SUBSCRIPTIONS; i++)
+                gates.push_back(esp_matter_standin::subscribe(g_occupancy_endpoint, LD2410C_CLUSTER_ID, LD2410C_ATTR_MOVING_GATES_SIGNALS));
+        }
+        // The first ones in end first: the late ones must still hold demand
+        if (!thinned && opened && t_ms >= subMid) {
+            thinned = true;
+            for (int i = 0; i < GATE_EARLY_ENDS; i++) esp_matter_standin::unsubscribe(gates[i]);
+            gates.erase(gates.begin(), gates.begin() + GATE_EARLY_ENDS);
+        }
+        if (!gates.empty() && t_ms >= subTo) {
+            for (int id : gates) esp_matter_standin::unsubscribe(id);
+            gates.clear();
+        }
+
+        uint8_t f[LD2410_SIM_FRAME_MAX];
+        size_t n = LD2410Sim::encodeFrame(LD2410Sim::Target(), sim.engineering(), 8, 8, f);
+        r.frames++;
+        r.bytes += n;
+        r.engFrames += sim.engineering();
+        sim.emitFrame(room.next(t_ms - start));
+        auto a = std::chrono::steady_clock::now();
+        ld2410c_poll();
+        esp_matter_standin::flush_reports();
+        r.us += std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - a).count();
+
+        ld2410c_mode_stats_t ms;
+        ld2410c_mode_stats(&ms);
+        bool subscribed = ms.demand & LD2410C_GATE_DEMAND_SUBSCRIPTION;
+        if (subscribed != !gates.empty()) r.wrongSub++;
+        // Poll time moved on by the switch itself
+        uint32_t now = (uint32_t)(esp_timer_get_time() / 1000);
+        if (ms.demand) {
+            wanted = true;
+            wanting = ms.engineering ? 0 : wanting + 1;
+            if (wanting > 2) r.late++;
+        } else {
+            if (wanted) releasedMs = now;
+            wanted = false;
+            if (ms.engineering && now - releasedMs > GATE_IDLE_MS + 100) {
+                r.overstay++;
+                r.maxOverstayMs = std::max(r.maxOverstayMs, now - releasedMs - GATE_IDLE_MS);
+            }
+        }
+        if (ld2410c_is_present() != present) { present = !present; r.edges += t_ms != start; }
+        for (uint8_t z = 0; z < g_zones; z++) {
+            const esp_matter_attr_val_t *v = esp_matter_standin::value(g_zone_endpoints[z], 0x0406, 0x0000);
+            bool occ = v && (v->val.u8 & 1);
+            if (occ != zonePrev[z]) { zonePrev[z] = occ; r.zoneEdges++; }
+        }
+    }
+    for (int id : gates) esp_matter_standin::unsubscribe(id);
+    if (other >= 0) esp_matter_standin::unsubscribe(other);
+    ld2410c_mode_stats(&r.ms);
+    r.ms.switches -= before.switches;
+    r.ms.failures -= before.failures;
+    r.ms.switch_ms -= before.switch_ms;
+    r.ms.engineering_ms -= before.engineering_ms;
+    r.ms.basic_ms -= before.basic_ms;
+    return r;
+}
+
+int main(int argc, char **argv) {
+    uint32_t minutes = argc > 1 ? (uint32_t)atoi(argv[1]) : 60;
+    if (minutes < 3) { fprintf(stderr, "usage: gate_demand_sim [minutes >= 3]\n"); return 1; }
+
+    LD2410Sim sim(UART_NUM_1);
+    ld2410c_init();
+    esp_matter_node_t *node = esp_matter_node_create_wrapper();
+    g_occupancy_endpoint = create_occupancy_sensor_endpoint(node, "gates");
+    ld2410c_set_vendor_endpoint(g_occupancy_endpoint);
+    g_zones = ld2410c_zone_count();
+    for (uint8_t z = 0; z < g_zones; z++) {
+        if (!ld2410c_zone_reachable(z)) continue;
+        g_zone_endpoints[z] = create_zone_occupancy_endpoint(node);
+        ld2410c_set_zone_endpoint(z, g_zone_endpoints[z]);
+    }
+    ld2410c_register_occupancy_callback(on_occupancy, nullptr);
+    // Registers the subscription watch with the interaction model, in front of
+    // the callback already there
+    chip::app::InteractionModelEngine::GetInstance()->RegisterReadHandlerAppCallback(&g_earlier);
+    esp_matter_start_wrapper(nullptr);
+    esp_matter_standin::set_subscribers(1);
+
+    // Past the publish hold-off, then idle long enough to settle in basic mode
+    uint32_t t_ms = (uint32_t)(esp_timer_get_time() / 1000);
+    for (unsigned i = 0; i < 400; i++, t_ms += 100) {
+        if (esp_timer_get_time() < (int64_t)t_ms * 1000) host_clock_set_us((int64_t)t_ms * 1000);
+        sim.emitFrame(LD2410Sim::Target());
+        ld2410c_poll();
+    }
+    esp_matter_standin::flush_reports();
+
+    printf("%-12s %7s %8s %9s %8s %9s %8s %7s %6s %6s %6s %9s\n", "mode", "eng %", "B/frame", "us/frame", "switches",
+           "switch ms", "ms/sw", "edges", "zone", "late", "over", "wrong sub");
+    Result res[2];
+    bool ok = true;
+    for (int m = 0; m < 2; m++) {
+        ld2410c_set_gate_demand(LD2410C_GATE_DEMAND_APP, m == 0);
+        Result &r = res[m];
+        r = run(sim, t_ms, minutes * 60000, m == 1);
+        uint64_t total = r.ms.engineering_ms + r.ms.basic_ms;
+        printf("%-12s %7.1f %8.1f %9.2f %8u %9u %8.1f %7u %6u %6u %6u %9u\n", m ? "on demand" : "always",
+               total ? 100.0 * r.ms.engineering_ms / total : 0.0, (double)r.bytes / r.frames, r.us / r.frames,
+               r.ms.switches, r.ms.switch_ms, r.ms.switches ? (double)r.ms.switch_ms / r.ms.switches : 0.0,
+               r.edges, r.zoneEdges, r.late, r.overstay, r.wrongSub);
+        ok &= r.late == 0 && r.overstay == 0 && r.wrongSub == 0 && r.ms.failures == 0;
+    }
+    const Result &al = res[0], &od = res[1];
+    // Zones and occupancy see the same edges as with engineering mode all the time
+    ok &= od.zoneEdges > 0 && od.zoneEdges == al.zoneEdges;
+    ok &= od.edges == al.edges;
+    ok &= od.engFrames < al.engFrames;
+    // Every subscription reached the earlier callback, requested through terminated
+    ok &= g_earlier.requested == GATE_SUBSCRIPTIONS + 1 && g_earlier.established == g_earlier.requested &&
+          g_earlier.terminated == g_earlier.established;
+    printf("earlier app callback: %u requested, %u established, %u terminated\n", g_earlier.requested,
+           g_earlier.established, g_earlier.terminated);
+    printf("on demand: %.1f%% of frames in engineering mode (always: %.1f%%), %.1f%% fewer UART bytes\n",
+           100.0 * od.engFrames / od.frames, 100.0 * al.engFrames / al.frames, 100.0 * (1 - (double)od.bytes / al.bytes));
+    printf("%s\n", ok ? "PASS" : "FAIL");
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,342 @@
+// Frame history retention and round trip: hours of simulated room activity
+// at 10 Hz go through LD2410History::addSample() with engineering mode on
+// throughout (every gate channel carries noise), then the export is pulled
+// through beginExport() / readExport() in BDX-sized chunks and decoded.
+//
+//   history_sim [hours]   default 24
+//
+// Three rooms (see Room): busy, mixed and nonstop walking. The export is
+// pulled at every full hour of the run and checked:
+//   span    every tier's export reaches back its window (60 s, 1 h, 24 h;
+//           the whole run if shorter) with nothing evicted inside it
+//   values  at every tick in the export the decoded (held) value of every
+//           slot is within the deadband of its block's level of the sample,
+//           or of the min/mean/max this tool computes itself
+//   size    the stream is exactly exportSize() bytes and has one block
+//           header per announced block
+// Printed per tier: records and bytes per record, the shortest span, the
+// most blocks an export held of the ring's blocks, the share of exported
+// blocks written degraded (level above 0) and the highest level seen.
+#include "ld2410_history.h"
+#include "ld2410_sim.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <map>
+#include <random>
+#include <vector>
+
+#define CHUNK 1000 // bytes per readExport() call, below a BDX block
+
+static const uint32_t TICK_MS[LD2410_HISTORY_TIERS] = {100, 1000, 60000};
+static const uint32_t WINDOW_TICKS[LD2410_HISTORY_TIERS] = {600, 3600, 1440};
+static const uint16_t BLOCKS[LD2410_HISTORY_TIERS] = {
+    LD2410_HISTORY_TIER0_BLOCKS, LD2410_HISTORY_TIER1_BLOCKS, LD2410_HISTORY_TIER2_BLOCKS};
+
+typedef std::vector<uint16_t> Slots;
+
+// Someone at a desk who gets up every 5-60 min and walks about for 10-120 s
+// between 0.5 m and 4 m; "mixed" also leaves for 5-90 min after a third of
+// the walks, "walk" never sits down. Gate energies are those of
+// LD2410Sim::gateEnergies with +-2 of noise and a noise floor.
+struct Room {
+    std::mt19937 rng{2410};
+    int mix; // 0 busy, 1 mixed, 2 walk
+    uint32_t segmentEnd = 0;
+    int kind = 2; // 0 empty, 1 walking, 2 sitting
+    double pos = 150, vel = 60;
+
+    explicit Room(int m) : mix(m) {}
+
+    LD2410History::Sample next(uint32_t ms) {
+        std::uniform_real_distribution<double> u(0, 1);
+        if (ms >= segmentEnd) {
+            kind = mix == 2 || kind != 1 ? 1 : mix == 1 && u(rng) < 0.33 ? 0 : 2;
+            uint32_t minS = kind == 1 ? 10 : 300, maxS = kind == 0 ? 5400 : kind == 1 ? 120 : 3600;
+            segmentEnd = ms + 1000 * (minS + (uint32_t)(u(rng) * (maxS - minS)));
+            vel = (u(rng) < 0.5 ? -1 : 1) * (30 + u(rng) * 70);
+        }
+        if (kind == 1) {
+            pos += vel * 0.1;
+            if (pos > 400 || pos < 50) { vel = -vel; pos = std::min(400.0, std::max(50.0, pos)); }
+        }
+        std::uniform_int_distribution<int> noise(-2, 2), floor(0, 6);
+        uint8_t mg[9] = {0}, sg[9] = {0};
+        if (kind) {
+            LD2410Sim::gateEnergies(pos, 75, kind == 1 ? 85 : 25, mg);
+            LD2410Sim::gateEnergies(pos, 75, 70, sg);
+        }
+        LD2410History::Sample s;
+        for (int g = 0; g < 9; g++) {
+            s.v[LD2410_HIST_MOVING_GATE0 + g] = (uint16_t)std::min(100, std::max(floor(rng), mg[g] + noise(rng)));
+            s.v[LD2410_HIST_STATIONARY_GATE0 + g] = (uint16_t)std::min(100, std::max(floor(rng), sg[g] + noise(rng)));
+        }
+        if (!kind) return s;
+        // The sensor reports the center of its strongest gate
+        const uint16_t *e = s.v + (kind == 1 ? LD2410_HIST_MOVING_GATE0 : LD2410_HIST_STATIONARY_GATE0);
+        int peak = (int)(std::max_element(e, e + 9) - e);
+        uint16_t cm = (uint16_t)(peak * 75 + 37);
+        s.v[LD2410_HIST_OCCUPIED] = 100;
+        s.v[LD2410_HIST_MOVING] = kind == 1 ? 100 : 0;
+        s.v[LD2410_HIST_STATIONARY] = 100;
+        s.v[LD2410_HIST_MOVING_DIST] = kind == 1 ? cm : 0;
+        s.v[LD2410_HIST_MOVING_SIGNAL] = kind == 1 ? e[peak] : 0;
+        s.v[LD2410_HIST_STATIONARY_DIST] = cm;
+        s.v[LD2410_HIST_STATIONARY_SIGNAL] = s.v[LD2410_HIST_STATIONARY_GATE0 + peak];
+        s.v[LD2410_HIST_DISTANCE] = cm;
+        return s;
+    }
+};
+
+// Expected slots per completed tick, as the firmware should have seen them
+struct Reference {
+    std::map<uint32_t, Slots> ticks[LD2410_HISTORY_TIERS];
+    uint32_t accTick[LD2410_HISTORY_TIERS] = {0};
+    uint32_t n[LD2410_HISTORY_TIERS] = {0};
+    uint16_t mn[LD2410_HISTORY_TIERS][LD2410_HIST_CHANNELS], mx[LD2410_HISTORY_TIERS][LD2410_HIST_CHANNELS];
+    uint32_t sum[LD2410_HISTORY_TIERS][LD2410_HIST_CHANNELS];
+
+    void add(uint32_t ms, const LD2410History::Sample &s) {
+        uint32_t t0 = ms / TICK_MS[0];
+        if (!ticks[0].count(t0)) ticks[0][t0] = Slots(s.v, s.v + LD2410_HIST_CHANNELS);
+        while (ticks[0].size() > 2 * WINDOW_TICKS[0]) ticks[0].erase(ticks[0].begin());
+        while (ticks[1].size() > 2 * WINDOW_TICKS[1]) ticks[1].erase(ticks[1].begin());
+        for (uint8_t t = 1; t < LD2410_HISTORY_TIERS; t++) {
+            uint32_t tick = ms / TICK_MS[t];
+            if (n[t] && tick != accTick[t]) {
+                Slots sl(3 * LD2410_HIST_CHANNELS);
+                for (uint8_t c = 0; c < LD2410_HIST_CHANNELS; c++) {
+                    sl[c] = mn[t][c];
+                    sl[LD2410_HIST_CHANNELS + c] = (uint16_t)((sum[t][c] + n[t] / 2) / n[t]);
+                    sl[2 * LD2410_HIST_CHANNELS + c] = mx[t][c];
+                }
+                ticks[t][accTick[t]] = sl;
+                n[t] = 0;
+            }
+            for (uint8_t c = 0; c < LD2410_HIST_CHANNELS; c++) {
+                uint16_t v = s.v[c];
+                if (!n[t]) { mn[t][c] = mx[t][c] = v; sum[t][c] = v; continue; }
+                mn[t][c] = std::min(mn[t][c], v);
+                mx[t][c] = std::max(mx[t][c], v);
+                sum[t][c] += v;
+            }
+            accTick[t] = tick;
+            n[t]++;
+        }
+    }
+};
+
+struct Record {
+    uint32_t tick;
+    bool gap;
+    uint8_t level; // of the block
+    Slots slots;
+};
+
+struct Decoded {
+    bool ok = true;
+    uint32_t nowMs = 0;
+    uint16_t groups[LD2410_HISTORY_TIERS] = {0};
+    uint32_t blocks[LD2410_HISTORY_TIERS] = {0}, empty[LD2410_HISTORY_TIERS] = {0};
+    uint32_t degraded[LD2410_HISTORY_TIERS] = {0}; // blocks above level 0
+    uint8_t maxLevel[LD2410_HISTORY_TIERS] = {0};
+    uint32_t bytes[LD2410_HISTORY_TIERS] = {0};
+    std::vector<Record> records[LD2410_HISTORY_TIERS];
+};
+
+static uint32_t varint(const uint8_t *&p, const uint8_t *end, bool &ok) {
+    uint32_t v = 0;
+    for (int shift = 0; shift < 35; shift += 7) {
+        if (p >= end) { ok = false; return 0; }
+        uint8_t b = *p++;
+        v |= (uint32_t)(b & 0x7F) << shift;
+        if (!(b & 0x80)) return v;
+    }
+    ok = false;
+    return v;
+}
+
+static uint32_t le(const uint8_t *p, int n) {
+    uint32_t v = 0;
+    for (int i = n - 1; i >= 0; i--) v = (v << 8) | p[i];
+    return v;
+}
+
+// The export stream as ld2410_history.h describes it
+static Decoded decode(const std::vector<uint8_t> &in) {
+    Decoded d;
+    const uint8_t *p = in.data(), *end = p + in.size();
+    size_t head = 12 + 8 * LD2410_HISTORY_TIERS;
+    if (in.size() < head || memcmp(p, "LDH1", 4) || p[4] != 3 || p[5] != LD2410_HIST_CHANNELS || p[6] != LD2410_HISTORY_TIERS) {
+        d.ok = false;
+        return d;
+    }
+    d.nowMs = le(p + 8, 4);
+    uint32_t count[LD2410_HISTORY_TIERS];
+    for (uint8_t t = 0; t < LD2410_HISTORY_TIERS; t++) {
+        const uint8_t *h = p + 12 + 8 * t;
+        d.ok &= le(h, 4) == TICK_MS[t];
+        count[t] = le(h + 4, 2);
+        d.groups[t] = (uint16_t)le(h + 6, 2);
+    }
+    p += head;
+    for (uint8_t t = 0; t < LD2410_HISTORY_TIERS && d.ok; t++) {
+        size_t n = (size_t)d.groups[t] * LD2410_HIST_CHANNELS;
+        for (uint32_t b = 0; b < count[t] && d.ok; b++) {
+            if (end - p < 7) { d.ok = false; break; }
+            uint32_t tick = le(p, 4);
+            uint16_t used = (uint16_t)le(p + 4, 2);
+            uint8_t level = p[6];
+            p += 7;
+            d.ok &= level < LD2410_HISTORY_LEVELS && (t || !level);
+            d.degraded[t] += level != 0;
+            d.maxLevel[t] = std::max(d.maxLevel[t], level);
+            if (end - p < used) { d.ok = false; break; }
+            d.blocks[t]++;
+            d.empty[t] += used == 0;
+            d.bytes[t] += used;
+            const uint8_t *q = p, *qe = p + used;
+            p += used;
+            Slots prev(n, 0); // keyframe: the block starts from zero
+            while (q < qe && d.ok) {
+                uint32_t v = varint(q, qe, d.ok);
+                tick += v >> 1;
+                Record r{tick, (v & 1) != 0, level, {}};
+                if (!r.gap) {
+                    std::vector<uint32_t> masks(d.groups[t]);
+                    for (auto &m : masks) m = varint(q, qe, d.ok);
+                    for (size_t i = 0; i < n && d.ok; i++) {
+                        if (!((masks[i / LD2410_HIST_CHANNELS] >> (i % LD2410_HIST_CHANNELS)) & 1)) continue;
+                        uint32_t z = varint(q, qe, d.ok);
+                        prev[i] = (uint16_t)(prev[i] + (int32_t)((z >> 1) ^ (0u - (z & 1))));
+                    }
+                    r.slots = prev;
+                }
+                d.records[t].push_back(r);
+            }
+        }
+    }
+    d.ok &= p == end;
+    return d;
+}
+
+struct TierResult {
+    uint32_t records = 0, spanTicks = 0, mismatches = 0;
+    double bytesPerRecord = 0;
+    bool spanOk = false;
+};
+
+// Walks the reference ticks covered by the export and holds the decoded
+// records over them, as a reader of the log would
+static TierResult check(const Decoded &d, const Reference &ref, uint8_t t, uint32_t runTicks) {
+    TierResult r;
+    const std::vector<Record> &recs = d.records[t];
+    r.records = (uint32_t)recs.size();
+    r.bytesPerRecord = recs.empty() ? 0 : (double)d.bytes[t] / recs.size();
+    if (recs.empty()) return r;
+    uint32_t nowTick = d.nowMs / TICK_MS[t];
+    uint32_t first = recs.front().tick;
+    r.spanTicks = nowTick - first;
+    uint32_t want = std::min(WINDOW_TICKS[t], runTicks - 1);
+    // Evicted blocks would leave a hole in the middle of the export
+    r.spanOk = r.spanTicks >= want && d.empty[t] == 0;
+    size_t k = 0;
+    const Record *held = nullptr;
+    for (auto it = ref.ticks[t].lower_bound(first); it != ref.ticks[t].end(); ++it) {
+        while (k < recs.size() && recs[k].tick <= it->first) { held = recs[k].gap ? nullptr : &recs[k]; k++; }
+        if (!held) { r.mismatches++; continue; }
+        for (size_t i = 0; i < it->second.size(); i++) {
+            // Slots a block does not keep at its level read 0
+            uint16_t db = LD2410History::deadband(t, held->level, (uint16_t)i);
+            int want = db ? it->second[i] : 0;
+            if (std::abs((int)held->slots[i] - want) >= std::max<int>(db, 1)) { r.mismatches++; break; }
+        }
+    }
+    return r;
+}
+
+// Pulls the export at now_ms in CHUNK-sized reads, as the BDX transfer does
+static Decoded pull(const LD2410History &h, uint32_t now_ms, size_t *bytes) {
+    static LD2410History::Cursor c;
+    h.beginExport(c, now_ms);
+    std::vector<uint8_t> stream;
+    uint8_t buf[CHUNK];
+    while (!c.done) {
+        size_t n = h.readExport(c, buf, sizeof(buf));
+        stream.insert(stream.end(), buf, buf + n);
+    }
+    Decoded d = decode(stream);
+    d.ok &= stream.size() == h.exportSize(now_ms);
+    *bytes = stream.size();
+    return d;
+}
+
+static void duration(char *out, size_t cap, double sec) {
+    if (sec >= 3600) snprintf(out, cap, "%.1f h", sec / 3600);
+    else snprintf(out, cap, "%.0f s", sec);
+}
+
+int main(int argc, char **argv) {
+    uint32_t hours = argc > 1 ? (uint32_t)atoi(argv[1]) : 24;
+    if (!hours) { fprintf(stderr, "usage: history_sim [hours]\n"); return 1; }
+    uint32_t runMs = hours * 3600000u;
+
+    printf("%-6s %4s %9s %8s %10s %10s %8s %9s %4s %6s   (exports at every full hour)\n", "room", "tier", "records",
+           "B/rec", "min span", "window", "blocks", "degraded", "lvl", "bad");
+    bool ok = true;
+    static const char *const ROOMS[] = {"busy", "mixed", "walk"};
+    for (int m = 0; m < 3; m++) {
+        static LD2410History h; // rings are too big for the stack
+        h.clear();
+        Room room(m);
+        Reference ref;
+        TierResult worst[LD2410_HISTORY_TIERS];
+        uint64_t records[LD2410_HISTORY_TIERS] = {0}, bytes[LD2410_HISTORY_TIERS] = {0};
+        uint32_t maxBlocks[LD2410_HISTORY_TIERS] = {0};
+        uint64_t exported[LD2410_HISTORY_TIERS] = {0}, degraded[LD2410_HISTORY_TIERS] = {0};
+        uint8_t maxLevel[LD2410_HISTORY_TIERS] = {0};
+        size_t maxExport = 0;
+        bool decoded = true;
+        for (auto &w : worst) { w.spanTicks = UINT32_MAX; w.spanOk = true; }
+        for (uint32_t ms = 0; ms < runMs; ms += 100) {
+            LD2410History::Sample s = room.next(ms);
+            h.addSample(ms, s);
+            ref.add(ms, s);
+            if ((ms + 100) % 3600000) continue;
+            size_t n;
+            Decoded d = pull(h, ms, &n);
+            decoded &= d.ok;
+            maxExport = std::max(maxExport, n);
+            for (uint8_t t = 0; t < LD2410_HISTORY_TIERS; t++) {
+                TierResult r = check(d, ref, t, ms / TICK_MS[t] + 1);
+                worst[t].spanTicks = std::min(worst[t].spanTicks, r.spanTicks);
+                worst[t].spanOk &= r.spanOk;
+                worst[t].mismatches += r.mismatches;
+                worst[t].records = r.records;
+                records[t] += r.records;
+                bytes[t] += d.bytes[t];
+                maxBlocks[t] = std::max(maxBlocks[t], d.blocks[t]);
+                exported[t] += d.blocks[t];
+                degraded[t] += d.degraded[t];
+                maxLevel[t] = std::max(maxLevel[t], d.maxLevel[t]);
+            }
+        }
+        for (uint8_t t = 0; t < LD2410_HISTORY_TIERS; t++) {
+            const TierResult &r = worst[t];
+            char span[16], window[16];
+            duration(span, sizeof(span), (double)r.spanTicks * TICK_MS[t] / 1000);
+            duration(window, sizeof(window), (double)WINDOW_TICKS[t] * TICK_MS[t] / 1000);
+            bool tierOk = r.mismatches == 0 && r.spanOk;
+            printf("%-6s %4u %9u %8.1f %10s %10s %4u/%-3u %8.1f%% %4u %6u %s\n", ROOMS[m], t, r.records,
+                   records[t] ? (double)bytes[t] / records[t] : 0.0, span, window, maxBlocks[t], BLOCKS[t],
+                   exported[t] ? 100.0 * degraded[t] / exported[t] : 0.0, maxLevel[t], r.mismatches, tierOk ? "" : "FAIL");
+            ok &= tierOk;
+        }
+        printf("%-6s largest export %zu bytes%s\n", ROOMS[m], maxExport, decoded ? "" : ", DECODE FAILED");
+        ok &= decoded;
+    }
+    printf("%s\n", ok ? "PASS" : "FAIL");
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,222 @@
+// ICD reporting mode against continuous reporting: the same hour of room
+// occupancy (people coming and going, simulated LD2410 frames at 10 Hz) runs
+// through ld2410c_poll() and the esp_matter stand-in with one subscriber,
+// once per report mode.
+//
+//   icd_sim [check-in s] [active window ms] [minutes]   default: 30 300 60
+//
+// Radio model: every poll whose reporting pass sends a message wakes the
+// radio, which then stays in active mode for the active window (overlapping
+// wakes merge). Continuous mode uses the same window, so the radio-on numbers
+// compare like for like. Occupancy edge latency runs from the poll that saw
+// the transition to the report carrying it (+zone: zone edges as well, sent
+// at once the same way); telemetry staleness is the longest gap between
+// telemetry flushes.
+#include "ld2410c_wrapper.h"
+#include "ld2410_report_scheduler.h"
+#include "MatterInterface.h"
+#include "esp_matter.h"
+#include "esp_matter_standin.h"
+#include "esp_timer.h"
+#include "host_idf.h"
+#include "ld2410_sim.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+
+// DiagnosticLogProvider.cpp needs the CHIP diagnostic logs server; not built here
+void ld2410c_register_diagnostic_logs(esp_matter::node_t *node) { (void)node; }
+
+static uint16_t g_occupancy_endpoint = 0xFFFF;
+
+static void on_occupancy(const ld2410c_occupancy_event_t *ev, void *ctx) {
+    (void)ctx;
+    set_occupancy_attribute_value(g_occupancy_endpoint, ev->present);
+}
+
+// Someone there for 1..8 min, then the room is empty for 2..10 min
+struct Room {
+    std::mt19937 rng;
+    bool occupied = false;
+    uint32_t untilMs = 0;
+    double pos = 200, vel = 50;
+    explicit Room(uint32_t seed) : rng(seed) {}
+
+    LD2410Sim::Target next(uint32_t t_ms) {
+        std::uniform_real_distribution<double> u(0, 1);
+        std::normal_distribution<double> n(0, 6);
+        if (t_ms >= untilMs) {
+            occupied = !occupied;
+            untilMs = t_ms + (uint32_t)((occupied ? 60 + u(rng) * 420 : 120 + u(rng) * 480) * 1000);
+        }
+        LD2410Sim::Target tg;
+        tg.light = 120;
+        if (!occupied) {
+            for (int g = 0; g < 9; g++) { tg.movingGates[g] = (uint8_t)(u(rng) * 10); tg.stationaryGates[g] = (uint8_t)(u(rng) * 10); }
+            return tg;
+        }
+        // Walks a while, sits a while
+        bool walking = fmod(t_ms / 1000.0, 40) < 12;
+        if (walking) {
+            pos += vel * 0.1;
+            if (pos > 400 || pos < 60) vel = -vel;
+        }
+        uint16_t d = (uint16_t)std::max(1.0, pos + n(rng));
+        tg.status = walking ? 3 : 2;
+        tg.movingCm = walking ? d : 0;
+        tg.movingSignal = walking ? (uint8_t)(60 + u(rng) * 30) : 0;
+        tg.stationaryCm = (uint16_t)std::max(1.0, pos + n(rng));
+        tg.stationarySignal = (uint8_t)(40 + u(rng) * 30);
+        tg.distanceCm = d;
+        int gate = std::min(8, (int)(pos / 75));
+        for (int g = 0; g < 9; g++) {
+            int falloff = 40 * std::abs(g - gate);
+            tg.movingGates[g] = (uint8_t)std::max(0, (walking ? 90 : 5) - falloff + (int)(u(rng) * 8));
+            tg.stationaryGates[g] = (uint8_t)std::max(0, 70 - falloff + (int)(u(rng) * 8));
+        }
+        return tg;
+    }
+};
+
+struct Result {
+    uint64_t radioOnMs = 0;
+    uint32_t wakes = 0;
+    uint64_t messages = 0, attributes = 0;
+    uint32_t edges = 0, edgesLate = 0;
+    uint32_t maxEdgeMs = 0;
+    uint32_t maxStaleMs = 0;
+    ld2410c_report_stats_t rs = {};
+};
+
+static Result run(LD2410Sim &sim, uint32_t &t_ms, uint32_t durationMs, uint32_t activeMs) {
+    Result r;
+    Room room(2410);
+    esp_matter_standin::reset_stats();
+    uint64_t lastMsgs = 0;
+    uint32_t radioUntil = t_ms, lastFlushMs = t_ms, flushes = 0;
+    bool present = ld2410c_is_present();
+    bool edgePending = false;
+    uint32_t edgeMs = 0;
+    for (uint32_t end = t_ms + durationMs; t_ms < end; t_ms += 100) {
+        if (esp_timer_get_time() < (int64_t)t_ms * 1000) host_clock_set_us((int64_t)t_ms * 1000);
+        sim.emitFrame(room.next(t_ms));
+        ld2410c_poll();
+        esp_matter_standin::flush_reports();
+
+        if (ld2410c_is_present() != present) {
+            present = !present;
+            r.edges++;
+            edgePending = true;
+            edgeMs = t_ms;
+        }
+        esp_matter_standin::Stats st = esp_matter_standin::stats();
+        if (st.reportMessages != lastMsgs) {
+            lastMsgs = st.reportMessages;
+            r.wakes++;
+            // Merge with a window still open
+            uint32_t from = (int32_t)(radioUntil - t_ms) > 0 ? radioUntil : t_ms;
+            r.radioOnMs += t_ms + activeMs - from;
+            radioUntil = t_ms + activeMs;
+            if (edgePending) {
+                uint32_t lat = t_ms - edgeMs;
+                r.maxEdgeMs = std::max(r.maxEdgeMs, lat);
+                if (lat) r.edgesLate++;
+                edgePending = false;
+            }
+        }
+        ld2410c_report_stats_t rs;
+        ld2410c_report_stats(&rs);
+        uint32_t f = rs.bursts + rs.piggybacked;
+        if (rs.check_in_ms == 0) f = (uint32_t)st.reportMessages; // continuous: every report carries telemetry
+        if (f != flushes) {
+            flushes = f;
+            r.maxStaleMs = std::max(r.maxStaleMs, t_ms - lastFlushMs);
+            lastFlushMs = t_ms;
+        }
+    }
+    esp_matter_standin::Stats st = esp_matter_standin::stats();
+    r.messages = st.reportMessages;
+    r.attributes = st.reportedAttributes;
+    ld2410c_report_stats(&r.rs);
+    return r;
+}
+
+// The scheduler alone on a counter clock: one burst per check-in, on the grid
+static bool grid_check(uint32_t checkInMs, uint32_t minutes) {
+    LD2410ReportScheduler::Params p;
+    p.checkInMs = checkInMs;
+    LD2410ReportScheduler s;
+    s.setParams(p, 1000);
+    uint32_t bursts = 0, offGrid = 0;
+    for (uint32_t t = 1000; t < 1000 + minutes * 60000; t += 100) {
+        if (s.due(t)) {
+            bursts++;
+            if ((t - 1000) % checkInMs) offGrid++;
+        }
+    }
+    uint32_t expect = (minutes * 60000 + checkInMs - 1) / checkInMs;
+    printf("scheduler on a counter clock: %u bursts in %u min (expected %u), %u off the %u ms grid\n",
+           bursts, minutes, expect, offGrid, checkInMs);
+    return bursts == expect && !offGrid;
+}
+
+int main(int argc, char **argv) {
+    uint32_t checkInMs = (argc > 1 ? (uint32_t)atoi(argv[1]) : 30) * 1000;
+    uint32_t activeMs = argc > 2 ? (uint32_t)atoi(argv[2]) : 300;
+    uint32_t minutes = argc > 3 ? (uint32_t)atoi(argv[3]) : 60;
+    if (!checkInMs || !activeMs || !minutes) { fprintf(stderr, "usage: icd_sim [check-in s] [active window ms] [minutes]\n"); return 1; }
+
+    bool ok = grid_check(checkInMs, minutes);
+
+    LD2410Sim sim(UART_NUM_1);
+    ld2410c_init();
+    esp_matter_node_t *node = esp_matter_node_create_wrapper();
+    g_occupancy_endpoint = create_occupancy_sensor_endpoint(node, "icd");
+    ld2410c_set_vendor_endpoint(g_occupancy_endpoint);
+    for (uint8_t z = 0; z < ld2410c_zone_count(); z++) {
+        if (ld2410c_zone_reachable(z)) ld2410c_set_zone_endpoint(z, create_zone_occupancy_endpoint(node));
+    }
+    ld2410c_register_occupancy_callback(on_occupancy, nullptr);
+    esp_matter_standin::set_subscribers(1);
+
+    // Past the publish hold-off
+    uint32_t t_ms = (uint32_t)(esp_timer_get_time() / 1000);
+    Room warm(1);
+    for (unsigned i = 0; i < 60; i++, t_ms += 100) {
+        if (esp_timer_get_time() < (int64_t)t_ms * 1000) host_clock_set_us((int64_t)t_ms * 1000);
+        sim.emitFrame(warm.next(t_ms));
+        ld2410c_poll();
+    }
+    esp_matter_standin::flush_reports();
+
+    printf("%-22s %8s %7s %9s %9s %6s %6s %6s %6s %8s %9s\n", "mode", "radio %", "wakes", "messages", "attrs", "edges",
+           "+zone", "late", "piggy", "edge ms", "stale s");
+    Result res[2];
+    for (int m = 0; m < 2; m++) {
+        // Applied where the sensor task would, before its next poll
+        ld2410c_set_report_mode(m ? checkInMs : 0, activeMs);
+        ld2410c_run_commands();
+        Result &r = res[m];
+        r = run(sim, t_ms, minutes * 60000, activeMs);
+        char name[32];
+        if (m) snprintf(name, sizeof(name), "ICD %us/%ums", (unsigned)(checkInMs / 1000), (unsigned)activeMs);
+        else snprintf(name, sizeof(name), "continuous 250ms");
+        printf("%-22s %8.2f %7u %9llu %9llu %6u %6u %6u %6u %8u %9.1f\n", name, 100.0 * r.radioOnMs / (minutes * 60000.0), r.wakes,
+               (unsigned long long)r.messages, (unsigned long long)r.attributes, r.edges, r.rs.edges, r.edgesLate, r.rs.piggybacked,
+               r.maxEdgeMs, r.maxStaleMs / 1000.0);
+        ok &= r.edges > 0 && r.edgesLate == 0;
+    }
+    const Result &icd = res[1];
+    // Telemetry is never older than one check-in (plus the poll period)
+    ok &= icd.maxStaleMs <= checkInMs + 100;
+    ok &= icd.rs.bursts + icd.rs.skipped >= minutes * 60000 / checkInMs;
+    // Every wake is a check-in burst or an edge
+    ok &= icd.wakes <= icd.rs.bursts + icd.rs.edges;
+    printf("radio-on %.1fx lower, %.1fx fewer report messages\n",
+           icd.radioOnMs ? (double)res[0].radioOnMs / icd.radioOnMs : 0.0,
+           icd.messages ? (double)res[0].messages / icd.messages : 0.0);
+    printf("%s\n", ok ? "PASS" : "FAIL");
+    return ok ? 0 : 1;
+}
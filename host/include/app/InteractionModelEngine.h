@@ -0,0 +1,57 @@
+// Stand-in for the CHIP interaction model engine: just the read handler
+// application callback, driven by esp_matter_standin::subscribe() /
+// unsubscribe() (esp_matter_standin.h).
+#pragma once
+#include "esp_matter.h"
+
+namespace chip {
+namespace Transport {
+class SecureSession {}; // stand-in: never inspected
+} // namespace Transport
+
+namespace app {
+
+struct AttributePathParams {
+    EndpointId mEndpointId = 0xFFFF;       // 0xFFFF / 0xFFFFFFFF = wildcard
+    ClusterId mClusterId = 0xFFFFFFFF;
+    AttributeId mAttributeId = 0xFFFFFFFF;
+    bool HasWildcardEndpointId() const { return mEndpointId == 0xFFFF; }
+    bool HasWildcardClusterId() const { return mClusterId == 0xFFFFFFFF; }
+    bool HasWildcardAttributeId() const { return mAttributeId == 0xFFFFFFFF; }
+};
+
+template <typename T>
+struct SingleLinkedListNode {
+    SingleLinkedListNode *mpNext = nullptr;
+    T mValue;
+};
+
+class ReadHandler {
+public:
+    class ApplicationCallback {
+    public:
+        virtual ~ApplicationCallback() = default;
+        virtual CHIP_ERROR OnSubscriptionRequested(ReadHandler &readHandler, Transport::SecureSession &secureSession) {
+            (void)readHandler; (void)secureSession; return CHIP_NO_ERROR;
+        }
+        virtual void OnSubscriptionEstablished(ReadHandler &readHandler) { (void)readHandler; }
+        virtual void OnSubscriptionTerminated(ReadHandler &readHandler) { (void)readHandler; }
+    };
+    const SingleLinkedListNode<AttributePathParams> *GetAttributePathList() const { return &path; }
+
+    SingleLinkedListNode<AttributePathParams> path; // stand-in: one path per subscription
+};
+
+class InteractionModelEngine {
+public:
+    static InteractionModelEngine *GetInstance() { static InteractionModelEngine e; return &e; }
+    void RegisterReadHandlerAppCallback(ReadHandler::ApplicationCallback *cb) { appCallback = cb; }
+    void UnregisterReadHandlerAppCallback() { appCallback = nullptr; }
+    ReadHandler::ApplicationCallback *GetAppCallback() { return appCallback; }
+
+private:
+    ReadHandler::ApplicationCallback *appCallback = nullptr;
+};
+
+} // namespace app
+} // namespace chip
@@ -0,0 +1,6 @@
+// Stand-in for the CHIP reporting hook (esp_matter_standin.cpp): marks the
+// attribute dirty for the next flush_reports() pass, without a data model lookup.
+#pragma once
+#include "esp_matter.h"
+
+void MatterReportingAttributeChangeCallback(chip::EndpointId endpoint, chip::ClusterId clusterId, chip::AttributeId attributeId);
@@ -0,0 +1,2 @@
+#pragma once
+// Not needed by the stand-in
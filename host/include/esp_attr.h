@@ -0,0 +1,5 @@
+// Memory placement attributes. RTC no-init data is a section of its own so a
+// tool can keep it across simulated resets (host_rtc_noinit in host_idf.h).
+#pragma once
+
+#define RTC_NOINIT_ATTR __attribute__((section("rtc_noinit")))
@@ -0,0 +1,236 @@
+// In-memory stand-in for the esp_matter data model API used by the firmware
+// (node/endpoint/cluster/attribute/command create/get/update). Values are
+// stored per attribute; update() of a changed value marks it dirty for every
+// simulated subscriber (esp_matter_standin.h). Only the subset this firmware
+// calls is provided.
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include "esp_err.h"
+
+// ---------------- CHIP types ----------------
+
+typedef int CHIP_ERROR;
+#define CHIP_NO_ERROR 0
+#define CHIP_ERROR_WRONG_TLV_TYPE 0x26
+#define CHIP_END_OF_TLV 0x21
+
+namespace chip {
+
+typedef uint16_t EndpointId;
+typedef uint32_t ClusterId;
+typedef uint32_t AttributeId;
+typedef uint32_t CommandId;
+
+namespace DeviceLayer {
+struct ChipDeviceEvent {
+    uint16_t Type;
+};
+} // namespace DeviceLayer
+
+namespace TLV {
+
+enum TLVType { kTLVType_NotSpecified = -1, kTLVType_UnsignedInteger = 4, kTLVType_Boolean = 8, kTLVType_Structure = 0x15 };
+
+typedef uint64_t Tag;
+inline Tag ContextTag(uint8_t n) { return (1ull << 32) | n; }
+inline bool IsContextTag(Tag t) { return (t >> 32) == 1; }
+inline uint32_t TagNumFromTag(Tag t) { return (uint32_t)t; }
+
+// Reader over a flat list of context-tagged unsigned/bool fields inside one
+// structure, enough for the vendor cluster command payloads.
+class TLVReader {
+public:
+    struct Field {
+        uint8_t tag;
+        TLVType type;
+        uint64_t value;
+    };
+    void Init(const Field *fields, size_t count) { f = fields; n = count; i = -1; inStruct = false; }
+    TLVType GetType() const {
+        if (!inStruct) return kTLVType_Structure;
+        return (i >= 0 && (size_t)i < n) ? f[i].type : kTLVType_NotSpecified;
+    }
+    Tag GetTag() const { return ContextTag(f[i].tag); }
+    CHIP_ERROR EnterContainer(TLVType &outer) { outer = kTLVType_NotSpecified; inStruct = true; i = -1; return CHIP_NO_ERROR; }
+    CHIP_ERROR ExitContainer(TLVType outer) { (void)outer; inStruct = false; return CHIP_NO_ERROR; }
+    CHIP_ERROR Next() { return (size_t)(++i) < n ? CHIP_NO_ERROR : CHIP_END_OF_TLV; }
+    CHIP_ERROR Get(uint8_t &v) {
+        if (f[i].type != kTLVType_UnsignedInteger || f[i].value > 0xFF) return CHIP_ERROR_WRONG_TLV_TYPE;
+        v = (uint8_t)f[i].value;
+        return CHIP_NO_ERROR;
+    }
+    CHIP_ERROR Get(uint16_t &v) {
+        if (f[i].type != kTLVType_UnsignedInteger || f[i].value > 0xFFFF) return CHIP_ERROR_WRONG_TLV_TYPE;
+        v = (uint16_t)f[i].value;
+        return CHIP_NO_ERROR;
+    }
+    CHIP_ERROR Get(bool &v) {
+        if (f[i].type != kTLVType_Boolean) return CHIP_ERROR_WRONG_TLV_TYPE;
+        v = f[i].value != 0;
+        return CHIP_NO_ERROR;
+    }
+
+private:
+    const Field *f = nullptr;
+    size_t n = 0;
+    long i = -1;
+    bool inStruct = false;
+};
+
+} // namespace TLV
+
+namespace app {
+
+struct ConcreteCommandPath {
+    EndpointId mEndpointId;
+    ClusterId mClusterId;
+    CommandId mCommandId;
+};
+
+namespace Clusters {
+namespace OccupancySensing {
+static constexpr ClusterId Id = 0x0406;
+namespace Attributes {
+namespace Occupancy { static constexpr AttributeId Id = 0x0000; }
+} // namespace Attributes
+} // namespace OccupancySensing
+} // namespace Clusters
+
+} // namespace app
+} // namespace chip
+
+// ---------------- Attribute values ----------------
+
+typedef enum {
+    ESP_MATTER_VAL_TYPE_INVALID = 0,
+    ESP_MATTER_VAL_TYPE_BOOLEAN,
+    ESP_MATTER_VAL_TYPE_INT8,
+    ESP_MATTER_VAL_TYPE_INT16,
+    ESP_MATTER_VAL_TYPE_INT32,
+    ESP_MATTER_VAL_TYPE_UINT8,
+    ESP_MATTER_VAL_TYPE_UINT16,
+    ESP_MATTER_VAL_TYPE_UINT32,
+    ESP_MATTER_VAL_TYPE_ENUM8,
+    ESP_MATTER_VAL_TYPE_BITMAP8,
+    ESP_MATTER_VAL_TYPE_BITMAP16,
+    ESP_MATTER_VAL_TYPE_BITMAP32,
+    ESP_MATTER_VAL_TYPE_CHAR_STRING,
+    ESP_MATTER_VAL_TYPE_OCTET_STRING,
+} esp_matter_val_type_t;
+
+typedef union {
+    bool b;
+    int8_t i8;
+    int16_t i16;
+    int32_t i32;
+    uint8_t u8;
+    uint16_t u16;
+    uint32_t u32;
+    struct {
+        uint8_t *b;
+        uint16_t s;
+        uint16_t n;
+        uint16_t t;
+    } a;
+} esp_matter_val_t;
+
+typedef struct {
+    esp_matter_val_type_t type;
+    esp_matter_val_t val;
+} esp_matter_attr_val_t;
+
+inline esp_matter_attr_val_t esp_matter_bool(bool v) { esp_matter_attr_val_t r = {}; r.type = ESP_MATTER_VAL_TYPE_BOOLEAN; r.val.b = v; return r; }
+inline esp_matter_attr_val_t esp_matter_int16(int16_t v) { esp_matter_attr_val_t r = {}; r.type = ESP_MATTER_VAL_TYPE_INT16; r.val.i16 = v; return r; }
+inline esp_matter_attr_val_t esp_matter_uint8(uint8_t v) { esp_matter_attr_val_t r = {}; r.type = ESP_MATTER_VAL_TYPE_UINT8; r.val.u8 = v; return r; }
+inline esp_matter_attr_val_t esp_matter_uint16(uint16_t v) { esp_matter_attr_val_t r = {}; r.type = ESP_MATTER_VAL_TYPE_UINT16; r.val.u16 = v; return r; }
+inline esp_matter_attr_val_t esp_matter_uint32(uint32_t v) { esp_matter_attr_val_t r = {}; r.type = ESP_MATTER_VAL_TYPE_UINT32; r.val.u32 = v; return r; }
+inline esp_matter_attr_val_t esp_matter_int8(int8_t v) { esp_matter_attr_val_t r = {}; r.type = ESP_MATTER_VAL_TYPE_INT8; r.val.i8 = v; return r; }
+inline esp_matter_attr_val_t esp_matter_int32(int32_t v) { esp_matter_attr_val_t r = {}; r.type = ESP_MATTER_VAL_TYPE_INT32; r.val.i32 = v; return r; }
+inline esp_matter_attr_val_t esp_matter_enum8(uint8_t v) { esp_matter_attr_val_t r = {}; r.type = ESP_MATTER_VAL_TYPE_ENUM8; r.val.u8 = v; return r; }
+inline esp_matter_attr_val_t esp_matter_bitmap8(uint8_t v) { esp_matter_attr_val_t r = {}; r.type = ESP_MATTER_VAL_TYPE_BITMAP8; r.val.u8 = v; return r; }
+inline esp_matter_attr_val_t esp_matter_bitmap16(uint16_t v) { esp_matter_attr_val_t r = {}; r.type = ESP_MATTER_VAL_TYPE_BITMAP16; r.val.u16 = v; return r; }
+inline esp_matter_attr_val_t esp_matter_bitmap32(uint32_t v) { esp_matter_attr_val_t r = {}; r.type = ESP_MATTER_VAL_TYPE_BITMAP32; r.val.u32 = v; return r; }
+inline esp_matter_attr_val_t esp_matter_char_str(char *s, uint16_t len) {
+    esp_matter_attr_val_t r = {}; r.type = ESP_MATTER_VAL_TYPE_CHAR_STRING; r.val.a.b = (uint8_t *)s; r.val.a.s = len; r.val.a.n = len; r.val.a.t = len; return r;
+}
+inline esp_matter_attr_val_t esp_matter_octet_str(uint8_t *b, uint16_t len) {
+    esp_matter_attr_val_t r = {}; r.type = ESP_MATTER_VAL_TYPE_OCTET_STRING; r.val.a.b = b; r.val.a.s = len; r.val.a.n = len; r.val.a.t = len; return r;
+}
+
+// ---------------- Data model ----------------
+
+namespace esp_matter {
+
+typedef struct node_s node_t;
+typedef struct endpoint_s endpoint_t;
+typedef struct cluster_s cluster_t;
+typedef struct attribute_s attribute_t;
+typedef struct command_s command_t;
+
+enum { ENDPOINT_FLAG_NONE = 0 };
+enum { CLUSTER_FLAG_SERVER = 0x10 };
+// OVERRIDE: reads go to the attribute's override callback (READ), nothing is stored
+enum { ATTRIBUTE_FLAG_NONE = 0, ATTRIBUTE_FLAG_WRITABLE = 0x1, ATTRIBUTE_FLAG_OVERRIDE = 0x100 };
+enum { COMMAND_FLAG_NONE = 0, COMMAND_FLAG_ACCEPTED = 0x1 };
+
+typedef void (*event_callback_t)(const chip::DeviceLayer::ChipDeviceEvent *event, intptr_t arg);
+esp_err_t start(event_callback_t cb);
+
+// CHIP stack lock. ALREADY_TAKEN when the calling thread holds it.
+namespace lock {
+typedef enum { FAILED, ALREADY_TAKEN, SUCCESS } status_t;
+status_t chip_stack_lock(uint32_t ticks_to_wait);
+esp_err_t chip_stack_unlock();
+} // namespace lock
+
+namespace attribute {
+typedef enum { PRE_UPDATE, POST_UPDATE, READ, WRITE } callback_type_t;
+// PRE_UPDATE runs before a write is stored; an error rejects the write
+typedef esp_err_t (*callback_t)(callback_type_t type, uint16_t endpoint_id, uint32_t cluster_id, uint32_t attribute_id,
+                                esp_matter_attr_val_t *val, void *priv_data);
+} // namespace attribute
+
+namespace node {
+struct config_t {};
+node_t *create(config_t *config, attribute::callback_t attribute_cb, void *identify_cb);
+node_t *get();
+} // namespace node
+
+namespace endpoint {
+endpoint_t *get(node_t *node, uint16_t endpoint_id);
+uint16_t get_id(endpoint_t *endpoint);
+namespace occupancy_sensor {
+struct config_t {
+    struct {
+        uint32_t feature_flags = 0;
+        uint8_t occupancy_sensor_type = 0;
+        uint8_t occupancy_sensor_type_bitmap = 0;
+    } occupancy_sensing;
+};
+endpoint_t *create(node_t *node, config_t *config, uint8_t flags, void *priv_data);
+} // namespace occupancy_sensor
+} // namespace endpoint
+
+namespace cluster {
+cluster_t *create(endpoint_t *endpoint, uint32_t cluster_id, uint8_t flags);
+cluster_t *get(endpoint_t *endpoint, uint32_t cluster_id);
+} // namespace cluster
+
+namespace attribute {
+attribute_t *create(cluster_t *cluster, uint32_t attribute_id, uint16_t flags, esp_matter_attr_val_t val);
+attribute_t *get(cluster_t *cluster, uint32_t attribute_id);
+esp_err_t get_val(attribute_t *attribute, esp_matter_attr_val_t *val);
+// Stores the value only; reporting is MatterReportingAttributeChangeCallback()
+esp_err_t set_val(attribute_t *attribute, esp_matter_attr_val_t *val);
+esp_err_t update(uint16_t endpoint_id, uint32_t cluster_id, uint32_t attribute_id, esp_matter_attr_val_t *val);
+esp_err_t set_override_callback(attribute_t *attribute, callback_t callback);
+} // namespace attribute
+
+namespace command {
+typedef esp_err_t (*callback_t)(const chip::app::ConcreteCommandPath &path, chip::TLV::TLVReader &tlv, void *opaque);
+command_t *create(cluster_t *cluster, uint32_t command_id, uint8_t flags, callback_t callback);
+command_t *get(cluster_t *cluster, uint32_t command_id);
+} // namespace command
+
+} // namespace esp_matter
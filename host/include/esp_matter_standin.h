@@ -0,0 +1,50 @@
+// Instrumentation of the esp_matter stand-in (esp_matter.h).
+//
+// Subscribers are wildcard subscriptions on the whole node. An update that
+// changes a value marks the attribute dirty; flush_reports() then plays the
+// reporting engine once: every subscriber gets one report holding all dirty
+// attributes, encoded into a message buffer (chunked at the IPv6 MTU).
+// Override attributes are read through their callback when reported.
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include "esp_matter.h"
+
+namespace esp_matter_standin {
+
+struct Stats {
+    uint64_t updates = 0;            // attribute::update / set_val calls
+    uint64_t changed = 0;            // ... that changed the stored value
+    uint64_t unchanged = 0;          // ... that stored the same value (no report)
+    uint64_t lookups = 0;            // endpoint/cluster/attribute get calls
+    uint64_t lockAcquisitions = 0;   // CHIP stack lock taken (not already held)
+    uint64_t reportMessages = 0;     // report messages across all subscribers
+    uint64_t reportedAttributes = 0; // attribute reports across all messages
+    uint64_t reportBytes = 0;
+    uint64_t overrideReads = 0;      // values pulled from override callbacks (reads, reports)
+};
+
+void set_subscribers(unsigned n);
+unsigned subscribers();
+// Subscription to one attribute path (0xFFFF / 0xFFFFFFFF = wildcard): runs
+// the read handler application callback (app/InteractionModelEngine.h) and
+// from then on gets every report, like the set_subscribers() ones. Returns
+// the id for unsubscribe().
+int subscribe(uint16_t endpoint_id, uint32_t cluster_id, uint32_t attribute_id);
+void unsubscribe(int id);
+// One pass of the reporting engine over the attributes dirtied since the last pass
+void flush_reports();
+Stats stats();
+void reset_stats();
+
+// Calls a command handler the way the interaction model would
+esp_err_t invoke(uint16_t endpoint_id, uint32_t cluster_id, uint32_t command_id,
+                 const chip::TLV::TLVReader::Field *fields, size_t count);
+// Writes an attribute the way the interaction model would: only writable
+// attributes, through the node's PRE_UPDATE/POST_UPDATE callback
+esp_err_t write(uint16_t endpoint_id, uint32_t cluster_id, uint32_t attribute_id, esp_matter_attr_val_t val);
+// Current value of an attribute (nullptr if missing), read through the
+// override callback like an interaction model read; strings point into the store
+const esp_matter_attr_val_t *value(uint16_t endpoint_id, uint32_t cluster_id, uint32_t attribute_id);
+
+} // namespace esp_matter_standin
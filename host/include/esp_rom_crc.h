@@ -0,0 +1,6 @@
+// ROM CRC32 (little endian, reflected 0xEDB88320), as the chip's: start with
+// crc 0 for the standard CRC-32 of buf
+#pragma once
+#include <cstdint>
+
+uint32_t esp_rom_crc32_le(uint32_t crc, const uint8_t *buf, uint32_t len);
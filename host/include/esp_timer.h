@@ -0,0 +1,5 @@
+#pragma once
+#include <cstdint>
+
+// Virtual microseconds since boot of the calling thread (see host_idf.h)
+int64_t esp_timer_get_time();
@@ -0,0 +1,13 @@
+#pragma once
+#include "FreeRTOS.h"
+
+// A receive that would block advances the virtual clock by the timeout
+// (portMAX_DELAY on an empty queue returns pdFALSE instead of hanging).
+QueueHandle_t xQueueCreate(UBaseType_t length, UBaseType_t itemSize);
+void vQueueDelete(QueueHandle_t q);
+BaseType_t xQueueSend(QueueHandle_t q, const void *item, TickType_t wait);
+#define xQueueSendToBack xQueueSend
+BaseType_t xQueueOverwrite(QueueHandle_t q, const void *item);
+BaseType_t xQueueReceive(QueueHandle_t q, void *item, TickType_t wait);
+BaseType_t xQueueReset(QueueHandle_t q);
+UBaseType_t uxQueueMessagesWaiting(QueueHandle_t q);
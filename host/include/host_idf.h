@@ -0,0 +1,41 @@
+// Host-only controls for the ESP-IDF stand-ins in host/include.
+//
+// Time is virtual and per thread: esp_timer_get_time() returns the calling
+// thread's clock, which only moves when code blocks (vTaskDelay, a UART read
+// or queue receive that times out) or when a tool advances it. A blocking
+// call therefore costs no wall time, and CPU cost can be measured with a
+// real clock around the code under test.
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include "driver/uart.h"
+#include "esp_system.h"
+
+void host_clock_set_us(int64_t us);
+void host_clock_advance_us(int64_t us);
+
+// UART ports: 0..UART_NUM_MAX-1 like the chip, and host-only ones up to
+// HOST_UART_PORTS for tools that run many sensors
+#define HOST_UART_PORTS 8192
+
+// Bytes written by the firmware to a UART port are handed to the attached
+// device; the device answers with host_uart_inject().
+typedef void (*host_uart_tx_hook_t)(uart_port_t port, const uint8_t *data, size_t len, void *ctx);
+void host_uart_attach(uart_port_t port, host_uart_tx_hook_t hook, void *ctx);
+// Queue RX bytes that become readable at avail_us (virtual time)
+void host_uart_inject(uart_port_t port, const uint8_t *data, size_t len, int64_t avail_us);
+size_t host_uart_pending(uart_port_t port);
+// Rate the firmware configured (uart_param_config / uart_set_baudrate)
+uint32_t host_uart_baud(uart_port_t port);
+// Fault injection: RX delivers nothing until the driver is deleted
+void host_uart_set_stuck(uart_port_t port, bool stuck);
+
+// ESP_LOGx output on stderr (off by default)
+void host_log_enable(bool on);
+
+// Resets: esp_reset_reason() returns what the tool set (POWERON by default).
+// RTC_NOINIT_ATTR data lives in one section, which a tool saves after a
+// simulated boot and puts back (or fills with noise for a power-on) before
+// the next; nullptr / 0 when the program has none.
+void host_set_reset_reason(esp_reset_reason_t reason);
+uint8_t *host_rtc_noinit(size_t *len);
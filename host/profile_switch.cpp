@@ -0,0 +1,139 @@
+// Threshold profile switching against the simulated sensor: presence
+// blackout (time in config mode, when the sensor streams nothing) and
+// command count per switch, compared with writing the same parameters one
+// gate at a time the way setGateParameters(array) used to (a config session,
+// write and read-back per gate, 20 ms apart).
+//
+//   profile_switch [ack latency ms]   default 10
+//
+// Switches go through a controller write of the vendor ActiveProfile
+// attribute, so the write callback, command queue and published result are
+// covered too. Every switch is checked against the thresholds the simulated
+// sensor ends up holding.
+#include "ld2410c_wrapper.h"
+#include "MatterInterface.h"
+#include "esp_matter.h"
+#include "esp_matter_standin.h"
+#include "esp_timer.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "host_idf.h"
+#include "ld2410_driver.h"
+#include "ld2410_profiles.h"
+#include "ld2410_sim.h"
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+// DiagnosticLogProvider.cpp needs the CHIP diagnostic logs server; not built here
+void ld2410c_register_diagnostic_logs(esp_matter::node_t *node) { (void)node; }
+
+static uint16_t g_endpoint = 0xFFFF;
+
+static uint32_t attr_u(uint32_t id) {
+    const esp_matter_attr_val_t *v = esp_matter_standin::value(g_endpoint, LD2410C_CLUSTER_ID, id);
+    if (!v) return 0xFFFFFFFF;
+    return v->type == ESP_MATTER_VAL_TYPE_UINT16 ? v->val.u16 : v->val.u8;
+}
+
+static bool sim_holds(const LD2410Sim &sim, const LD2410Profile &p) {
+    return memcmp(sim.movingThresholds(), p.moving, 9) == 0 && memcmp(sim.stationaryThresholds(), p.stationary, 9) == 0;
+}
+
+static void row(const char *name, uint32_t cmds, double ms, const char *active, bool ok) {
+    printf("%-34s %6u %10.1f   %-8s %s\n", name, cmds, ms, active, ok ? "ok" : "MISMATCH");
+}
+
+// Old path: every gate in its own config session
+static bool per_gate(LD2410Sim &sim, const LD2410Profile &p) {
+    LD2410Driver drv(UART_NUM_1);
+    uint32_t c0 = sim.commands();
+    int64_t t0 = esp_timer_get_time();
+    bool ok = true;
+    for (uint8_t g = 0; g < 9 && ok; g++) {
+        ok = drv.setGateParameters(g, p.moving[g], p.stationary[g]);
+        vTaskDelay(pdMS_TO_TICKS(20));
+    }
+    ok = ok && drv.setMaxGate(p.maxMovingGate, p.maxStationaryGate, p.noOneWindow);
+    row(p.name[0] == 'n' ? "home -> night, per-gate sessions" : "night -> home, per-gate sessions", sim.commands() - c0, (esp_timer_get_time() - t0) / 1000.0, "-", ok && sim_holds(sim, p));
+    return ok && sim_holds(sim, p);
+}
+
+static const char *slot_name(uint32_t slot, const LD2410Profiles &ref) {
+    const LD2410Profile *p = ref.get((uint8_t)slot);
+    return p ? p->name : "none";
+}
+
+static bool select_slot(LD2410Sim &sim, const LD2410Profiles &ref, uint8_t slot, const char *label) {
+    uint32_t c0 = sim.commands();
+    esp_err_t err = esp_matter_standin::write(g_endpoint, LD2410C_CLUSTER_ID, LD2410C_ATTR_ACTIVE_PROFILE, esp_matter_uint8(slot));
+    ld2410c_run_commands();
+    bool ok = err == ESP_OK && attr_u(LD2410C_ATTR_ACTIVE_PROFILE) == slot && ref.get(slot) && sim_holds(sim, *ref.get(slot));
+    row(label, sim.commands() - c0, attr_u(LD2410C_ATTR_PROFILE_SWITCH_MS), slot_name(attr_u(LD2410C_ATTR_ACTIVE_PROFILE), ref), ok);
+    return ok;
+}
+
+static bool command(uint8_t id, uint8_t a0, uint8_t a1, uint8_t a2) {
+    ld2410c_command_t cmd = {id, {a0, a1, a2}};
+    if (!ld2410c_submit_command(&cmd)) return false;
+    ld2410c_run_commands();
+    return attr_u(LD2410C_ATTR_LAST_COMMAND_STATUS) == LD2410C_CMD_STATUS_SUCCESS;
+}
+
+int main(int argc, char **argv) {
+    uint32_t ackMs = argc > 1 ? (uint32_t)atoi(argv[1]) : 10;
+    LD2410Sim sim(UART_NUM_1);
+    sim.setAckLatencyUs(ackMs * 1000);
+    printf("ack latency %u ms\n", ackMs);
+    printf("%-34s %6s %10s   %-8s\n", "switch", "cmds", "blackout", "active");
+
+    // Reference copy of the slots the firmware uses (defaults)
+    LD2410Profile night = {"night", {50, 50, 40, 30, 20, 15, 15, 15, 15}, {0, 0, 25, 25, 20, 20, 15, 15, 15}, 6, 6, 30};
+    uart_driver_install(UART_NUM_1, 256, 0, 0, nullptr, 0);
+    uart_set_baudrate(UART_NUM_1, LD2410_BAUD_RATE);
+    bool ok = per_gate(sim, night);
+    LD2410Profile home = {"home", {50, 50, 40, 30, 20, 15, 15, 15, 15}, {0, 0, 40, 40, 30, 30, 20, 20, 20}, 8, 8, 5};
+    ok &= per_gate(sim, home); // back to factory values for the firmware run
+    uart_driver_delete(UART_NUM_1);
+
+    ld2410c_init();
+    esp_matter_node_t *node = esp_matter_node_create_wrapper();
+    g_endpoint = create_occupancy_sensor_endpoint(node, "profiles");
+    ld2410c_set_vendor_endpoint(g_endpoint);
+
+    LD2410Profiles ref;
+    ref.set(0, home);
+    ref.set(1, night);
+    ref.set(2, {"away", {60, 60, 50, 40, 30, 25, 25, 25, 25}, {100, 100, 100, 100, 100, 100, 100, 100, 100}, 8, 8, 5});
+
+    ok &= select_slot(sim, ref, 1, "home -> night");
+    ok &= select_slot(sim, ref, 2, "night -> away");
+    ok &= select_slot(sim, ref, 0, "away -> home");
+    ok &= select_slot(sim, ref, 0, "home -> home (no change)");
+
+    // Tune one gate by hand, keep it as slot 3, come back to it later
+    ok &= command(LD2410C_CMD_SET_GATE_THRESHOLDS, 4, 35, 22);
+    ok &= command(LD2410C_CMD_SAVE_PROFILE, 3, 0, 0);
+    LD2410Profile custom = home;
+    strcpy(custom.name, "custom3");
+    custom.moving[4] = 35;
+    custom.stationary[4] = 22;
+    ref.set(3, custom);
+    ok &= select_slot(sim, ref, 1, "custom3 -> night");
+    ok &= select_slot(sim, ref, 3, "night -> custom3");
+
+    // Out of range slot: the write is rejected, nothing is queued
+    bool rejected = esp_matter_standin::write(g_endpoint, LD2410C_CLUSTER_ID, LD2410C_ATTR_ACTIVE_PROFILE, esp_matter_uint8(9)) != ESP_OK;
+    printf("write ActiveProfile = 9: %s\n", rejected ? "rejected" : "ACCEPTED");
+    ok &= rejected && attr_u(LD2410C_ATTR_ACTIVE_PROFILE) == 3;
+
+    // What the next boot finds in NVS
+    LD2410Profiles boot;
+    uint8_t saved = boot.load();
+    bool persisted = saved == 3 && boot.get(3) && memcmp(boot.get(3)->stationary, custom.stationary, 9) == 0;
+    printf("NVS: active slot %u, slot 3 %s\n", saved, persisted ? "stored" : "MISSING");
+    ok &= persisted;
+
+    printf("%s\n", ok ? "PASS" : "FAIL");
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,134 @@
+// End-to-end publish benchmark: simulated LD2410 frame -> ld2410c_poll() ->
+// ld2410c_update_vendor_* -> staged batch -> attribute::update, against the
+// in-memory esp_matter stand-in. Read-through attributes only reach a
+// snapshot and are pulled when reported (pull/fr). Each subscriber count
+// replays the same walk; after every frame the stand-in reporting engine
+// runs once, so the report numbers are an upper bound (real subscriptions
+// coalesce over their min interval).
+//
+//   publish_bench [frames] [subscriber counts...]   default: 3000 frames, 0 1 2 4 8
+//
+// CPU time is wall time around the calls; UART/task waits cost nothing
+// because time is virtual (host_idf.h).
+#include "ld2410c_wrapper.h"
+#include "MatterInterface.h"
+#include "esp_matter.h"
+#include "esp_matter_standin.h"
+#include "esp_timer.h"
+#include "host_idf.h"
+#include "ld2410_sim.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+// DiagnosticLogProvider.cpp needs the CHIP diagnostic logs server; not built here
+void ld2410c_register_diagnostic_logs(esp_matter::node_t *node) { (void)node; }
+
+static uint16_t g_occupancy_endpoint = 0xFFFF;
+
+// What Main.swift does with every transition
+static void on_occupancy(const ld2410c_occupancy_event_t *ev, void *ctx) {
+    (void)ctx;
+    set_occupancy_attribute_value(g_occupancy_endpoint, ev->present);
+}
+
+// Person walking between 0.5 m and 4 m and pausing, with sensor-like noise
+struct Walk {
+    std::mt19937 rng{2410};
+    double pos = 150, vel = 60; // cm, cm/s
+    uint32_t pauseUntil = 0;
+
+    LD2410Sim::Target next(uint32_t t_ms) {
+        std::normal_distribution<double> n(0, 6);
+        std::uniform_real_distribution<double> u(0, 1);
+        bool paused = t_ms < pauseUntil;
+        if (!paused) {
+            pos += vel * 0.1;
+            if (pos > 400 || pos < 50) { vel = -vel; pauseUntil = t_ms + 3000 + (uint32_t)(u(rng) * 4000); }
+        }
+        LD2410Sim::Target tg;
+        tg.status = paused ? 2 : 3;
+        uint16_t d = (uint16_t)std::max(1.0, pos + n(rng));
+        tg.movingCm = paused ? 0 : d;
+        tg.movingSignal = paused ? 0 : (uint8_t)(60 + u(rng) * 30);
+        tg.stationaryCm = (uint16_t)std::max(1.0, pos + n(rng));
+        tg.stationarySignal = (uint8_t)(40 + u(rng) * 30);
+        tg.distanceCm = d;
+        int gate = std::min(8, (int)(pos / 75));
+        for (int g = 0; g < 9; g++) {
+            int falloff = 40 * std::abs(g - gate);
+            tg.movingGates[g] = (uint8_t)std::max(0, (paused ? 5 : 90) - falloff + (int)(u(rng) * 8));
+            tg.stationaryGates[g] = (uint8_t)std::max(0, 70 - falloff + (int)(u(rng) * 8));
+        }
+        tg.light = 120;
+        return tg;
+    }
+};
+
+int main(int argc, char **argv) {
+    unsigned frames = argc > 1 ? (unsigned)atoi(argv[1]) : 3000;
+    std::vector<unsigned> subs;
+    for (int i = 2; i < argc; i++) subs.push_back((unsigned)atoi(argv[i]));
+    if (subs.empty()) subs = {0, 1, 2, 4, 8};
+
+    LD2410Sim sim(UART_NUM_1);
+    ld2410c_init();
+
+    esp_matter_node_t *node = esp_matter_node_create_wrapper();
+    g_occupancy_endpoint = create_occupancy_sensor_endpoint(node, "bench");
+    ld2410c_set_vendor_endpoint(g_occupancy_endpoint);
+    for (uint8_t z = 0; z < ld2410c_zone_count(); z++) {
+        if (ld2410c_zone_reachable(z)) ld2410c_set_zone_endpoint(z, create_zone_occupancy_endpoint(node));
+    }
+    ld2410c_register_occupancy_callback(on_occupancy, nullptr);
+
+    printf("sensor: engineering=%d resolution=%u cm, zones=%u, init %u commands\n",
+           sim.engineering(), sim.resolutionCm(), ld2410c_zone_count(), sim.commands());
+
+    Walk walk;
+    uint32_t t_ms = (uint32_t)(esp_timer_get_time() / 1000);
+    // Past the 4 s publish hold-off
+    for (unsigned i = 0; i < 60; i++, t_ms += 100) {
+        if (esp_timer_get_time() < (int64_t)t_ms * 1000) host_clock_set_us((int64_t)t_ms * 1000);
+        sim.emitFrame(walk.next(t_ms));
+        ld2410c_poll();
+    }
+    esp_matter_standin::flush_reports();
+
+    printf("%5s %10s %10s %10s %9s %9s %9s %9s %9s %9s %10s %10s\n", "subs", "poll_us", "poll_p99", "flush_us",
+           "upd/fr", "chg/fr", "lock/fr", "msg/fr", "attr/fr", "pull/fr", "bytes/fr", "total_us");
+    for (unsigned s : subs) {
+        esp_matter_standin::set_subscribers(s);
+        esp_matter_standin::reset_stats();
+        std::vector<double> poll(frames);
+        double flushSum = 0;
+        for (unsigned i = 0; i < frames; i++, t_ms += 100) {
+            if (esp_timer_get_time() < (int64_t)t_ms * 1000) host_clock_set_us((int64_t)t_ms * 1000);
+            sim.emitFrame(walk.next(t_ms));
+            auto a = std::chrono::steady_clock::now();
+            ld2410c_poll();
+            auto b = std::chrono::steady_clock::now();
+            esp_matter_standin::flush_reports();
+            auto c = std::chrono::steady_clock::now();
+            poll[i] = std::chrono::duration<double, std::micro>(b - a).count();
+            flushSum += std::chrono::duration<double, std::micro>(c - b).count();
+        }
+        esp_matter_standin::Stats st = esp_matter_standin::stats();
+        double mean = 0;
+        for (double v : poll) mean += v;
+        mean /= frames;
+        std::vector<double> sorted = poll;
+        std::sort(sorted.begin(), sorted.end());
+        double p99 = sorted[(size_t)(frames * 0.99)];
+        printf("%5u %10.2f %10.2f %10.2f %9.2f %9.2f %9.2f %9.2f %9.2f %9.2f %10.1f %10.2f\n", s, mean, p99, flushSum / frames,
+               (double)st.updates / frames, (double)st.changed / frames, (double)st.lockAcquisitions / frames, (double)st.reportMessages / frames,
+               (double)st.reportedAttributes / frames, (double)st.overrideReads / frames, (double)st.reportBytes / frames, mean + flushSum / frames);
+    }
+    esp_matter_standin::Stats st = esp_matter_standin::stats();
+    printf("lookups per update: %.2f (endpoint/cluster/attribute get calls)\n", st.updates ? (double)st.lookups / st.updates : 0.0);
+    return 0;
+}
@@ -0,0 +1,244 @@
+// Replays LD2410 captures through ld2410c_poll() and the esp_matter stand-in
+// (one subscriber) with the repeated-frame fast path off and on: CPU per
+// frame, repeat share, and a check that both runs publish the same thing.
+//
+//   repeat_replay                   built-in captures (basic and engineering mode)
+//   repeat_replay capture.bin...    bytes as read from the sensor UART, 10 Hz
+//
+// Built-in captures: 8 min empty room, 1 min walking, 6 min sitting still,
+// walking out, 5 min empty. A still person's stationary values move every few
+// frames; an empty room sends zeros in basic mode, while engineering frames
+// carry gate noise and so rarely repeat.
+//
+// After every poll the vendor attributes (all but the repeat share), both
+// occupancy attributes of the zones and the main endpoint are compared
+// between the runs; any difference is a FAIL.
+#include "ld2410c_wrapper.h"
+#include "ld2410_driver.h"
+#include "MatterInterface.h"
+#include "esp_matter.h"
+#include "esp_matter_standin.h"
+#include "esp_timer.h"
+#include "host_idf.h"
+#include "ld2410_sim.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <string>
+#include <vector>
+
+// DiagnosticLogProvider.cpp needs the CHIP diagnostic logs server; not built here
+void ld2410c_register_diagnostic_logs(esp_matter::node_t *node) { (void)node; }
+
+static uint16_t g_occupancy_endpoint = 0xFFFF;
+static uint16_t g_zone_endpoints[4] = {0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF};
+static uint8_t g_zones = 0;
+
+static void on_occupancy(const ld2410c_occupancy_event_t *ev, void *ctx) {
+    (void)ctx;
+    set_occupancy_attribute_value(g_occupancy_endpoint, ev->present);
+}
+
+typedef std::vector<std::vector<uint8_t>> Frames;
+
+static Frames synthesize(bool engineering) {
+    std::mt19937 rng(2410);
+    std::uniform_real_distribution<double> u(0, 1);
+    Frames out;
+    auto emit = [&](const LD2410Sim::Target &t) {
+        uint8_t f[LD2410_SIM_FRAME_MAX];
+        size_t n = LD2410Sim::encodeFrame(t, engineering, 8, 8, f);
+        out.emplace_back(f, f + n);
+    };
+    auto empty = [&](unsigned frames) {
+        for (unsigned i = 0; i < frames; i++) {
+            LD2410Sim::Target t;
+            for (int g = 0; g < 9; g++) { t.movingGates[g] = (uint8_t)(u(rng) * 12); t.stationaryGates[g] = (uint8_t)(u(rng) * 12); }
+            emit(t);
+        }
+    };
+    auto gates = [&](LD2410Sim::Target &t, double pos, bool walking) {
+        int gate = std::min(8, (int)(pos / 75));
+        for (int g = 0; g < 9; g++) {
+            int falloff = 40 * std::abs(g - gate);
+            t.movingGates[g] = (uint8_t)std::max(0, (walking ? 90 : 5) - falloff + (int)(u(rng) * 8));
+            t.stationaryGates[g] = (uint8_t)std::max(0, 70 - falloff + (int)(u(rng) * 8));
+        }
+    };
+    auto walk = [&](double from, double to, unsigned frames) {
+        for (unsigned i = 0; i < frames; i++) {
+            double pos = from + (to - from) * i / frames;
+            LD2410Sim::Target t;
+            t.status = 3;
+            t.movingCm = t.distanceCm = (uint16_t)(pos + u(rng) * 10);
+            t.movingSignal = (uint8_t)(60 + u(rng) * 30);
+            t.stationaryCm = (uint16_t)(pos + u(rng) * 10);
+            t.stationarySignal = (uint8_t)(40 + u(rng) * 20);
+            gates(t, pos, true);
+            emit(t);
+        }
+    };
+    auto sit = [&](double pos, unsigned frames) {
+        LD2410Sim::Target t;
+        t.status = 2;
+        t.stationaryCm = t.distanceCm = (uint16_t)pos;
+        t.stationarySignal = 55;
+        gates(t, pos, false);
+        for (unsigned i = 0; i < frames; i++) {
+            // Breathing: the reported values move every few frames
+            if (u(rng) < 0.3) {
+                t.stationaryCm = t.distanceCm = (uint16_t)(pos + u(rng) * 6);
+                t.stationarySignal = (uint8_t)(50 + u(rng) * 12);
+                gates(t, pos, false);
+            }
+            emit(t);
+        }
+    };
+    empty(4800);
+    walk(450, 120, 150);
+    walk(120, 300, 150);
+    walk(300, 120, 300);
+    sit(120, 3600);
+    walk(120, 440, 60);
+    empty(3000);
+    return out;
+}
+
+static Frames load(const char *path) {
+    Frames out;
+    FILE *fp = fopen(path, "rb");
+    if (!fp) { perror(path); exit(1); }
+    std::vector<uint8_t> b;
+    uint8_t buf[65536];
+    size_t n;
+    while ((n = fread(buf, 1, sizeof(buf), fp)) > 0) b.insert(b.end(), buf, buf + n);
+    fclose(fp);
+    static const uint8_t HEAD[4] = {0xF4, 0xF3, 0xF2, 0xF1}, TAIL[4] = {0xF8, 0xF7, 0xF6, 0xF5};
+    for (size_t i = 0; i + 4 <= b.size(); i++) {
+        if (memcmp(&b[i], HEAD, 4)) continue;
+        for (size_t j = i + 4; j + 4 <= b.size() && j - i <= LD2410_BUFFER_SIZE + 4; j++) {
+            if (memcmp(&b[j], TAIL, 4)) continue;
+            out.emplace_back(b.begin() + i, b.begin() + j + 4);
+            i = j + 3;
+            break;
+        }
+    }
+    return out;
+}
+
+// Everything a subscriber could see, as one string per poll
+static std::string snapshot() {
+    std::string s;
+    auto add = [&](const esp_matter_attr_val_t *v) {
+        if (!v) { s += '-'; return; }
+        s.append((const char *)&v->type, sizeof(v->type));
+        if (v->type == ESP_MATTER_VAL_TYPE_CHAR_STRING || v->type == ESP_MATTER_VAL_TYPE_OCTET_STRING) {
+            if (v->val.a.b) s.append((const char *)v->val.a.b, v->val.a.s);
+        } else {
+            s.append((const char *)&v->val.u32, sizeof(v->val.u32));
+        }
+    };
+    for (uint32_t id = 0; id < LD2410C_ATTR_FRAME_REPEAT_PERCENT; id++) add(esp_matter_standin::value(g_occupancy_endpoint, LD2410C_CLUSTER_ID, id));
+    add(esp_matter_standin::value(g_occupancy_endpoint, 0x0406, 0x0000));
+    for (uint8_t z = 0; z < g_zones; z++) add(esp_matter_standin::value(g_zone_endpoints[z], 0x0406, 0x0000));
+    return s;
+}
+
+struct Run {
+    double us = 0;
+    ld2410c_frame_stats_t fs = {};
+    uint64_t reports = 0;
+    std::vector<std::string> states;
+};
+
+static Run replay(const Frames &frames, uint32_t &t_ms, bool skip, bool record) {
+    Run r;
+    ld2410c_set_skip_repeats(skip);
+    ld2410c_set_report_mode(0, 0); // same publish phase in every run
+    ld2410c_run_commands();
+    ld2410c_frame_stats_t before;
+    ld2410c_frame_stats(&before);
+    esp_matter_standin::reset_stats();
+    for (const std::vector<uint8_t> &f : frames) {
+        t_ms += 100;
+        if (esp_timer_get_time() < (int64_t)t_ms * 1000) host_clock_set_us((int64_t)t_ms * 1000);
+        host_uart_inject(UART_NUM_1, f.data(), f.size(), esp_timer_get_time());
+        auto a = std::chrono::steady_clock::now();
+        ld2410c_poll();
+        esp_matter_standin::flush_reports();
+        auto b = std::chrono::steady_clock::now();
+        r.us += std::chrono::duration<double, std::micro>(b - a).count();
+        if (record) r.states.push_back(snapshot());
+    }
+    ld2410c_frame_stats(&r.fs);
+    r.fs.frames -= before.frames;
+    r.fs.repeated -= before.repeated;
+    r.fs.settled_skips -= before.settled_skips;
+    r.fs.publish_skips -= before.publish_skips;
+    r.reports = esp_matter_standin::stats().reportedAttributes;
+    return r;
+}
+
+int main(int argc, char **argv) {
+    LD2410Sim sim(UART_NUM_1);
+    ld2410c_init();
+    esp_matter_node_t *node = esp_matter_node_create_wrapper();
+    g_occupancy_endpoint = create_occupancy_sensor_endpoint(node, "replay");
+    ld2410c_set_vendor_endpoint(g_occupancy_endpoint);
+    g_zones = ld2410c_zone_count();
+    for (uint8_t z = 0; z < g_zones; z++) {
+        if (!ld2410c_zone_reachable(z)) continue;
+        g_zone_endpoints[z] = create_zone_occupancy_endpoint(node);
+        ld2410c_set_zone_endpoint(z, g_zone_endpoints[z]);
+    }
+    ld2410c_register_occupancy_callback(on_occupancy, nullptr);
+    esp_matter_standin::set_subscribers(1);
+    // The captures carry their own sensor mode
+    ld2410c_set_mode_auto(false);
+
+    struct Capture { std::string name; Frames frames; };
+    std::vector<Capture> captures;
+    for (int i = 1; i < argc; i++) captures.push_back({argv[i], load(argv[i])});
+    if (captures.empty()) {
+        captures.push_back({"synthetic basic", synthesize(false)});
+        captures.push_back({"synthetic engineering", synthesize(true)});
+    }
+
+    // Past the publish hold-off, on an empty room
+    uint32_t t_ms = (uint32_t)(esp_timer_get_time() / 1000);
+    Frames warm = synthesize(false);
+    warm.resize(100);
+    replay(warm, t_ms, true, false);
+
+    printf("%-24s %7s %8s %9s %9s %9s %10s %10s %8s\n", "capture", "frames", "repeat%", "settled%", "pubskip",
+           "attrs", "us/fr off", "us/fr on", "saved");
+    bool ok = true;
+    for (const Capture &c : captures) {
+        if (c.frames.empty()) { printf("%-24s no data frames\n", c.name.c_str()); ok = false; continue; }
+        // Best of three for the timing; the first pair also compares the published
+        // state. Each run starts from the capture's own first frames.
+        Frames lead(c.frames.begin(), c.frames.begin() + std::min<size_t>(50, c.frames.size()));
+        replay(lead, t_ms, false, false);
+        Run off = replay(c.frames, t_ms, false, true);
+        replay(lead, t_ms, false, false);
+        Run on = replay(c.frames, t_ms, true, true);
+        size_t diff = 0;
+        for (size_t i = 0; i < off.states.size(); i++) diff += off.states[i] != on.states[i];
+        for (int rep = 0; rep < 2; rep++) {
+            off.us = std::min(off.us, replay(c.frames, t_ms, false, false).us);
+            on.us = std::min(on.us, replay(c.frames, t_ms, true, false).us);
+        }
+        double n = (double)c.frames.size();
+        printf("%-24s %7zu %8.1f %9.1f %9u %4llu/%-4llu %10.2f %10.2f %7.1f%%\n", c.name.c_str(), c.frames.size(),
+               100.0 * on.fs.repeated / n, 100.0 * on.fs.settled_skips / n, on.fs.publish_skips,
+               (unsigned long long)off.reports, (unsigned long long)on.reports,
+               off.us / n, on.us / n, 100.0 * (1 - on.us / off.us));
+        if (diff) printf("  %zu polls published a different state with the fast path\n", diff);
+        ok &= !diff && on.fs.frames == c.frames.size();
+    }
+    printf("%s\n", ok ? "PASS" : "FAIL");
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,258 @@
+// Many-sensor load test: N independent LD2410Driver instances, each on its
+// own host UART port with a simulated sensor sending engineering frames,
+// sharded over worker threads the way one sensor task per radar would be.
+//
+//   sensor_load [threads] [seconds per step] [N...]   default: all cores, 3, 1 10 100 1000 4000
+//
+// Per N, two passes:
+//   saturated  every instance gets frames back to back; frames/s per core is
+//              decoded frames over the workers' thread CPU time
+//   paced      10 Hz per instance (+-10 ms jitter, random phase), in wall
+//              time; a worker polls an instance when its frame is due.
+//              Latency runs from the frame's due time to the frame callback
+//              that decoded it (matched by a sequence number in the frame);
+//              the worker sleeps 1 ms when nothing is due.
+// 1% of the paced frames are damaged: junk bytes in front (the frame must
+// still decode), a broken tail, or a truncated frame (this one and possibly
+// the next are lost; broken % counts these two). Memory per instance is the
+// heap growth while creating the instances: driver and simulator state, not
+// the host UART ports (the firmware's UART driver holds a 256 B RX ring).
+#include "ld2410_driver.h"
+#include "esp_timer.h"
+#include "host_idf.h"
+#include "ld2410_sim.h"
+#include "work_pool.h"
+#include <malloc.h>
+#include <time.h>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#define FRAME_US 100000
+#define JITTER_US 10000
+#define DAMAGE_PER_MILLE 10
+#define SEQ_SLOTS 16
+#define FIRST_PORT UART_NUM_MAX
+
+typedef std::chrono::steady_clock Clock;
+
+struct Instance {
+    LD2410Driver drv;
+    uart_port_t port;
+    uint32_t rng;
+    uint16_t seq = 0;
+    int64_t nextUs = 0;
+    int64_t dueUs[SEQ_SLOTS] = {};
+    uint32_t sent = 0, damaged = 0, decoded = 0;
+    std::vector<float> *lat = nullptr; // owning worker's samples (ms)
+    Clock::time_point t0;
+
+    Instance(uart_port_t p, uint32_t seed) : drv(p), port(p), rng(seed) {}
+
+    uint32_t rand() {
+        rng ^= rng << 13; rng ^= rng >> 17; rng ^= rng << 5;
+        return rng;
+    }
+
+    // One engineering frame carrying the sequence number as the stationary distance
+    size_t frame(uint8_t *f) {
+        LD2410Sim::Target t;
+        t.status = 3;
+        t.movingCm = (uint16_t)(50 + rand() % 400);
+        t.movingSignal = (uint8_t)(rand() % 100);
+        t.stationaryCm = seq;
+        t.stationarySignal = (uint8_t)(rand() % 100);
+        t.distanceCm = t.movingCm;
+        for (int g = 0; g < 9; g++) { t.movingGates[g] = (uint8_t)(rand() % 100); t.stationaryGates[g] = (uint8_t)(rand() % 100); }
+        return LD2410Sim::encodeFrame(t, true, 8, 8, f);
+    }
+
+    static void onFrame(const LD2410Driver::SensorData &d, void *ctx) {
+        Instance *in = (Instance *)ctx;
+        in->decoded++;
+        if (!in->lat) return;
+        int64_t now = std::chrono::duration_cast<std::chrono::microseconds>(Clock::now() - in->t0).count();
+        in->lat->push_back((now - in->dueUs[d.sTargetDistance % SEQ_SLOTS]) / 1000.0f);
+    }
+};
+
+static double thread_cpu_s() {
+    timespec ts;
+    clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+// Reads everything the instance has pending
+static void drain(Instance &in, int64_t virtUs) {
+    host_clock_set_us(virtUs);
+    while (in.drv.check() != LD2410Driver::FAIL) {}
+}
+
+struct Step {
+    double satFramesPerCoreS = 0;
+    double satCpuS = 0;
+    uint64_t satFrames = 0;
+    std::vector<float> lat;
+    uint64_t sent = 0, damaged = 0, decoded = 0;
+    double pacedCpuS = 0;
+};
+
+static void saturated(std::vector<std::unique_ptr<Instance>> &all, WorkPool &pool, Step &st) {
+    unsigned shards = pool.threads();
+    std::vector<double> cpu(shards, 0);
+    std::vector<uint64_t> frames(shards, 0);
+    // About 20000 frames per step, at least 3 per instance
+    unsigned rounds = std::max<unsigned>(3, 20000 / (unsigned)all.size());
+    pool.parallelFor(shards, 1, [&](size_t b, size_t e) {
+        for (size_t s = b; s < e; s++) {
+            double c0 = thread_cpu_s();
+            uint8_t f[LD2410_SIM_FRAME_MAX];
+            int64_t virt = 0;
+            for (unsigned r = 0; r < rounds; r++) {
+                for (size_t i = s; i < all.size(); i += shards) {
+                    Instance &in = *all[i];
+                    uint32_t before = in.decoded;
+                    size_t n = in.frame(f);
+                    in.seq++;
+                    host_uart_inject(in.port, f, n, virt);
+                    drain(in, virt);
+                    frames[s] += in.decoded - before;
+                }
+                virt += FRAME_US;
+            }
+            cpu[s] = thread_cpu_s() - c0;
+        }
+    });
+    for (unsigned s = 0; s < shards; s++) { st.satCpuS += cpu[s]; st.satFrames += frames[s]; }
+    st.satFramesPerCoreS = st.satCpuS > 0 ? st.satFrames / st.satCpuS : 0;
+}
+
+static void paced(std::vector<std::unique_ptr<Instance>> &all, WorkPool &pool, double seconds, Step &st) {
+    unsigned shards = pool.threads();
+    std::vector<std::vector<float>> lat(shards);
+    std::vector<double> cpu(shards, 0);
+    Clock::time_point t0 = Clock::now() + std::chrono::milliseconds(10);
+    int64_t endUs = (int64_t)(seconds * 1e6);
+    for (auto &p : all) {
+        p->t0 = t0;
+        p->nextUs = p->rand() % FRAME_US; // random phase
+        p->sent = p->damaged = p->decoded = 0;
+    }
+    pool.parallelFor(shards, 1, [&](size_t b, size_t e) {
+        for (size_t s = b; s < e; s++) {
+            lat[s].reserve((size_t)(seconds * 10 * (all.size() / shards + 1)));
+            for (size_t i = s; i < all.size(); i += shards) all[i]->lat = &lat[s];
+            std::this_thread::sleep_until(t0);
+            double c0 = thread_cpu_s();
+            uint8_t f[LD2410_SIM_FRAME_MAX + 32];
+            for (;;) {
+                int64_t now = std::chrono::duration_cast<std::chrono::microseconds>(Clock::now() - t0).count();
+                if (now >= endUs) break;
+                bool any = false;
+                for (size_t i = s; i < all.size(); i += shards) {
+                    Instance &in = *all[i];
+                    if (in.nextUs > now) continue;
+                    any = true;
+                    in.dueUs[in.seq % SEQ_SLOTS] = in.nextUs;
+                    size_t n = in.frame(f);
+                    in.seq++;
+                    in.sent++;
+                    if (in.rand() % 1000 < DAMAGE_PER_MILLE) {
+                        in.damaged++;
+                        switch (in.rand() % 3) {
+                            case 0: { // junk in front
+                                uint8_t junk[24];
+                                size_t k = 1 + in.rand() % sizeof(junk);
+                                for (size_t j = 0; j < k; j++) junk[j] = (uint8_t)in.rand();
+                                host_uart_inject(in.port, junk, k, now);
+                                in.damaged--; // still decodes
+                                break;
+                            }
+                            case 1: f[n - 1 - in.rand() % 4] ^= 0x5A; break; // broken tail
+                            default: n -= 1 + in.rand() % (n / 2); break;    // truncated
+                        }
+                    }
+                    host_uart_inject(in.port, f, n, now);
+                    int64_t jitter = (int64_t)(in.rand() % (2 * JITTER_US + 1)) - JITTER_US;
+                    in.nextUs += FRAME_US + jitter;
+                    drain(in, now);
+                }
+                if (!any) std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            }
+            cpu[s] = thread_cpu_s() - c0;
+            for (size_t i = s; i < all.size(); i += shards) all[i]->lat = nullptr;
+        }
+    });
+    for (unsigned s = 0; s < shards; s++) {
+        st.lat.insert(st.lat.end(), lat[s].begin(), lat[s].end());
+        st.pacedCpuS += cpu[s];
+    }
+    for (auto &p : all) { st.sent += p->sent; st.damaged += p->damaged; st.decoded += p->decoded; }
+}
+
+static float percentile(std::vector<float> &v, double q) {
+    if (v.empty()) return 0;
+    size_t k = std::min(v.size() - 1, (size_t)(v.size() * q));
+    std::nth_element(v.begin(), v.begin() + k, v.end());
+    return v[k];
+}
+
+int main(int argc, char **argv) {
+    unsigned threads = argc > 1 ? (unsigned)atoi(argv[1]) : 0;
+    double seconds = argc > 2 ? atof(argv[2]) : 3;
+    std::vector<unsigned> ns;
+    for (int i = 3; i < argc; i++) ns.push_back((unsigned)atoi(argv[i]));
+    if (ns.empty()) ns = {1, 10, 100, 1000, 4000};
+    for (unsigned n : ns) {
+        if (!n || n > HOST_UART_PORTS - FIRST_PORT) { fprintf(stderr, "N must be 1..%u\n", HOST_UART_PORTS - FIRST_PORT); return 1; }
+    }
+    if (seconds <= 0) { fprintf(stderr, "usage: sensor_load [threads] [seconds per step] [N...]\n"); return 1; }
+
+    WorkPool pool(threads);
+    printf("%u worker threads on %u cores, sizeof(LD2410Driver) = %zu B\n", pool.threads(),
+           std::thread::hardware_concurrency(), sizeof(LD2410Driver));
+    printf("%6s %12s %10s %9s %9s %9s %8s %8s %8s %9s\n", "N", "frames/s/core", "us/frame", "p50 ms", "p99 ms",
+           "max ms", "loss %", "broken %", "cpu %", "heap B/N");
+    // Host UART ports are created on first use; create them up front so the
+    // heap growth below is the instances themselves
+    unsigned maxN = *std::max_element(ns.begin(), ns.end());
+    for (unsigned i = 0; i < maxN; i++) host_uart_pending((uart_port_t)(FIRST_PORT + i));
+    bool ok = true;
+    for (unsigned n : ns) {
+        std::vector<std::unique_ptr<Instance>> all;
+        all.reserve(n);
+        size_t heap0 = mallinfo2().uordblks;
+        for (unsigned i = 0; i < n; i++) {
+            uart_port_t port = (uart_port_t)(FIRST_PORT + i);
+            uart_config_t cfg = {};
+            cfg.baud_rate = 256000;
+            uart_param_config(port, &cfg);
+            uart_driver_delete(port); // nothing left over from the last step
+            uart_driver_install(port, 256, 0, 0, nullptr, 0);
+            all.emplace_back(new Instance(port, 2410 + i));
+            all.back()->drv.setFrameCallback(Instance::onFrame, all.back().get());
+        }
+        size_t heap = mallinfo2().uordblks - heap0;
+
+        Step st;
+        saturated(all, pool, st);
+        paced(all, pool, seconds, st);
+        float p50 = percentile(st.lat, 0.50), p99 = percentile(st.lat, 0.99), mx = percentile(st.lat, 1.0);
+        double loss = st.sent ? 100.0 * (double)(st.sent - std::min(st.sent, st.decoded)) / st.sent : 0;
+        printf("%6u %12.0f %10.2f %9.2f %9.2f %9.2f %8.2f %8.2f %8.1f %9zu\n", n, st.satFramesPerCoreS,
+               st.satFrames ? st.satCpuS * 1e6 / st.satFrames : 0.0, p50, p99, mx, loss,
+               st.sent ? 100.0 * st.damaged / st.sent : 0.0, 100.0 * st.pacedCpuS / (seconds * pool.threads()), heap / n);
+        // Every undamaged frame decodes; a damaged one costs at most itself and the next
+        ok &= st.satFrames == (uint64_t)n * std::max<unsigned>(3, 20000 / n);
+        ok &= st.decoded + 2 * st.damaged >= st.sent;
+        // Paced frames are read within one frame period
+        ok &= p99 < FRAME_US / 1000.0f;
+    }
+    printf("%s\n", ok ? "PASS" : "FAIL");
+    return ok ? 0 : 1;
+}
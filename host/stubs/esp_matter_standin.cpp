@@ -0,0 +1,399 @@
+// In-memory esp_matter data model for host tools (esp_matter.h)
+#include "esp_matter.h"
+#include "esp_matter_standin.h"
+#include "app/reporting/reporting.h"
+#include "app/InteractionModelEngine.h"
+#include <cstring>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+using namespace esp_matter;
+
+struct esp_matter::attribute_s {
+    uint32_t id;
+    uint16_t flags;
+    uint16_t endpoint;
+    uint32_t cluster;
+    attribute::callback_t override = nullptr;
+    esp_matter_attr_val_t val;
+    std::vector<uint8_t> buf; // string / octet storage
+    bool dirty = false;
+};
+
+struct esp_matter::command_s {
+    uint32_t id;
+    command::callback_t cb;
+};
+
+struct esp_matter::cluster_s {
+    uint32_t id;
+    uint16_t endpoint;
+    std::vector<attribute_t *> attrs;
+    std::vector<command_t *> cmds;
+};
+
+struct esp_matter::endpoint_s {
+    uint16_t id;
+    std::vector<cluster_t *> clusters;
+};
+
+struct esp_matter::node_s {
+    std::vector<endpoint_t *> endpoints;
+    attribute::callback_t attributeCb = nullptr;
+    uint16_t nextId = 1;
+};
+
+namespace {
+
+std::recursive_mutex g_lock;
+std::recursive_mutex g_stack_lock;
+thread_local int t_stack_depth = 0;
+node_t *g_node = nullptr;
+std::vector<attribute_t *> g_dirty;
+unsigned g_subscribers = 0;
+std::map<int, std::unique_ptr<chip::app::ReadHandler>> g_handlers;
+esp_matter_standin::Stats g_stats;
+
+const size_t REPORT_MTU = 1280;
+const size_t REPORT_HEADER = 40;   // exchange + message headers, ReportData envelope
+const size_t ATTR_PATH_BYTES = 16; // AttributeReportIB path + data version
+
+bool is_string(esp_matter_val_type_t t) { return t == ESP_MATTER_VAL_TYPE_CHAR_STRING || t == ESP_MATTER_VAL_TYPE_OCTET_STRING; }
+
+size_t scalar_size(esp_matter_val_type_t t) {
+    switch (t) {
+        case ESP_MATTER_VAL_TYPE_BOOLEAN: case ESP_MATTER_VAL_TYPE_INT8: case ESP_MATTER_VAL_TYPE_UINT8:
+        case ESP_MATTER_VAL_TYPE_ENUM8: case ESP_MATTER_VAL_TYPE_BITMAP8: return 1;
+        case ESP_MATTER_VAL_TYPE_INT16: case ESP_MATTER_VAL_TYPE_UINT16: case ESP_MATTER_VAL_TYPE_BITMAP16: return 2;
+        default: return 4;
+    }
+}
+
+void store(attribute_t *a, const esp_matter_attr_val_t &v) {
+    a->val = v;
+    if (is_string(v.type)) {
+        a->buf.assign(v.val.a.b, v.val.a.b + v.val.a.s);
+        a->val.val.a.b = a->buf.data();
+    }
+}
+
+bool same(const attribute_t *a, const esp_matter_attr_val_t &v) {
+    if (a->val.type != v.type) return false;
+    if (is_string(v.type)) return a->val.val.a.s == v.val.a.s && (v.val.a.s == 0 || memcmp(a->buf.data(), v.val.a.b, v.val.a.s) == 0);
+    return memcmp(&a->val.val, &v.val, scalar_size(v.type)) == 0;
+}
+
+attribute_t *find(uint16_t ep, uint32_t cl, uint32_t at) {
+    if (!g_node) return nullptr;
+    cluster_t *c = cluster::get(endpoint::get(g_node, ep), cl);
+    return c ? attribute::get(c, at) : nullptr;
+}
+
+// Override attributes: the value comes from the callback at read time
+void read_through(attribute_t *a) {
+    if (!(a->flags & ATTRIBUTE_FLAG_OVERRIDE) || !a->override) return;
+    esp_matter_attr_val_t v = a->val;
+    if (a->override(attribute::READ, a->endpoint, a->cluster, a->id, &v, nullptr) != ESP_OK) return;
+    g_stats.overrideReads++;
+    store(a, v);
+}
+
+void mark_dirty(attribute_t *a) {
+    if (a->dirty) return;
+    a->dirty = true;
+    g_dirty.push_back(a);
+}
+
+} // namespace
+
+esp_err_t esp_matter::start(event_callback_t cb) { (void)cb; return ESP_OK; }
+
+lock::status_t lock::chip_stack_lock(uint32_t ticks_to_wait) {
+    (void)ticks_to_wait;
+    if (t_stack_depth) return ALREADY_TAKEN;
+    g_stack_lock.lock();
+    t_stack_depth = 1;
+    std::lock_guard<std::recursive_mutex> g(g_lock);
+    g_stats.lockAcquisitions++;
+    return SUCCESS;
+}
+
+esp_err_t lock::chip_stack_unlock() {
+    if (!t_stack_depth) return ESP_ERR_INVALID_STATE;
+    t_stack_depth = 0;
+    g_stack_lock.unlock();
+    return ESP_OK;
+}
+
+node_t *node::create(config_t *config, attribute::callback_t attribute_cb, void *identify_cb) {
+    (void)config; (void)identify_cb;
+    std::lock_guard<std::recursive_mutex> g(g_lock);
+    if (!g_node) g_node = new node_s;
+    g_node->attributeCb = attribute_cb;
+    return g_node;
+}
+
+node_t *node::get() { return g_node; }
+
+endpoint_t *endpoint::get(node_t *node, uint16_t endpoint_id) {
+    g_stats.lookups++;
+    if (!node) return nullptr;
+    for (endpoint_t *e : node->endpoints) if (e->id == endpoint_id) return e;
+    return nullptr;
+}
+
+uint16_t endpoint::get_id(endpoint_t *endpoint) { return endpoint ? endpoint->id : 0xFFFF; }
+
+endpoint_t *endpoint::occupancy_sensor::create(node_t *node, config_t *config, uint8_t flags, void *priv_data) {
+    (void)flags; (void)priv_data;
+    if (!node) return nullptr;
+    std::lock_guard<std::recursive_mutex> g(g_lock);
+    endpoint_t *e = new endpoint_s;
+    e->id = node->nextId++;
+    node->endpoints.push_back(e);
+    cluster_t *c = cluster::create(e, chip::app::Clusters::OccupancySensing::Id, CLUSTER_FLAG_SERVER);
+    attribute::create(c, chip::app::Clusters::OccupancySensing::Attributes::Occupancy::Id, 0, esp_matter_bitmap8(0));
+    attribute::create(c, 0x0001, 0, esp_matter_uint8(config ? config->occupancy_sensing.occupancy_sensor_type : 0));
+    attribute::create(c, 0x0002, 0, esp_matter_uint8(config ? config->occupancy_sensing.occupancy_sensor_type_bitmap : 0));
+    return e;
+}
+
+cluster_t *cluster::create(endpoint_t *endpoint, uint32_t cluster_id, uint8_t flags) {
+    (void)flags;
+    if (!endpoint) return nullptr;
+    if (cluster_t *c = cluster::get(endpoint, cluster_id)) return c;
+    cluster_t *c = new cluster_s;
+    c->id = cluster_id;
+    c->endpoint = endpoint->id;
+    endpoint->clusters.push_back(c);
+    return c;
+}
+
+cluster_t *cluster::get(endpoint_t *endpoint, uint32_t cluster_id) {
+    g_stats.lookups++;
+    if (!endpoint) return nullptr;
+    for (cluster_t *c : endpoint->clusters) if (c->id == cluster_id) return c;
+    return nullptr;
+}
+
+attribute_t *attribute::create(cluster_t *cluster, uint32_t attribute_id, uint16_t flags, esp_matter_attr_val_t val) {
+    if (!cluster) return nullptr;
+    attribute_t *a = new attribute_s;
+    a->id = attribute_id;
+    a->flags = flags;
+    a->endpoint = cluster->endpoint;
+    a->cluster = cluster->id;
+    store(a, val);
+    cluster->attrs.push_back(a);
+    return a;
+}
+
+attribute_t *attribute::get(cluster_t *cluster, uint32_t attribute_id) {
+    g_stats.lookups++;
+    if (!cluster) return nullptr;
+    for (attribute_t *a : cluster->attrs) if (a->id == attribute_id) return a;
+    return nullptr;
+}
+
+esp_err_t attribute::get_val(attribute_t *attribute, esp_matter_attr_val_t *val) {
+    if (!attribute || !val) return ESP_ERR_INVALID_ARG;
+    *val = attribute->val;
+    return ESP_OK;
+}
+
+esp_err_t attribute::update(uint16_t endpoint_id, uint32_t cluster_id, uint32_t attribute_id, esp_matter_attr_val_t *val) {
+    // Like esp_matter: takes the stack lock unless the caller already holds it
+    lock::status_t ls = lock::chip_stack_lock(0);
+    struct Unlock { bool on; ~Unlock() { if (on) lock::chip_stack_unlock(); } } unlock{ls == lock::SUCCESS};
+    std::lock_guard<std::recursive_mutex> g(g_lock);
+    g_stats.updates++;
+    attribute_t *a = find(endpoint_id, cluster_id, attribute_id);
+    if (!a || !val) return ESP_ERR_NOT_FOUND;
+    // Like the real data model: an unchanged value is not reported
+    if (same(a, *val)) {
+        g_stats.unchanged++;
+        return ESP_OK;
+    }
+    g_stats.changed++;
+    store(a, *val);
+    mark_dirty(a);
+    return ESP_OK;
+}
+
+esp_err_t attribute::set_val(attribute_t *attribute, esp_matter_attr_val_t *val) {
+    if (!attribute || !val) return ESP_ERR_INVALID_ARG;
+    if (attribute->val.type != val->type) return ESP_ERR_INVALID_ARG;
+    std::lock_guard<std::recursive_mutex> g(g_lock);
+    g_stats.updates++;
+    if (same(attribute, *val)) g_stats.unchanged++;
+    else g_stats.changed++;
+    store(attribute, *val);
+    return ESP_OK;
+}
+
+esp_err_t attribute::set_override_callback(attribute_t *attribute, callback_t callback) {
+    if (!attribute) return ESP_ERR_INVALID_ARG;
+    attribute->override = callback;
+    return ESP_OK;
+}
+
+// The reporting engine records the path; no data model lookup is counted
+void MatterReportingAttributeChangeCallback(chip::EndpointId endpoint, chip::ClusterId clusterId, chip::AttributeId attributeId) {
+    std::lock_guard<std::recursive_mutex> g(g_lock);
+    if (!g_node) return;
+    for (endpoint_t *e : g_node->endpoints) {
+        if (e->id != endpoint) continue;
+        for (cluster_t *c : e->clusters) {
+            if (c->id != clusterId) continue;
+            for (attribute_t *a : c->attrs) if (a->id == attributeId) mark_dirty(a);
+        }
+    }
+}
+
+command_t *command::create(cluster_t *cluster, uint32_t command_id, uint8_t flags, callback_t callback) {
+    (void)flags;
+    if (!cluster) return nullptr;
+    command_t *c = new command_s;
+    c->id = command_id;
+    c->cb = callback;
+    cluster->cmds.push_back(c);
+    return c;
+}
+
+command_t *command::get(cluster_t *cluster, uint32_t command_id) {
+    if (!cluster) return nullptr;
+    for (command_t *c : cluster->cmds) if (c->id == command_id) return c;
+    return nullptr;
+}
+
+namespace esp_matter_standin {
+
+void set_subscribers(unsigned n) { g_subscribers = n; }
+unsigned subscribers() { return g_subscribers + (unsigned)g_handlers.size(); }
+
+int subscribe(uint16_t endpoint_id, uint32_t cluster_id, uint32_t attribute_id) {
+    static int nextId = 1;
+    std::unique_ptr<chip::app::ReadHandler> h(new chip::app::ReadHandler);
+    h->path.mValue.mEndpointId = endpoint_id;
+    h->path.mValue.mClusterId = cluster_id;
+    h->path.mValue.mAttributeId = attribute_id;
+    chip::app::ReadHandler &ref = *h;
+    chip::Transport::SecureSession session;
+    // Real callbacks run on the CHIP thread with the stack lock held
+    lock::status_t st = lock::chip_stack_lock(0);
+    auto *cb = chip::app::InteractionModelEngine::GetInstance()->GetAppCallback();
+    if (cb && cb->OnSubscriptionRequested(ref, session) != CHIP_NO_ERROR) {
+        if (st == lock::SUCCESS) lock::chip_stack_unlock();
+        return 0;
+    }
+    int id = nextId++;
+    {
+        std::lock_guard<std::recursive_mutex> g(g_lock);
+        g_handlers[id] = std::move(h);
+    }
+    if (cb) cb->OnSubscriptionEstablished(ref);
+    if (st == lock::SUCCESS) lock::chip_stack_unlock();
+    return id;
+}
+
+void unsubscribe(int id) {
+    std::unique_ptr<chip::app::ReadHandler> h;
+    {
+        std::lock_guard<std::recursive_mutex> g(g_lock);
+        auto it = g_handlers.find(id);
+        if (it == g_handlers.end()) return;
+        h = std::move(it->second);
+        g_handlers.erase(it);
+    }
+    lock::status_t st = lock::chip_stack_lock(0);
+    if (auto *cb = chip::app::InteractionModelEngine::GetInstance()->GetAppCallback()) cb->OnSubscriptionTerminated(*h);
+    if (st == lock::SUCCESS) lock::chip_stack_unlock();
+}
+
+void flush_reports() {
+    std::lock_guard<std::recursive_mutex> g(g_lock);
+    if (g_dirty.empty()) return;
+    static uint8_t msg[REPORT_MTU];
+    if (subscribers()) {
+        for (attribute_t *a : g_dirty) read_through(a);
+    }
+    for (unsigned s = 0; s < subscribers(); s++) {
+        size_t used = REPORT_HEADER;
+        g_stats.reportMessages++;
+        for (attribute_t *a : g_dirty) {
+            bool str = is_string(a->val.type);
+            size_t n = str ? a->val.val.a.s : scalar_size(a->val.type);
+            size_t len = str ? n + 2 : n; // strings carry a length prefix
+            if (used + ATTR_PATH_BYTES + len > REPORT_MTU) { // chunk
+                g_stats.reportBytes += used;
+                g_stats.reportMessages++;
+                used = REPORT_HEADER;
+            }
+            memcpy(msg + used, &a->id, sizeof(a->id));
+            memcpy(msg + used + ATTR_PATH_BYTES, str ? (const void *)a->buf.data() : (const void *)&a->val.val, n);
+            used += ATTR_PATH_BYTES + len;
+            g_stats.reportedAttributes++;
+        }
+        g_stats.reportBytes += used;
+    }
+    for (attribute_t *a : g_dirty) a->dirty = false;
+    g_dirty.clear();
+}
+
+Stats stats() {
+    std::lock_guard<std::recursive_mutex> g(g_lock);
+    return g_stats;
+}
+
+void reset_stats() {
+    std::lock_guard<std::recursive_mutex> g(g_lock);
+    g_stats = Stats();
+}
+
+esp_err_t invoke(uint16_t endpoint_id, uint32_t cluster_id, uint32_t command_id,
+                 const chip::TLV::TLVReader::Field *fields, size_t count) {
+    std::lock_guard<std::recursive_mutex> g(g_lock);
+    cluster_t *c = cluster::get(endpoint::get(g_node, endpoint_id), cluster_id);
+    command_t *cmd = c ? command::get(c, command_id) : nullptr;
+    if (!cmd || !cmd->cb) return ESP_ERR_NOT_FOUND;
+    chip::app::ConcreteCommandPath path = {endpoint_id, cluster_id, command_id};
+    chip::TLV::TLVReader r;
+    r.Init(fields, count);
+    return cmd->cb(path, r, nullptr);
+}
+
+esp_err_t write(uint16_t endpoint_id, uint32_t cluster_id, uint32_t attribute_id, esp_matter_attr_val_t val) {
+    attribute::callback_t cb = g_node ? g_node->attributeCb : nullptr;
+    {
+        std::lock_guard<std::recursive_mutex> g(g_lock);
+        attribute_t *a = find(endpoint_id, cluster_id, attribute_id);
+        if (!a) return ESP_ERR_NOT_FOUND;
+        if (!(a->flags & ATTRIBUTE_FLAG_WRITABLE) || a->val.type != val.type) return ESP_ERR_INVALID_ARG;
+    }
+    if (cb) {
+        esp_err_t err = cb(attribute::PRE_UPDATE, endpoint_id, cluster_id, attribute_id, &val, nullptr);
+        if (err != ESP_OK) return err;
+    }
+    {
+        std::lock_guard<std::recursive_mutex> g(g_lock);
+        attribute_t *a = find(endpoint_id, cluster_id, attribute_id);
+        if (!same(a, val)) {
+            store(a, val);
+            mark_dirty(a);
+        }
+    }
+    if (cb) cb(attribute::POST_UPDATE, endpoint_id, cluster_id, attribute_id, &val, nullptr);
+    return ESP_OK;
+}
+
+const esp_matter_attr_val_t *value(uint16_t endpoint_id, uint32_t cluster_id, uint32_t attribute_id) {
+    std::lock_guard<std::recursive_mutex> g(g_lock);
+    cluster_t *c = cluster::get(endpoint::get(g_node, endpoint_id), cluster_id);
+    attribute_t *a = c ? attribute::get(c, attribute_id) : nullptr;
+    if (a) read_through(a);
+    return a ? &a->val : nullptr;
+}
+
+} // namespace esp_matter_standin
@@ -0,0 +1,402 @@
+// ESP-IDF / FreeRTOS stand-ins for host builds (see host_idf.h)
+#include "host_idf.h"
+#include "esp_log.h"
+#include "esp_timer.h"
+#include "esp_rom_crc.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/queue.h"
+#include "freertos/semphr.h"
+#include "freertos/task.h"
+#include "nvs.h"
+#include <atomic>
+#include <cstdarg>
+#include <cstring>
+#include <deque>
+#include <map>
+#include <mutex>
+#include <string>
+#include <vector>
+
+// ---------------- Clock ----------------
+
+static thread_local int64_t t_now_us = 0;
+
+int64_t esp_timer_get_time() { return t_now_us; }
+void host_clock_set_us(int64_t us) { t_now_us = us; }
+void host_clock_advance_us(int64_t us) { t_now_us += us; }
+
+static int64_t ticks_to_us(TickType_t t) { return (int64_t)t * portTICK_PERIOD_MS * 1000; }
+
+TickType_t xTaskGetTickCount() { return (TickType_t)(t_now_us / 1000 / portTICK_PERIOD_MS); }
+void vTaskDelay(TickType_t ticks) { t_now_us += ticks_to_us(ticks); }
+
+// ---------------- Reset / RTC memory ----------------
+
+static esp_reset_reason_t g_reset_reason = ESP_RST_POWERON;
+
+esp_reset_reason_t esp_reset_reason() { return g_reset_reason; }
+void host_set_reset_reason(esp_reset_reason_t reason) { g_reset_reason = reason; }
+
+// Linker-made bounds of the RTC_NOINIT_ATTR section; absent without such data
+extern "C" uint8_t __start_rtc_noinit[] __attribute__((weak));
+extern "C" uint8_t __stop_rtc_noinit[] __attribute__((weak));
+
+uint8_t *host_rtc_noinit(size_t *len) {
+    *len = __start_rtc_noinit ? (size_t)(__stop_rtc_noinit - __start_rtc_noinit) : 0;
+    return *len ? __start_rtc_noinit : nullptr;
+}
+
+uint32_t esp_rom_crc32_le(uint32_t crc, const uint8_t *buf, uint32_t len) {
+    crc = ~crc;
+    while (len--) {
+        crc ^= *buf++;
+        for (int k = 0; k < 8; k++) crc = (crc >> 1) ^ (0xEDB88320u & (0u - (crc & 1)));
+    }
+    return ~crc;
+}
+
+// ---------------- Log ----------------
+
+static std::atomic<bool> g_log_enabled{false};
+
+void host_log_enable(bool on) { g_log_enabled = on; }
+
+void host_log(char level, const char *tag, const char *fmt, ...) {
+    if (!g_log_enabled) return;
+    va_list ap;
+    va_start(ap, fmt);
+    fprintf(stderr, "%c (%lld) %s: ", level, (long long)(t_now_us / 1000), tag);
+    vfprintf(stderr, fmt, ap);
+    fputc('\n', stderr);
+    va_end(ap);
+}
+
+// ---------------- Tasks ----------------
+
+BaseType_t xTaskCreate(TaskFunction_t fn, const char *name, uint32_t stack, void *arg, UBaseType_t prio, TaskHandle_t *handle) {
+    (void)fn; (void)name; (void)stack; (void)arg; (void)prio;
+    if (handle) *handle = nullptr;
+    return pdPASS;
+}
+
+void vTaskDelete(TaskHandle_t task) { (void)task; }
+
+struct host_task {};
+static thread_local host_task t_task;
+
+TaskHandle_t xTaskGetCurrentTaskHandle() { return &t_task; }
+
+// ---------------- NVS ----------------
+// Handle = index into the namespace list + 1. Commit is a no-op: writes land at once.
+
+static std::mutex g_nvs_lock;
+static std::vector<std::string> g_nvs_names;
+static std::map<std::string, std::vector<uint8_t>> g_nvs; // "namespace/key"
+
+static std::string nvs_key(nvs_handle_t h, const char *key) { return g_nvs_names[h - 1] + "/" + key; }
+
+esp_err_t nvs_open(const char *name, nvs_open_mode_t mode, nvs_handle_t *out) {
+    std::lock_guard<std::mutex> g(g_nvs_lock);
+    size_t i = 0;
+    while (i < g_nvs_names.size() && g_nvs_names[i] != name) i++;
+    if (i == g_nvs_names.size()) {
+        if (mode == NVS_READONLY) return ESP_ERR_NVS_NOT_FOUND;
+        g_nvs_names.push_back(name);
+    }
+    *out = (nvs_handle_t)(i + 1);
+    return ESP_OK;
+}
+
+void nvs_close(nvs_handle_t handle) { (void)handle; }
+esp_err_t nvs_commit(nvs_handle_t handle) { (void)handle; return ESP_OK; }
+
+esp_err_t nvs_get_blob(nvs_handle_t handle, const char *key, void *value, size_t *length) {
+    std::lock_guard<std::mutex> g(g_nvs_lock);
+    auto it = g_nvs.find(nvs_key(handle, key));
+    if (it == g_nvs.end()) return ESP_ERR_NVS_NOT_FOUND;
+    if (value) {
+        if (*length < it->second.size()) return ESP_ERR_INVALID_ARG;
+        memcpy(value, it->second.data(), it->second.size());
+    }
+    *length = it->second.size();
+    return ESP_OK;
+}
+
+esp_err_t nvs_set_blob(nvs_handle_t handle, const char *key, const void *value, size_t length) {
+    std::lock_guard<std::mutex> g(g_nvs_lock);
+    const uint8_t *p = (const uint8_t *)value;
+    g_nvs[nvs_key(handle, key)].assign(p, p + length);
+    return ESP_OK;
+}
+
+esp_err_t nvs_get_u8(nvs_handle_t handle, const char *key, uint8_t *out) {
+    size_t len = 1;
+    return nvs_get_blob(handle, key, out, &len);
+}
+
+esp_err_t nvs_set_u8(nvs_handle_t handle, const char *key, uint8_t value) { return nvs_set_blob(handle, key, &value, 1); }
+
+// ---------------- Queues / mutexes ----------------
+
+struct host_queue {
+    std::mutex m;
+    size_t itemSize = 0;
+    size_t length = 0;
+    std::deque<std::vector<uint8_t>> items;
+    std::mutex lock; // mutex semaphores only
+};
+
+QueueHandle_t xQueueCreate(UBaseType_t length, UBaseType_t itemSize) {
+    host_queue *q = new host_queue;
+    q->length = length;
+    q->itemSize = itemSize;
+    return q;
+}
+
+void vQueueDelete(QueueHandle_t q) { delete q; }
+
+BaseType_t xQueueSend(QueueHandle_t q, const void *item, TickType_t wait) {
+    std::lock_guard<std::mutex> g(q->m);
+    if (q->items.size() >= q->length) {
+        if (wait != portMAX_DELAY) t_now_us += ticks_to_us(wait);
+        return pdFALSE;
+    }
+    const uint8_t *p = (const uint8_t *)item;
+    q->items.emplace_back(p, p + q->itemSize);
+    return pdTRUE;
+}
+
+BaseType_t xQueueOverwrite(QueueHandle_t q, const void *item) {
+    std::lock_guard<std::mutex> g(q->m);
+    const uint8_t *p = (const uint8_t *)item;
+    q->items.clear();
+    q->items.emplace_back(p, p + q->itemSize);
+    return pdTRUE;
+}
+
+BaseType_t xQueueReceive(QueueHandle_t q, void *item, TickType_t wait) {
+    std::lock_guard<std::mutex> g(q->m);
+    if (q->items.empty()) {
+        if (wait != portMAX_DELAY) t_now_us += ticks_to_us(wait);
+        return pdFALSE;
+    }
+    memcpy(item, q->items.front().data(), q->itemSize);
+    q->items.pop_front();
+    return pdTRUE;
+}
+
+BaseType_t xQueueReset(QueueHandle_t q) {
+    std::lock_guard<std::mutex> g(q->m);
+    q->items.clear();
+    return pdPASS;
+}
+
+UBaseType_t uxQueueMessagesWaiting(QueueHandle_t q) {
+    std::lock_guard<std::mutex> g(q->m);
+    return (UBaseType_t)q->items.size();
+}
+
+SemaphoreHandle_t xSemaphoreCreateMutex() { return new host_queue; }
+void vSemaphoreDelete(SemaphoreHandle_t s) { delete s; }
+
+BaseType_t xSemaphoreTake(SemaphoreHandle_t s, TickType_t wait) {
+    if (wait == 0) return s->lock.try_lock() ? pdTRUE : pdFALSE;
+    s->lock.lock();
+    return pdTRUE;
+}
+
+BaseType_t xSemaphoreGive(SemaphoreHandle_t s) {
+    s->lock.unlock();
+    return pdTRUE;
+}
+
+// ---------------- UART ----------------
+
+namespace {
+
+struct Chunk {
+    int64_t avail;
+    std::vector<uint8_t> bytes;
+    size_t off;
+};
+
+struct Port {
+    std::mutex m;
+    bool installed = false;
+    bool stuck = false;
+    uint32_t baud = 115200;
+    int64_t txBusyUntil = 0;
+    std::deque<Chunk> rx;
+    host_uart_tx_hook_t hook = nullptr;
+    void *ctx = nullptr;
+};
+
+// Created on first use; never freed
+std::atomic<Port *> g_ports[HOST_UART_PORTS];
+std::mutex g_ports_lock;
+
+Port *port_of(uart_port_t p) {
+    if (p < 0 || p >= HOST_UART_PORTS) return nullptr;
+    Port *port = g_ports[p].load(std::memory_order_acquire);
+    if (port) return port;
+    std::lock_guard<std::mutex> g(g_ports_lock);
+    port = g_ports[p].load(std::memory_order_relaxed);
+    if (!port) {
+        port = new Port;
+        g_ports[p].store(port, std::memory_order_release);
+    }
+    return port;
+}
+
+} // namespace
+
+void host_uart_attach(uart_port_t port, host_uart_tx_hook_t hook, void *ctx) {
+    Port *p = port_of(port);
+    std::lock_guard<std::mutex> g(p->m);
+    p->hook = hook;
+    p->ctx = ctx;
+}
+
+void host_uart_inject(uart_port_t port, const uint8_t *data, size_t len, int64_t avail_us) {
+    Port *p = port_of(port);
+    if (!p || !len) return;
+    std::lock_guard<std::mutex> g(p->m);
+    // Keep arrival order: a chunk can't overtake bytes already on the wire
+    if (!p->rx.empty() && p->rx.back().avail > avail_us) avail_us = p->rx.back().avail;
+    p->rx.push_back({avail_us, std::vector<uint8_t>(data, data + len), 0});
+}
+
+size_t host_uart_pending(uart_port_t port) {
+    Port *p = port_of(port);
+    std::lock_guard<std::mutex> g(p->m);
+    size_t n = 0;
+    for (const Chunk &c : p->rx) n += c.bytes.size() - c.off;
+    return n;
+}
+
+uint32_t host_uart_baud(uart_port_t port) {
+    Port *p = port_of(port);
+    std::lock_guard<std::mutex> g(p->m);
+    return p->baud;
+}
+
+void host_uart_set_stuck(uart_port_t port, bool stuck) {
+    Port *p = port_of(port);
+    std::lock_guard<std::mutex> g(p->m);
+    p->stuck = stuck;
+}
+
+esp_err_t uart_param_config(uart_port_t port, const uart_config_t *cfg) {
+    Port *p = port_of(port);
+    if (!p || !cfg) return ESP_ERR_INVALID_ARG;
+    p->baud = (uint32_t)cfg->baud_rate;
+    return ESP_OK;
+}
+
+esp_err_t uart_set_pin(uart_port_t port, int tx, int rx, int rts, int cts) {
+    (void)tx; (void)rx; (void)rts; (void)cts;
+    return port_of(port) ? ESP_OK : ESP_ERR_INVALID_ARG;
+}
+
+esp_err_t uart_driver_install(uart_port_t port, int rxBuf, int txBuf, int queueSize, QueueHandle_t *queue, int flags) {
+    (void)rxBuf; (void)txBuf; (void)flags;
+    Port *p = port_of(port);
+    if (!p || p->installed) return ESP_ERR_INVALID_STATE;
+    p->installed = true;
+    // No events are posted; tools call the poll function directly
+    if (queue) *queue = queueSize ? xQueueCreate(queueSize, sizeof(uart_event_t)) : nullptr;
+    return ESP_OK;
+}
+
+esp_err_t uart_driver_delete(uart_port_t port) {
+    Port *p = port_of(port);
+    if (!p) return ESP_ERR_INVALID_ARG;
+    std::lock_guard<std::mutex> g(p->m);
+    p->installed = false;
+    p->stuck = false;
+    p->rx.clear();
+    return ESP_OK;
+}
+
+esp_err_t uart_set_baudrate(uart_port_t port, uint32_t baud) {
+    Port *p = port_of(port);
+    if (!p) return ESP_ERR_INVALID_ARG;
+    p->baud = baud;
+    return ESP_OK;
+}
+
+int uart_write_bytes(uart_port_t port, const void *src, size_t len) {
+    Port *p = port_of(port);
+    if (!p) return -1;
+    host_uart_tx_hook_t hook;
+    void *ctx;
+    {
+        std::lock_guard<std::mutex> g(p->m);
+        // 10 bits per byte on the wire
+        int64_t start = p->txBusyUntil > t_now_us ? p->txBusyUntil : t_now_us;
+        p->txBusyUntil = start + (int64_t)len * 10000000 / p->baud;
+        hook = p->hook;
+        ctx = p->ctx;
+    }
+    if (hook) hook(port, (const uint8_t *)src, len, ctx);
+    return (int)len;
+}
+
+esp_err_t uart_wait_tx_done(uart_port_t port, TickType_t wait) {
+    Port *p = port_of(port);
+    if (!p) return ESP_ERR_INVALID_ARG;
+    std::lock_guard<std::mutex> g(p->m);
+    int64_t limit = t_now_us + ticks_to_us(wait);
+    if (p->txBusyUntil <= t_now_us) return ESP_OK;
+    if (p->txBusyUntil > limit) { t_now_us = limit; return ESP_ERR_TIMEOUT; }
+    t_now_us = p->txBusyUntil;
+    return ESP_OK;
+}
+
+int uart_read_bytes(uart_port_t port, void *buf, uint32_t len, TickType_t wait) {
+    Port *p = port_of(port);
+    if (!p) return -1;
+    std::lock_guard<std::mutex> g(p->m);
+    uint8_t *out = (uint8_t *)buf;
+    int64_t deadline = wait == portMAX_DELAY ? INT64_MAX : t_now_us + ticks_to_us(wait);
+    uint32_t got = 0;
+    while (got < len) {
+        if (p->rx.empty() || p->stuck) {
+            if (deadline != INT64_MAX) t_now_us = deadline;
+            break;
+        }
+        Chunk &c = p->rx.front();
+        if (c.avail > t_now_us) {
+            if (c.avail > deadline) { t_now_us = deadline; break; }
+            t_now_us = c.avail; // block until the bytes arrive
+        }
+        size_t n = c.bytes.size() - c.off;
+        if (n > len - got) n = len - got;
+        memcpy(out + got, c.bytes.data() + c.off, n);
+        c.off += n;
+        got += (uint32_t)n;
+        if (c.off == c.bytes.size()) p->rx.pop_front();
+    }
+    return (int)got;
+}
+
+esp_err_t uart_flush_input(uart_port_t port) {
+    Port *p = port_of(port);
+    if (!p) return ESP_ERR_INVALID_ARG;
+    std::lock_guard<std::mutex> g(p->m);
+    // Only bytes that already arrived are dropped
+    while (!p->rx.empty() && p->rx.front().avail <= t_now_us) p->rx.pop_front();
+    return ESP_OK;
+}
+
+esp_err_t uart_get_buffered_data_len(uart_port_t port, size_t *size) {
+    Port *p = port_of(port);
+    if (!p || !size) return ESP_ERR_INVALID_ARG;
+    std::lock_guard<std::mutex> g(p->m);
+    size_t n = 0;
+    if (!p->stuck) {
+        for (const Chunk &c : p->rx) if (c.avail <= t_now_us) n += c.bytes.size() - c.off;
+    }
+    *size = n;
+    return ESP_OK;
+}
@@ -0,0 +1,210 @@
+#include "ld2410_sim.h"
+#include "host_idf.h"
+#include "esp_timer.h"
+#include <cmath>
+#include <cstring>
+
+static const uint8_t HEAD_CFG[4] = {0xFD, 0xFC, 0xFB, 0xFA};
+static const uint8_t TAIL_CFG[4] = {0x04, 0x03, 0x02, 0x01};
+static const uint8_t HEAD_DATA[4] = {0xF4, 0xF3, 0xF2, 0xF1};
+static const uint8_t TAIL_DATA[4] = {0xF8, 0xF7, 0xF6, 0xF5};
+
+LD2410Sim::LD2410Sim(uart_port_t p) : port(p) {
+    host_uart_attach(port, onTx, this);
+}
+
+LD2410Sim::~LD2410Sim() {
+    host_uart_attach(port, nullptr, nullptr);
+}
+
+bool LD2410Sim::linkOk() const {
+    return host_uart_baud(port) == baud;
+}
+
+void LD2410Sim::onTx(uart_port_t port, const uint8_t *data, size_t len, void *ctx) {
+    (void)port;
+    LD2410Sim *s = (LD2410Sim *)ctx;
+    if (!s->linkOk()) return; // framing errors on the sensor side
+    s->rx.insert(s->rx.end(), data, data + len);
+    s->parse();
+}
+
+void LD2410Sim::parse() {
+    for (;;) {
+        size_t i = 0;
+        while (i + 4 <= rx.size() && memcmp(&rx[i], HEAD_CFG, 4) != 0) i++;
+        if (i) rx.erase(rx.begin(), rx.begin() + i);
+        if (rx.size() < 6) return;
+        size_t len = rx[4] | (rx[5] << 8);
+        if (rx.size() < 6 + len + 4) return;
+        if (memcmp(&rx[6 + len], TAIL_CFG, 4) == 0) handle(&rx[6], len);
+        rx.erase(rx.begin(), rx.begin() + 6 + len + 4);
+    }
+}
+
+void LD2410Sim::ack(uint16_t cmd, const uint8_t *extra, size_t n, uint16_t status) {
+    if (ackLoss > 0 && std::uniform_real_distribution<double>(0, 1)(rng) < ackLoss) {
+        dropped++;
+        return;
+    }
+    uint8_t f[64];
+    size_t len = 4 + n;
+    memcpy(f, HEAD_CFG, 4);
+    f[4] = len & 0xFF; f[5] = len >> 8;
+    uint16_t id = cmd | 0x100;
+    f[6] = id & 0xFF; f[7] = id >> 8;
+    f[8] = status & 0xFF; f[9] = status >> 8;
+    if (n) memcpy(f + 10, extra, n);
+    memcpy(f + 10 + n, TAIL_CFG, 4);
+    host_uart_inject(port, f, 14 + n, esp_timer_get_time() + ackLatencyUs);
+}
+
+void LD2410Sim::handle(const uint8_t *p, size_t len) {
+    if (silent || len < 2) return;
+    cmdCount++;
+    uint16_t cmd = p[0] | (p[1] << 8);
+    if (!config && cmd != 0xFF) return; // the sensor ignores commands outside config mode
+    switch (cmd) {
+        case 0xFF: { // enable config: protocol version 1, buffer 64
+            config = true;
+            const uint8_t r[] = {0x01, 0x00, 0x40, 0x00};
+            ack(cmd, r, sizeof(r));
+            break;
+        }
+        case 0xFE: config = false; ack(cmd, nullptr, 0); break;
+        case 0xA0: { // firmware: type, minor, major, build (LE)
+            const uint8_t r[] = {0x00, 0x00, fwMinor, fwMajor, 0x22, 0x10, 0x23, 0x20};
+            ack(cmd, r, sizeof(r));
+            break;
+        }
+        case 0xA5: {
+            const uint8_t r[] = {0x8F, 0x27, 0x2E, 0xB8, 0x0F, 0x65};
+            ack(cmd, r, sizeof(r));
+            break;
+        }
+        case 0xAB: {
+            const uint8_t r[] = {(uint8_t)fineRes, 0x00};
+            ack(cmd, r, sizeof(r));
+            break;
+        }
+        case 0xAA: fineRes = len > 2 && p[2]; ack(cmd, nullptr, 0); break;
+        case 0x61: {
+            uint8_t r[24];
+            r[0] = 0xAA;
+            r[1] = 8; // max gate
+            r[2] = maxMoving;
+            r[3] = maxStationary;
+            memcpy(r + 4, mThr, 9);
+            memcpy(r + 13, sThr, 9);
+            r[22] = noOne & 0xFF; r[23] = noOne >> 8;
+            ack(cmd, r, sizeof(r));
+            break;
+        }
+        case 0x64: { // gate word, moving word, stationary word (each id16 + value32)
+            if (len < 20) { ack(cmd, nullptr, 0, 1); break; }
+            uint16_t gate = p[4] | (p[5] << 8);
+            for (uint8_t g = 0; g < 9; g++) {
+                if (gate == 0xFFFF || gate == g) { mThr[g] = p[10]; sThr[g] = p[16]; }
+            }
+            ack(cmd, nullptr, 0);
+            break;
+        }
+        case 0x60:
+            if (len < 20) { ack(cmd, nullptr, 0, 1); break; }
+            maxMoving = p[4] > 8 ? 8 : p[4];
+            maxStationary = p[10] > 8 ? 8 : p[10];
+            noOne = p[16] | (p[17] << 8);
+            ack(cmd, nullptr, 0);
+            break;
+        case 0x62: eng = true; ack(cmd, nullptr, 0); break;
+        case 0x63: eng = false; ack(cmd, nullptr, 0); break;
+        case 0xA2: // factory reset
+            fineRes = false; maxMoving = 8; maxStationary = 8; noOne = 5;
+            ack(cmd, nullptr, 0);
+            break;
+        case 0xA3: // reboot: drops config and engineering mode, applies a new baud rate
+            ack(cmd, nullptr, 0);
+            config = false; eng = false; wedged = false;
+            if (pendingBaud) { baud = pendingBaud; pendingBaud = 0; }
+            break;
+        case 0xA1: {
+            static const uint32_t rates[8] = {9600, 19200, 38400, 57600, 115200, 230400, 256000, 460800};
+            if (len < 4 || p[2] < 1 || p[2] > 8) { ack(cmd, nullptr, 0, 1); break; }
+            pendingBaud = rates[p[2] - 1];
+            ack(cmd, nullptr, 0);
+            break;
+        }
+        case 0xA4: case 0xA9: case 0x0B: ack(cmd, nullptr, 0); break;
+        case 0xAD:
+            if (len >= 5) { auxLight = p[2]; auxThreshold = p[3]; auxOut = p[4]; }
+            ack(cmd, nullptr, 0);
+            break;
+        case 0xAE: {
+            const uint8_t r[] = {auxLight, auxThreshold, auxOut, 0x00};
+            ack(cmd, r, sizeof(r));
+            break;
+        }
+        case 0x1B: {
+            const uint8_t r[] = {0x00, 0x00};
+            ack(cmd, r, sizeof(r));
+            break;
+        }
+        default: ack(cmd, nullptr, 0, 1); break; // NAK
+    }
+}
+
+size_t LD2410Sim::encodeFrame(const Target &t, bool engineering, uint8_t maxMoving, uint8_t maxStationary, uint8_t *f) {
+    if (maxMoving > 8) maxMoving = 8;
+    if (maxStationary > 8) maxStationary = 8;
+    size_t n = 0;
+    memcpy(f, HEAD_DATA, 4);
+    n = 6; // length filled below
+    f[n++] = engineering ? 0x01 : 0x02;
+    f[n++] = 0xAA;
+    f[n++] = t.status;
+    f[n++] = t.movingCm & 0xFF; f[n++] = t.movingCm >> 8;
+    f[n++] = t.movingSignal;
+    f[n++] = t.stationaryCm & 0xFF; f[n++] = t.stationaryCm >> 8;
+    f[n++] = t.stationarySignal;
+    f[n++] = t.distanceCm & 0xFF; f[n++] = t.distanceCm >> 8;
+    if (engineering) {
+        f[n++] = maxMoving;
+        f[n++] = maxStationary;
+        for (uint8_t g = 0; g <= maxMoving; g++) f[n++] = t.movingGates[g];
+        for (uint8_t g = 0; g <= maxStationary; g++) f[n++] = t.stationaryGates[g];
+        f[n++] = t.light;
+        f[n++] = t.out;
+    }
+    f[n++] = 0x55;
+    f[n++] = 0x00;
+    size_t len = n - 6;
+    f[4] = len & 0xFF; f[5] = len >> 8;
+    memcpy(f + n, TAIL_DATA, 4);
+    return n + 4;
+}
+
+void LD2410Sim::gateEnergies(double cm, uint8_t gateCm, uint8_t peak, uint8_t *gates) {
+    for (int g = 0; g < 9; g++) {
+        // Offset from the gate center in bins; main lobe +-2 bins
+        double x = cm / gateCm - (g + 0.5);
+        double w = fabs(x) < 1e-9 ? 1.0 : fabs(x - 1) < 1e-9 || fabs(x + 1) < 1e-9 ? 0.5
+                 : sin(M_PI * x) / (M_PI * x) / (1 - x * x);
+        double db = w * w > 1e-12 ? 10 * log10(w * w) : -120;
+        double e = peak + 2 * db;
+        gates[g] = (uint8_t)(e < 0 ? 0 : e > 100 ? 100 : lround(e));
+    }
+}
+
+void LD2410Sim::emitFrame(const Target &t) {
+    if (silent || config || wedged) return;
+    if (!linkOk()) {
+        // Same airtime, wrong rate: what the firmware reads is noise
+        uint8_t junk[24];
+        for (uint8_t &b : junk) b = (uint8_t)rng();
+        host_uart_inject(port, junk, sizeof(junk), esp_timer_get_time());
+        return;
+    }
+    uint8_t f[LD2410_SIM_FRAME_MAX];
+    size_t n = encodeFrame(t, eng, maxMoving, maxStationary, f);
+    host_uart_inject(port, f, n, esp_timer_get_time());
+}
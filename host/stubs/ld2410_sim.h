@@ -0,0 +1,90 @@
+// Simulated LD2410 on a host UART port (host_idf.h).
+//
+// Answers config-mode commands the way the sensor does (ACK = cmd | 0x100,
+// status 0, command specific payload) after a configurable latency, keeps
+// the written parameters, and emits basic or engineering data frames on
+// request. ACKs can be dropped to exercise retry paths.
+#pragma once
+#include "driver/uart.h"
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#define LD2410_SIM_FRAME_MAX 64 // largest data frame (engineering, 9 + 9 gates)
+
+class LD2410Sim {
+public:
+    struct Target {
+        uint8_t status = 0;        // 0 none, 1 moving, 2 stationary, 3 both
+        uint16_t movingCm = 0;
+        uint8_t movingSignal = 0;
+        uint16_t stationaryCm = 0;
+        uint8_t stationarySignal = 0;
+        uint16_t distanceCm = 0;
+        uint8_t movingGates[9] = {0};     // engineering mode only
+        uint8_t stationaryGates[9] = {0};
+        uint8_t light = 0;
+        uint8_t out = 0;
+    };
+
+    explicit LD2410Sim(uart_port_t port);
+    ~LD2410Sim();
+
+    void setFirmware(uint8_t major, uint8_t minor) { fwMajor = major; fwMinor = minor; }
+    void setAckLatencyUs(uint32_t us) { ackLatencyUs = us; }
+    void setAckLoss(double p) { ackLoss = p; }
+    // A silent sensor neither answers nor sends frames
+    void setSilent(bool s) { silent = s; }
+    // Faults: brown-out reboot into config mode (no frames until it exits),
+    // stream stalled until a reboot, UART rate changed (the firmware's bytes
+    // are garbage to it and its frames are garbage to the firmware)
+    void bootIntoConfig() { config = true; eng = false; }
+    void setWedged(bool w) { wedged = w; }
+    void setBaud(uint32_t b) { baud = b; }
+
+    // Queue one data frame, readable from now (virtual clock)
+    void emitFrame(const Target &t);
+    // The same frame as raw UART bytes (header to tail) into out, which
+    // holds LD2410_SIM_FRAME_MAX; returns its length
+    static size_t encodeFrame(const Target &t, bool engineering, uint8_t maxMoving, uint8_t maxStationary, uint8_t *out);
+    // Gate energies of a point target cm away: the Hann-windowed range
+    // response of a gate-sized range bin, 2 energy units per dB below peak
+    static void gateEnergies(double cm, uint8_t gateCm, uint8_t peak, uint8_t *gates);
+
+    bool engineering() const { return eng; }
+    bool inConfig() const { return config; }
+    uint32_t baudRate() const { return baud; }
+    uint8_t resolutionCm() const { return fineRes ? 20 : 75; }
+    uint32_t commands() const { return cmdCount; }
+    uint32_t droppedAcks() const { return dropped; }
+    const uint8_t *movingThresholds() const { return mThr; }
+    const uint8_t *stationaryThresholds() const { return sThr; }
+
+private:
+    uart_port_t port;
+    std::vector<uint8_t> rx; // bytes written by the firmware, not yet parsed
+    std::mt19937 rng{2410};
+    uint8_t fwMajor = 2, fwMinor = 0x44;
+    uint32_t ackLatencyUs = 2000;
+    double ackLoss = 0;
+    bool silent = false;
+    bool wedged = false;
+    uint32_t baud = 256000;
+    uint32_t pendingBaud = 0; // set by 0xA1, applied on reboot
+    bool config = false;
+    bool eng = false;
+    bool fineRes = false;
+    uint8_t maxMoving = 8, maxStationary = 8;
+    uint16_t noOne = 5;
+    uint8_t mThr[9] = {50, 50, 40, 30, 20, 15, 15, 15, 15};
+    uint8_t sThr[9] = {0, 0, 40, 40, 30, 30, 20, 20, 20};
+    uint8_t auxLight = 0, auxThreshold = 0x80, auxOut = 0;
+    uint32_t cmdCount = 0;
+    uint32_t dropped = 0;
+
+    static void onTx(uart_port_t port, const uint8_t *data, size_t len, void *ctx);
+    bool linkOk() const;
+    void parse();
+    void handle(const uint8_t *payload, size_t len);
+    void ack(uint16_t cmd, const uint8_t *extra, size_t n, uint16_t status = 0);
+};
@@ -0,0 +1,177 @@
+// Collector for the raw UDP telemetry stream (main/ld2410_telemetry.h).
+//
+//   telemetry_recv [port]               listen (default 24100), one line per second
+//   telemetry_recv --loopback [frames]  stream the simulated sensor through the
+//                                       firmware to 127.0.0.1 and check the result
+//
+// Every record carries its own seq, so a missing seq is either a queue drop
+// on the device (the header's queueDropped counter moves by the same amount)
+// or a datagram lost on the network. Loopback runs two phases: the sender
+// pumped every frame (nothing may be lost) and the sender stalled for longer
+// than the ring holds (gaps must equal the queue drops).
+#include "ld2410c_wrapper.h"
+#include "ld2410_telemetry.h"
+#include "esp_matter.h"
+#include "esp_timer.h"
+#include "host_idf.h"
+#include "ld2410_sim.h"
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+
+// DiagnosticLogProvider.cpp needs the CHIP diagnostic logs server; not built here
+void ld2410c_register_diagnostic_logs(esp_matter::node_t *node) { (void)node; }
+
+struct Collector {
+    bool started = false;
+    uint32_t expected = 0;
+    uint64_t records = 0;
+    uint64_t datagrams = 0;
+    uint64_t missing = 0;    // seqs skipped
+    uint64_t late = 0;       // duplicate or reordered
+    uint64_t malformed = 0;
+    uint32_t firstDropped = 0, lastDropped = 0;
+    uint32_t engineering = 0;
+
+    static uint32_t le32(const uint8_t *p) { return p[0] | (p[1] << 8) | (p[2] << 16) | ((uint32_t)p[3] << 24); }
+
+    void onDatagram(const uint8_t *d, size_t len) {
+        if (len < LD2410_TELEMETRY_HEADER_SIZE || memcmp(d, "LDT1", 4) != 0 || d[4] != 1) { malformed++; return; }
+        uint8_t n = d[5], recSize = d[6];
+        if (recSize < LD2410_TELEMETRY_RECORD_SIZE || len < LD2410_TELEMETRY_HEADER_SIZE + (size_t)n * recSize) { malformed++; return; }
+        uint32_t dropped = le32(d + 8);
+        if (!datagrams) firstDropped = dropped;
+        lastDropped = dropped;
+        datagrams++;
+        const uint8_t *r = d + LD2410_TELEMETRY_HEADER_SIZE;
+        for (uint8_t i = 0; i < n; i++, r += recSize) {
+            uint32_t seq = le32(r);
+            if (r[9]) engineering++; // gate counts
+            if (!started) { started = true; expected = seq; }
+            int32_t delta = (int32_t)(seq - expected);
+            if (delta < 0) { late++; continue; }
+            missing += (uint32_t)delta;
+            expected = seq + 1;
+            records++;
+        }
+    }
+
+    // Drops before the first datagram are invisible to the collector too
+    uint64_t queueDrops() const { return lastDropped - firstDropped; }
+    uint64_t networkLoss() const { return missing > queueDrops() ? missing - queueDrops() : 0; }
+
+    void print(const char *label) const {
+        printf("%-10s records %8llu  datagrams %6llu  gaps %6llu  queue drops %6llu  network loss %6llu  late %llu  bad %llu  eng %u\n",
+               label, (unsigned long long)records, (unsigned long long)datagrams, (unsigned long long)missing,
+               (unsigned long long)queueDrops(), (unsigned long long)networkLoss(), (unsigned long long)late,
+               (unsigned long long)malformed, engineering);
+    }
+};
+
+static int open_socket(uint16_t port, bool loopbackOnly) {
+    int s = socket(AF_INET, SOCK_DGRAM, 0);
+    if (s < 0) { perror("socket"); return -1; }
+    sockaddr_in a = {};
+    a.sin_family = AF_INET;
+    a.sin_port = htons(port);
+    a.sin_addr.s_addr = htonl(loopbackOnly ? INADDR_LOOPBACK : INADDR_ANY);
+    if (bind(s, (sockaddr *)&a, sizeof(a)) < 0) { perror("bind"); close(s); return -1; }
+    return s;
+}
+
+static void drain(int s, Collector &c) {
+    uint8_t buf[2048];
+    ssize_t n;
+    while ((n = recv(s, buf, sizeof(buf), MSG_DONTWAIT)) > 0) c.onDatagram(buf, (size_t)n);
+}
+
+static int listen_forever(uint16_t port) {
+    int s = open_socket(port, false);
+    if (s < 0) return 1;
+    printf("listening on udp/%u\n", port);
+    Collector c;
+    uint8_t buf[2048];
+    timeval tv = {1, 0};
+    setsockopt(s, SOL_SOCKET, SO_RCVTIMEO, &tv, sizeof(tv));
+    auto next = std::chrono::steady_clock::now() + std::chrono::seconds(1);
+    for (;;) {
+        ssize_t n = recv(s, buf, sizeof(buf), 0);
+        if (n > 0) c.onDatagram(buf, (size_t)n);
+        if (std::chrono::steady_clock::now() >= next) {
+            c.print("total");
+            next += std::chrono::seconds(1);
+        }
+    }
+}
+
+static LD2410Sim::Target target(std::mt19937 &rng, uint32_t i) {
+    LD2410Sim::Target t;
+    uint16_t cm = (uint16_t)(150 + 100 * ((i / 50) % 3));
+    t.status = 3;
+    t.movingCm = t.stationaryCm = t.distanceCm = (uint16_t)(cm + rng() % 10);
+    t.movingSignal = 70;
+    t.stationarySignal = 50;
+    for (int g = 0; g < 9; g++) { t.movingGates[g] = (uint8_t)(rng() % 100); t.stationaryGates[g] = (uint8_t)(rng() % 100); }
+    return t;
+}
+
+static int loopback(unsigned frames) {
+    int s = open_socket(0, true);
+    if (s < 0) return 1;
+    sockaddr_in a = {};
+    socklen_t alen = sizeof(a);
+    getsockname(s, (sockaddr *)&a, &alen);
+    int rcvbuf = 1 << 20;
+    setsockopt(s, SOL_SOCKET, SO_RCVBUF, &rcvbuf, sizeof(rcvbuf));
+
+    LD2410Sim sim(UART_NUM_1);
+    ld2410c_init();
+    if (!ld2410c_telemetry_start("127.0.0.1", ntohs(a.sin_port))) return 1;
+    printf("sensor engineering=%d, streaming to 127.0.0.1:%u, ring %u records, batch %u\n",
+           sim.engineering(), ntohs(a.sin_port), LD2410_TELEMETRY_RING, LD2410_TELEMETRY_BATCH);
+
+    std::mt19937 rng(2410);
+    uint32_t t_ms = (uint32_t)(esp_timer_get_time() / 1000);
+    bool ok = true;
+    // Phase 1: the sender keeps up (one pass per 100 ms, like the task)
+    // Phase 2: the sender stalls for 4x the ring between passes
+    const unsigned stalls[] = {2, 4 * LD2410_TELEMETRY_RING};
+    const char *labels[] = {"keeps-up", "stalled"};
+    for (int phase = 0; phase < 2; phase++) {
+        Collector c;
+        ld2410c_telemetry_stats_t before, after;
+        ld2410c_telemetry_stats(&before);
+        for (unsigned i = 0; i < frames; i++, t_ms += 50) {
+            if (esp_timer_get_time() < (int64_t)t_ms * 1000) host_clock_set_us((int64_t)t_ms * 1000);
+            sim.emitFrame(target(rng, i));
+            ld2410c_poll();
+            if ((i + 1) % stalls[phase] == 0) { ld2410c_telemetry_pump(); drain(s, c); }
+        }
+        ld2410c_telemetry_pump();
+        usleep(10000);
+        drain(s, c);
+        ld2410c_telemetry_stats(&after);
+        c.print(labels[phase]);
+        uint32_t sentDrops = after.queue_dropped - before.queue_dropped;
+        uint32_t pushed = after.records - before.records;
+        printf("%-10s device: records %u  queue drops %u  datagrams %u  send errors %u\n", "",
+               pushed, sentDrops, after.datagrams - before.datagrams, after.send_errors - before.send_errors);
+        bool phaseOk = c.networkLoss() == 0 && c.late == 0 && c.malformed == 0 &&
+                       (phase == 0 ? c.records == pushed : c.missing > 0 && c.missing == c.queueDrops());
+        ok = ok && phaseOk;
+    }
+    close(s);
+    printf("%s\n", ok ? "PASS" : "FAIL");
+    return ok ? 0 : 1;
+}
+
+int main(int argc, char **argv) {
+    if (argc > 1 && !strcmp(argv[1], "--loopback")) return loopback(argc > 2 ? (unsigned)atoi(argv[2]) : 2000);
+    return listen_forever(argc > 1 ? (uint16_t)atoi(argv[1]) : 24100);
+}
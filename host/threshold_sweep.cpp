@@ -0,0 +1,354 @@
+// Threshold tuning sweep over recorded engineering-mode traffic.
+//
+//   threshold_sweep [--threads n] [--out front.csv]                 synthetic 1 h recording
+//   threshold_sweep [...] recording.csv labels.csv
+//       recording: lines "t_ms,moving_cm,m0..m8,s0..s8" (gate energies)
+//       labels:    lines "start_ms,end_ms", intervals someone was there
+//
+// Every candidate profile (per-gate thresholds as offsets from the factory
+// curve, max moving / stationary gate, no-one window) is replayed through
+// the occupancy decision the node makes: the sensor's rule (any gate up to
+// the max gate at or above its threshold, held for the no-one window) and
+// the firmware's walk-out early clear (LD2410Trajectory, exit zone as in
+// the wrapper). Scores against the labels:
+//   false occupied  s occupied while empty, outside the tail after a leave
+//   false clear     s clear while someone is there (2 s after arrival on)
+//   clear latency   mean s from leaving until the node reports clear; a
+//                   tail is capped at 30 s, the rest counts as false occupied
+// Candidates run on a work-stealing pool; the output is the Pareto front
+// over the three scores. The knee of the front is pushed to the simulated
+// sensor with setGateParameters() (thresholds, max gates and window in one
+// config session) and read back.
+#include "ld2410_driver.h"
+#include "ld2410_profiles.h"
+#include "ld2410_sim.h"
+#include "ld2410_trajectory.h"
+#include "host_idf.h"
+#include "work_pool.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <vector>
+
+struct Frame {
+    uint32_t t;
+    uint16_t movingCm;
+    uint8_t m[9];
+    uint8_t s[9];
+    bool truth;
+};
+
+struct Score {
+    float falseOccupiedS = 0;
+    float falseClearS = 0;
+    float latencyS = 0;      // mean clear latency
+    uint32_t falseClears = 0; // episodes
+    uint32_t leaves = 0;
+};
+
+static const LD2410Profile FACTORY = {"home", {50, 50, 40, 30, 20, 15, 15, 15, 15}, {0, 0, 40, 40, 30, 30, 20, 20, 20}, 8, 8, 5};
+static const uint32_t ARRIVAL_GRACE_MS = 2000;
+static const uint32_t LATENCY_CAP_MS = 30000; // still occupied after this: false occupied
+
+// Synthetic recording: people come in through the door (~375 cm), sit,
+// fidget and leave again, by that door or by the hallway behind the sensor
+// (no exit zone there: only the no-one window clears). A fan at 5..6 m runs
+// through some empty periods and the near gates pick up noise.
+static std::vector<Frame> synthesize(uint32_t seconds, uint32_t seed) {
+    std::mt19937 rng(seed);
+    std::uniform_int_distribution<int> pct(0, 99), quiet(0, 12), nearNoise(0, 42), fan(14, 30);
+    std::normal_distribution<float> rangeNoise(0, 8);
+    std::vector<Frame> out;
+    uint32_t t = 0;
+    while (t < seconds * 1000) {
+        // Empty period, fan on or off
+        uint32_t emptyMs = (30 + rng() % 210) * 1000;
+        bool fanOn = pct(rng) < 50;
+        for (uint32_t end = t + emptyMs; t < end; t += 100) {
+            Frame f = {t, 0, {}, {}, false};
+            for (int g = 0; g < 9; g++) { f.m[g] = (uint8_t)quiet(rng); f.s[g] = (uint8_t)quiet(rng); }
+            f.m[0] = f.s[0] = (uint8_t)nearNoise(rng);
+            f.m[1] = (uint8_t)nearNoise(rng);
+            if (fanOn) { f.m[7] = (uint8_t)fan(rng); f.s[7] = (uint8_t)(fan(rng) - 4); }
+            out.push_back(f);
+        }
+        // Occupied: walk in, sit (awake or dozing), walk out
+        float seat = 100 + rng() % 200, door = 375;
+        bool dozing = pct(rng) < 35;
+        float exitCm = pct(rng) < 60 ? door + 60 : 0;
+        uint32_t sitMs = (60 + rng() % 540) * 1000, walkMs = 2500;
+        uint32_t start = t, total = walkMs + sitMs + walkMs;
+        for (; t < start + total; t += 100) {
+            uint32_t k = t - start;
+            float pos;
+            bool walking = k < walkMs || k >= walkMs + sitMs;
+            if (k < walkMs) pos = door + (seat - door) * k / walkMs;
+            else if (!walking) pos = seat;
+            else pos = seat + (exitCm - seat) * (k - walkMs - sitMs) / walkMs;
+            Frame f = {t, 0, {}, {}, true};
+            for (int g = 0; g < 9; g++) { f.m[g] = (uint8_t)quiet(rng); f.s[g] = (uint8_t)quiet(rng); }
+            f.m[0] = f.s[0] = (uint8_t)nearNoise(rng);
+            f.m[1] = (uint8_t)nearNoise(rng);
+            int g = std::min(8, std::max(0, (int)(pos / 75)));
+            uint8_t me, se;
+            if (walking) { me = (uint8_t)(60 + rng() % 35); se = (uint8_t)(25 + rng() % 20); }
+            else if (pct(rng) < 4) { me = (uint8_t)(25 + rng() % 45); se = (uint8_t)(40 + rng() % 30); } // fidget
+            else { me = (uint8_t)quiet(rng); se = (uint8_t)(dozing ? 18 + rng() % 22 : 35 + rng() % 35); }
+            f.m[g] = std::max(f.m[g], me);
+            f.s[g] = std::max(f.s[g], se);
+            if (g < 8) f.s[g + 1] = std::max(f.s[g + 1], (uint8_t)(se / 2));
+            f.movingCm = (uint16_t)std::max(1.0f, pos + rangeNoise(rng));
+            out.push_back(f);
+        }
+    }
+    return out;
+}
+
+static std::vector<Frame> load(const char *recPath, const char *labelPath) {
+    std::vector<std::pair<uint32_t, uint32_t>> labels;
+    FILE *fp = fopen(labelPath, "r");
+    if (!fp) { perror(labelPath); exit(1); }
+    char line[256];
+    unsigned a, b;
+    while (fgets(line, sizeof(line), fp)) {
+        if (sscanf(line, "%u,%u", &a, &b) == 2) labels.push_back({a, b});
+    }
+    fclose(fp);
+    std::vector<Frame> out;
+    fp = fopen(recPath, "r");
+    if (!fp) { perror(recPath); exit(1); }
+    while (fgets(line, sizeof(line), fp)) {
+        unsigned v[20];
+        if (sscanf(line, "%u,%u,%u,%u,%u,%u,%u,%u,%u,%u,%u,%u,%u,%u,%u,%u,%u,%u,%u,%u",
+                   &v[0], &v[1], &v[2], &v[3], &v[4], &v[5], &v[6], &v[7], &v[8], &v[9], &v[10],
+                   &v[11], &v[12], &v[13], &v[14], &v[15], &v[16], &v[17], &v[18], &v[19]) != 20) continue;
+        Frame f = {v[0], (uint16_t)v[1], {}, {}, false};
+        for (int g = 0; g < 9; g++) { f.m[g] = (uint8_t)v[2 + g]; f.s[g] = (uint8_t)v[11 + g]; }
+        for (const auto &l : labels) f.truth |= f.t >= l.first && f.t < l.second;
+        out.push_back(f);
+    }
+    fclose(fp);
+    return out;
+}
+
+static Score evaluate(const LD2410Profile &p, const std::vector<Frame> &frames, const LD2410Trajectory::Params &exit) {
+    LD2410Trajectory traj(exit);
+    traj.setThresholds(p.moving, p.maxMovingGate, p.stationary, p.maxStationaryGate);
+    Score sc;
+    uint32_t lastHit = 0, hold = p.noOneWindow * 1000u;
+    bool everHit = false, wasPresent = false, wasTruth = false, inTail = false;
+    uint8_t heldStatus = 0;
+    uint32_t prevT = frames.empty() ? 0 : frames[0].t, arrival = 0, left = 0;
+    double latency = 0;
+    for (const Frame &f : frames) {
+        bool mHit = false, sHit = false;
+        uint8_t mSig = 0, sSig = 0;
+        for (uint8_t g = 0; g <= p.maxMovingGate; g++) {
+            if (p.moving[g] && f.m[g] >= p.moving[g]) { mHit = true; mSig = std::max(mSig, f.m[g]); }
+        }
+        for (uint8_t g = 0; g <= p.maxStationaryGate; g++) {
+            if (p.stationary[g] && f.s[g] >= p.stationary[g]) { sHit = true; sSig = std::max(sSig, f.s[g]); }
+        }
+        uint8_t status = (mHit ? 1 : 0) | (sHit ? 2 : 0);
+        if (status) { lastHit = f.t; everHit = true; heldStatus = status; }
+        else if (everHit && f.t - lastHit < hold) status = heldStatus;
+        traj.update(f.t, status, mHit ? f.movingCm : 0, mSig, sSig, f.m, p.maxMovingGate, f.s, p.maxStationaryGate);
+        bool present = status && !traj.earlyClear();
+
+        float dt = std::min(f.t - prevT, 1000u) / 1000.0f;
+        prevT = f.t;
+        if (f.truth && !wasTruth) { arrival = f.t; if (inTail) { latency += (f.t - left) / 1000.0; inTail = false; } }
+        if (!f.truth && wasTruth) { left = f.t; sc.leaves++; inTail = present; }
+        if (inTail && (!present || f.t - left >= LATENCY_CAP_MS)) { latency += (f.t - left) / 1000.0; inTail = false; }
+        if (f.truth) {
+            if (!present && f.t - arrival >= ARRIVAL_GRACE_MS) sc.falseClearS += dt;
+            if (!present && wasPresent && wasTruth) sc.falseClears++;
+        } else if (present && !inTail) {
+            sc.falseOccupiedS += dt;
+        }
+        wasPresent = present;
+        wasTruth = f.truth;
+    }
+    if (inTail) latency += (prevT - left) / 1000.0;
+    sc.latencyS = sc.leaves ? (float)(latency / sc.leaves) : 0;
+    return sc;
+}
+
+static bool dominates(const Score &a, const Score &b) {
+    return a.falseOccupiedS <= b.falseOccupiedS && a.falseClearS <= b.falseClearS && a.latencyS <= b.latencyS &&
+           (a.falseOccupiedS < b.falseOccupiedS || a.falseClearS < b.falseClearS || a.latencyS < b.latencyS);
+}
+
+// How far a candidate is from the factory setup; breaks ties on the front
+static int distance(const LD2410Profile &p) {
+    return abs(p.moving[8] - FACTORY.moving[8]) + abs(p.stationary[8] - FACTORY.stationary[8]) +
+           5 * (16 - p.maxMovingGate - p.maxStationaryGate) + abs(p.noOneWindow - FACTORY.noOneWindow);
+}
+
+static std::vector<LD2410Profile> candidates() {
+    static const int offsets[] = {-20, -15, -10, -5, 0, 5, 10, 15, 20};
+    static const uint8_t maxMoving[] = {6, 7, 8}, maxStationary[] = {5, 6, 7, 8};
+    static const uint8_t windows[] = {1, 2, 3, 5, 8, 12, 20};
+    std::vector<LD2410Profile> out;
+    for (int mo : offsets) for (int so : offsets) for (uint8_t mg : maxMoving) for (uint8_t sg : maxStationary) for (uint8_t w : windows) {
+        LD2410Profile p = FACTORY;
+        snprintf(p.name, sizeof(p.name), "m%+d s%+d", mo, so);
+        for (int g = 0; g < 9; g++) {
+            p.moving[g] = (uint8_t)std::min(100, std::max(5, FACTORY.moving[g] + mo));
+            // gates the factory leaves at 0 stay off
+            p.stationary[g] = FACTORY.stationary[g] ? (uint8_t)std::min(100, std::max(5, FACTORY.stationary[g] + so)) : 0;
+        }
+        p.maxMovingGate = mg;
+        p.maxStationaryGate = sg;
+        p.noOneWindow = w;
+        out.push_back(p);
+    }
+    return out;
+}
+
+static void print_profile(const char *tag, const LD2410Profile &p, const Score &s) {
+    printf("%-6s %-10s gates %u/%u window %2us  %8.1f %8.1f %3u %7.2f\n", tag, p.name, p.maxMovingGate, p.maxStationaryGate,
+           p.noOneWindow, s.falseOccupiedS, s.falseClearS, s.falseClears, s.latencyS);
+}
+
+static void print_initializer(const LD2410Profile &p) {
+    printf("    { \"%s\", {", p.name);
+    for (int g = 0; g < 9; g++) printf("%u%s", p.moving[g], g < 8 ? ", " : "");
+    printf("}, {");
+    for (int g = 0; g < 9; g++) printf("%u%s", p.stationary[g], g < 8 ? ", " : "");
+    printf("}, %u, %u, %u },\n", p.maxMovingGate, p.maxStationaryGate, p.noOneWindow);
+}
+
+// setGateParameters(array) writes all nine gates and the max gate frame
+// (setMaxGate) in one config session; the simulated sensor must hold them
+static bool push(const LD2410Profile &p) {
+    LD2410Sim sim(UART_NUM_1);
+    uart_driver_install(UART_NUM_1, 256, 0, 0, nullptr, 0);
+    uart_set_baudrate(UART_NUM_1, LD2410_BAUD_RATE);
+    LD2410Driver drv(UART_NUM_1);
+    LD2410Driver::ValuesArray mv, st;
+    memcpy(mv.values, p.moving, 9);
+    memcpy(st.values, p.stationary, 9);
+    mv.setN(p.maxMovingGate);
+    st.setN(p.maxStationaryGate);
+    uint32_t c0 = sim.commands();
+    bool ok = drv.setGateParameters(mv, st, p.noOneWindow);
+    bool held = memcmp(sim.movingThresholds(), p.moving, 9) == 0 && memcmp(sim.stationaryThresholds(), p.stationary, 9) == 0 &&
+                drv.getMovingThresholds().N == p.maxMovingGate && drv.getStationaryThresholds().N == p.maxStationaryGate &&
+                drv.getNoOneWindow() == p.noOneWindow;
+    printf("pushed \"%s\": setGateParameters %s, %u commands, sensor holds it: %s\n", p.name, ok ? "ok" : "FAILED",
+           sim.commands() - c0, held ? "yes" : "NO");
+    uart_driver_delete(UART_NUM_1);
+    return ok && held;
+}
+
+static double seconds_since(std::chrono::steady_clock::time_point t0) {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+}
+
+int main(int argc, char **argv) {
+    unsigned threads = 0;
+    const char *outPath = nullptr;
+    std::vector<const char *> files;
+    for (int i = 1; i < argc; i++) {
+        if (!strcmp(argv[i], "--threads") && i + 1 < argc) threads = (unsigned)atoi(argv[++i]);
+        else if (!strcmp(argv[i], "--out") && i + 1 < argc) outPath = argv[++i];
+        else files.push_back(argv[i]);
+    }
+    std::vector<Frame> frames = files.size() >= 2 ? load(files[0], files[1]) : synthesize(3600, 2410);
+    LD2410Trajectory::Params exit;
+    exit.exitStartCm = 300; // the wrapper's default exit zone
+    exit.exitEndCm = 450;
+
+    std::vector<LD2410Profile> cands = candidates();
+    std::vector<Score> scores(cands.size());
+    printf("%zu frames (%.1f h), %zu candidate profiles\n", frames.size(), frames.empty() ? 0.0 : (frames.back().t - frames.front().t) / 3.6e6, cands.size());
+
+    WorkPool pool(threads);
+    auto t0 = std::chrono::steady_clock::now();
+    pool.parallelFor(cands.size(), 16, [&](size_t b, size_t e) {
+        for (size_t i = b; i < e; i++) scores[i] = evaluate(cands[i], frames, exit);
+    });
+    double parS = seconds_since(t0);
+    printf("sweep: %u threads %.2f s, %llu steals, %.1f M frame-evaluations/s\n", pool.threads(), parS,
+           (unsigned long long)pool.steals(), cands.size() * frames.size() / parS / 1e6);
+    // With more than one worker, the same sweep on one is the reference for speed and results
+    bool same = true;
+    if (pool.threads() > 1) {
+        std::vector<Score> serial(cands.size());
+        WorkPool one(1);
+        t0 = std::chrono::steady_clock::now();
+        one.parallelFor(cands.size(), 16, [&](size_t b, size_t e) {
+            for (size_t i = b; i < e; i++) serial[i] = evaluate(cands[i], frames, exit);
+        });
+        double serialS = seconds_since(t0);
+        for (size_t i = 0; i < cands.size(); i++) same &= memcmp(&scores[i], &serial[i], sizeof(Score)) == 0;
+        printf("       1 thread %.2f s: x%.1f, results %s\n", serialS, serialS / parS, same ? "identical" : "DIFFER");
+    }
+
+    // Pareto front: no other candidate at least as good on all three scores.
+    // Of candidates with the same scores only the one closest to factory stays.
+    std::vector<size_t> front;
+    for (size_t i = 0; i < cands.size(); i++) {
+        bool dominated = false;
+        for (size_t j = 0; j < cands.size() && !dominated; j++) {
+            const Score &a = scores[j], &b = scores[i];
+            bool tie = j != i && a.falseOccupiedS == b.falseOccupiedS && a.falseClearS == b.falseClearS && a.latencyS == b.latencyS;
+            dominated = dominates(a, b) || (tie && (distance(cands[j]) < distance(cands[i]) || (distance(cands[j]) == distance(cands[i]) && j < i)));
+        }
+        if (!dominated) front.push_back(i);
+    }
+    // Listed by total wrong time, then latency
+    std::sort(front.begin(), front.end(), [&](size_t a, size_t b) {
+        float ea = scores[a].falseOccupiedS + scores[a].falseClearS, eb = scores[b].falseOccupiedS + scores[b].falseClearS;
+        if (ea != eb) return ea < eb;
+        return scores[a].latencyS < scores[b].latencyS;
+    });
+    // Knee: smallest sum of the scores normalized to the front's range
+    float lo[3] = {1e9f, 1e9f, 1e9f}, hi[3] = {0, 0, 0};
+    for (size_t i : front) {
+        const float v[3] = {scores[i].falseOccupiedS, scores[i].falseClearS, scores[i].latencyS};
+        for (int k = 0; k < 3; k++) { lo[k] = std::min(lo[k], v[k]); hi[k] = std::max(hi[k], v[k]); }
+    }
+    size_t knee = front.empty() ? 0 : front[0];
+    float best = 1e9f;
+    for (size_t i : front) {
+        const float v[3] = {scores[i].falseOccupiedS, scores[i].falseClearS, scores[i].latencyS};
+        float sum = 0;
+        for (int k = 0; k < 3; k++) sum += hi[k] > lo[k] ? (v[k] - lo[k]) / (hi[k] - lo[k]) : 0;
+        if (sum < best) { best = sum; knee = i; }
+    }
+
+    printf("\n%-6s %-10s %-23s %8s %8s %3s %7s\n", "", "profile", "", "falseOcc", "falseClr", "#", "latency");
+    Score factory = evaluate(FACTORY, frames, exit);
+    print_profile("now", FACTORY, factory);
+    printf("Pareto front: %zu of %zu profiles\n", front.size(), cands.size());
+    for (size_t k = 0; k < front.size() && k < 15; k++) print_profile(front[k] == knee ? "knee" : "", cands[front[k]], scores[front[k]]);
+    if (front.size() > 15) printf("  ... %zu more%s\n", front.size() - 15, outPath ? "" : " (--out writes them all)");
+
+    if (outPath) {
+        FILE *fp = fopen(outPath, "w");
+        if (!fp) { perror(outPath); return 1; }
+        fprintf(fp, "name,m0,m1,m2,m3,m4,m5,m6,m7,m8,s0,s1,s2,s3,s4,s5,s6,s7,s8,max_moving,max_stationary,window_s,false_occupied_s,false_clear_s,false_clears,latency_s\n");
+        for (size_t i : front) {
+            const LD2410Profile &p = cands[i];
+            fprintf(fp, "%s", p.name);
+            for (int g = 0; g < 9; g++) fprintf(fp, ",%u", p.moving[g]);
+            for (int g = 0; g < 9; g++) fprintf(fp, ",%u", p.stationary[g]);
+            fprintf(fp, ",%u,%u,%u,%.1f,%.1f,%u,%.2f\n", p.maxMovingGate, p.maxStationaryGate, p.noOneWindow,
+                    scores[i].falseOccupiedS, scores[i].falseClearS, scores[i].falseClears, scores[i].latencyS);
+        }
+        fclose(fp);
+        printf("front written to %s\n", outPath);
+    }
+
+    printf("\nknee as a profile slot (ld2410_default_profiles):\n");
+    print_initializer(cands[knee]);
+    bool ok = same && !front.empty() && push(cands[knee]);
+    printf("%s\n", ok ? "PASS" : "FAIL");
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,97 @@
+// Replays a distance stream through LD2410Tracker and compares it with the
+// raw stream the firmware used to publish.
+//
+//   tracker_replay                 built-in synthetic walk with known truth
+//   tracker_replay trace.csv       lines "t_ms,distance_cm[,truth_cm]"
+//                                  (distance 0 = no target)
+//
+// Reports are counted the way the wrapper publishes: the value is sampled
+// every 250 ms and a report is generated whenever it changed.
+#include "ld2410_tracker.h"
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+struct Frame {
+    uint32_t t;
+    uint16_t cm;     // 0 = no target
+    int truth;       // -1 = unknown
+};
+
+static std::vector<Frame> synthetic() {
+    // stand at 200 cm, walk out to 350 cm, stand, walk in to 120 cm, stand
+    struct Leg { uint32_t ms; float from, to; };
+    const Leg legs[] = {{10000, 200, 200}, {6000, 200, 350}, {10000, 350, 350}, {6000, 350, 120}, {10000, 120, 120}};
+    std::mt19937 rng(2410);
+    std::uniform_int_distribution<int> noise(-8, 8), jitter(-10, 10), outlierOff(-150, 150);
+    std::uniform_real_distribution<float> u(0, 1);
+    std::vector<Frame> out;
+    uint32_t t = 0, legStart = 0;
+    for (const Leg &l : legs) {
+        for (; t < legStart + l.ms; t += 100) {
+            float f = (float)(t - legStart) / l.ms;
+            int truth = (int)lroundf(l.from + (l.to - l.from) * f);
+            int m = truth + noise(rng);
+            if (u(rng) < 0.02f) m += outlierOff(rng); // multipath / ghost
+            if (m < 1) m = 1;
+            out.push_back({t + (uint32_t)(jitter(rng) + 10), (uint16_t)m, truth});
+        }
+        legStart += l.ms;
+    }
+    return out;
+}
+
+static std::vector<Frame> load(const char *path) {
+    std::vector<Frame> out;
+    FILE *f = fopen(path, "r");
+    if (!f) { perror(path); exit(1); }
+    char line[128];
+    while (fgets(line, sizeof(line), f)) {
+        unsigned t, cm; int truth = -1;
+        int n = sscanf(line, "%u,%u,%d", &t, &cm, &truth);
+        if (n >= 2) out.push_back({t, (uint16_t)cm, n == 3 ? truth : -1});
+    }
+    fclose(f);
+    return out;
+}
+
+int main(int argc, char **argv) {
+    std::vector<Frame> frames = argc > 1 ? load(argv[1]) : synthetic();
+    if (frames.empty()) { fprintf(stderr, "no frames\n"); return 1; }
+
+    LD2410Tracker tracker;
+    uint32_t nextPublish = 0;
+    int lastRaw = -1, lastTracked = -1, lastVel = 0x7FFF;
+    unsigned rawReports = 0, trackedReports = 0, velReports = 0, publishes = 0;
+    double rawSq = 0, filtSq = 0, repSq = 0;
+    unsigned scored = 0;
+
+    for (const Frame &f : frames) {
+        tracker.update(f.t, f.cm, f.cm != 0);
+        if (f.truth >= 0 && tracker.tracking()) {
+            double er = (double)f.cm - f.truth, ef = (double)tracker.distanceCm() - f.truth, ep = (double)tracker.reportedCm() - f.truth;
+            rawSq += er * er; filtSq += ef * ef; repSq += ep * ep;
+            scored++;
+        }
+        if (f.t >= nextPublish) {
+            nextPublish = f.t + 250;
+            publishes++;
+            if (f.cm != lastRaw) { rawReports++; lastRaw = f.cm; }
+            if (tracker.reportedCm() != lastTracked) { trackedReports++; lastTracked = tracker.reportedCm(); }
+            if (tracker.reportedVelocity() != lastVel) { velReports++; lastVel = tracker.reportedVelocity(); }
+        }
+    }
+
+    printf("frames            %zu (%u publish slots)\n", frames.size(), publishes);
+    printf("distance reports  raw %u  tracked %u  (%.1f%% fewer)\n", rawReports, trackedReports,
+           rawReports ? 100.0 * (rawReports - (double)trackedReports) / rawReports : 0.0);
+    printf("velocity reports  %u\n", velReports);
+    printf("outliers rejected %u\n", tracker.rejected());
+    if (scored) {
+        printf("RMS error vs truth  raw %.2f cm  filtered %.2f cm  reported %.2f cm\n",
+               sqrt(rawSq / scored), sqrt(filtSq / scored), sqrt(repSq / scored));
+    }
+    return 0;
+}
@@ -0,0 +1,214 @@
+// Replays LD2410 frames through LD2410Trajectory and compares when
+// occupancy clears with and without the early clear.
+//
+//   trajectory_replay              built-in scenarios (simulated engineering frames)
+//   trajectory_replay trace.csv    lines "t_ms,status,moving_cm,moving_signal,
+//                                  stationary_cm,stationary_signal[,truth]"
+//                                  (basic-mode capture; truth 1 = someone there)
+//
+// The sensor model holds its status for the no-one window (5 s) after the
+// last gate above threshold, like the LD2410 does; that hold is what the
+// early clear cuts. Clear latency runs from the moment the room is really
+// empty; a false clear is an early clear while someone is still there.
+#include "ld2410_trajectory.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+struct Frame {
+    uint32_t t;
+    uint8_t status;
+    uint16_t movingCm;
+    uint8_t movingSignal;
+    uint16_t stationaryCm;
+    uint8_t stationarySignal;
+    uint8_t mGates[9];
+    uint8_t sGates[9];
+    bool gates;  // engineering frame
+    int truth;   // 1 occupied, 0 empty, -1 unknown
+};
+
+// Home profile thresholds (the firmware's default slot 0)
+static const uint8_t M_THR[9] = {50, 50, 40, 30, 20, 15, 15, 15, 15};
+static const uint8_t S_THR[9] = {0, 0, 40, 40, 30, 30, 20, 20, 20};
+static const uint16_t GATE_CM = 75;
+static const uint32_t NO_ONE_MS = 5000;
+
+// A person's path: piecewise-linear legs; pos < 0 = outside the room
+struct Person {
+    struct Leg { uint32_t ms; float from, to; };
+    std::vector<Leg> legs;
+    bool at(uint32_t t, float &pos, float &speed) const {
+        uint32_t start = 0;
+        for (const Leg &l : legs) {
+            if (t < start + l.ms) {
+                float f = (float)(t - start) / l.ms;
+                pos = l.from + (l.to - l.from) * f;
+                speed = (l.to - l.from) * 1000.0f / l.ms;
+                return pos >= 0;
+            }
+            start += l.ms;
+        }
+        return false;
+    }
+    uint32_t length() const { uint32_t n = 0; for (const Leg &l : legs) n += l.ms; return n; }
+};
+
+static const float OUT = -1;
+
+// Engineering frames at 10 Hz for people following their paths
+static std::vector<Frame> simulate(const std::vector<Person> &people, uint32_t tailMs, uint32_t seed) {
+    std::mt19937 rng(seed);
+    std::uniform_int_distribution<int> noise(0, 12), walkE(60, 90), standE(45, 70), breathE(25, 45);
+    std::normal_distribution<float> rangeNoise(0, 8);
+    uint32_t end = 0;
+    for (const Person &p : people) end = std::max(end, p.length());
+    end += tailMs;
+    std::vector<Frame> out;
+    uint32_t lastHit = 0;
+    bool everHit = false;
+    uint8_t heldStatus = 0;
+    for (uint32_t t = 0; t < end; t += 100) {
+        Frame f = {};
+        f.t = t;
+        f.gates = true;
+        for (int g = 0; g < 9; g++) { f.mGates[g] = (uint8_t)noise(rng); f.sGates[g] = (uint8_t)noise(rng); }
+        f.truth = 0;
+        int bestM = -1, bestS = -1;
+        float posM = 0, posS = 0;
+        for (const Person &p : people) {
+            float pos, speed;
+            if (!p.at(t, pos, speed)) continue;
+            f.truth = 1;
+            int g = std::min(8, (int)(pos / GATE_CM));
+            bool walking = std::fabs(speed) > 10;
+            uint8_t m = (uint8_t)(walking ? walkE(rng) : noise(rng) + 5);
+            uint8_t s = (uint8_t)(walking ? breathE(rng) : standE(rng));
+            f.mGates[g] = std::max(f.mGates[g], m);
+            f.sGates[g] = std::max(f.sGates[g], s);
+            if (g < 8) f.mGates[g + 1] = std::max(f.mGates[g + 1], (uint8_t)(m / 3));
+            if (m > bestM) { bestM = m; posM = pos; }
+            if (s > bestS) { bestS = s; posS = pos; }
+        }
+        bool mHit = false, sHit = false;
+        for (int g = 0; g < 9; g++) {
+            mHit |= f.mGates[g] >= M_THR[g];
+            sHit |= S_THR[g] && f.sGates[g] >= S_THR[g];
+        }
+        uint8_t status = (mHit ? 1 : 0) | (sHit ? 2 : 0);
+        if (status) { lastHit = t; everHit = true; heldStatus = status; }
+        else if (everHit && t - lastHit < NO_ONE_MS) status = heldStatus; // the sensor's hold
+        f.status = status;
+        if (mHit && bestM >= 0) { f.movingCm = (uint16_t)std::max(1.0f, posM + rangeNoise(rng)); f.movingSignal = (uint8_t)bestM; }
+        if (status && bestS >= 0) { f.stationaryCm = (uint16_t)std::max(1.0f, posS + rangeNoise(rng)); f.stationarySignal = (uint8_t)bestS; }
+        out.push_back(f);
+    }
+    return out;
+}
+
+static std::vector<Frame> load(const char *path) {
+    std::vector<Frame> out;
+    FILE *fp = fopen(path, "r");
+    if (!fp) { perror(path); exit(1); }
+    char line[160];
+    while (fgets(line, sizeof(line), fp)) {
+        unsigned t, st, mc, ms, sc, ss; int truth = -1;
+        int n = sscanf(line, "%u,%u,%u,%u,%u,%u,%d", &t, &st, &mc, &ms, &sc, &ss, &truth);
+        if (n < 6) continue;
+        Frame f = {};
+        f.t = t; f.status = (uint8_t)st; f.movingCm = (uint16_t)mc; f.movingSignal = (uint8_t)ms;
+        f.stationaryCm = (uint16_t)sc; f.stationarySignal = (uint8_t)ss; f.truth = n == 7 ? truth : -1;
+        out.push_back(f);
+    }
+    fclose(fp);
+    return out;
+}
+
+// Latencies are for the last time the room became empty; clears counts
+// every early clear (a scenario may leave and come back)
+struct Result {
+    int32_t truthClearMs = -1;  // room became empty, -1 never
+    int32_t sensorClearMs = -1; // status 0 after that
+    int32_t earlyClearMs = -1;  // first early clear after that
+    unsigned falseClears = 0;
+    unsigned clears = 0;
+};
+
+static Result replay(const std::vector<Frame> &frames, LD2410Trajectory &tr) {
+    Result r;
+    tr.reset();
+    bool wasCleared = false;
+    int lastTruth = -1;
+    for (const Frame &f : frames) {
+        if (f.truth == 0 && lastTruth == 1) { r.truthClearMs = (int32_t)f.t; r.sensorClearMs = r.earlyClearMs = -1; }
+        if (f.truth >= 0) lastTruth = f.truth;
+        tr.update(f.t, f.status, f.movingCm, f.movingSignal, f.stationarySignal,
+                  f.gates ? f.mGates : nullptr, 8, f.gates ? f.sGates : nullptr, 8);
+        bool cleared = tr.earlyClear();
+        if (cleared && !wasCleared) {
+            r.clears++;
+            if (f.truth == 1) r.falseClears++;
+            else if (r.truthClearMs >= 0 && r.earlyClearMs < 0) r.earlyClearMs = (int32_t)f.t;
+        }
+        wasCleared = cleared;
+        if (f.status == 0 && r.truthClearMs >= 0 && r.sensorClearMs < 0) r.sensorClearMs = (int32_t)f.t;
+    }
+    return r;
+}
+
+static void print(const char *name, const Result &r, bool expectClear) {
+    auto ms = [&](int32_t t) { return t < 0 || r.truthClearMs < 0 ? -1.0 : (t - r.truthClearMs) / 1000.0; };
+    double sensor = ms(r.sensorClearMs), early = ms(r.earlyClearMs);
+    double reported = early >= 0 && (sensor < 0 || early < sensor) ? early : sensor;
+    bool ok = !r.falseClears && (expectClear ? r.clears > 0 : !r.clears);
+    printf("%-38s %8.1f %8.1f %8.1f %6u %6u  %s\n", name, sensor, early, reported, r.clears, r.falseClears, ok ? "ok" : "UNEXPECTED");
+}
+
+int main(int argc, char **argv) {
+    LD2410Trajectory::Params p;
+    p.exitStartCm = 300; // the door zone of the default zone table
+    p.exitEndCm = 450;
+    LD2410Trajectory tr(p);
+    tr.setThresholds(M_THR, 8, S_THR, 8);
+    printf("%-38s %8s %8s %8s %6s %6s\n", "scenario", "sensor s", "early s", "clear s", "clears", "false");
+
+    if (argc > 1) {
+        print(argv[1], replay(load(argv[1]), tr), false);
+        return 0;
+    }
+
+    struct Scenario { const char *name; std::vector<Person> people; bool expectClear; };
+    const Scenario scenarios[] = {
+        {"sit, walk out through the door", {{{{6000, 150, 150}, {3500, 150, 430}, {1, OUT, OUT}}}}, true},
+        {"walk out fast", {{{{4000, 200, 200}, {1800, 200, 440}, {1, OUT, OUT}}}}, true},
+        {"walk to the door and stand there", {{{{4000, 150, 150}, {3000, 150, 380}, {12000, 380, 380}, {1, OUT, OUT}}}}, false},
+        {"walk toward the door, turn back", {{{{4000, 150, 150}, {2500, 150, 360}, {2500, 360, 150}, {8000, 150, 150}, {1, OUT, OUT}}}}, false},
+        {"one leaves, one keeps sitting", {{{{4000, 200, 200}, {3000, 200, 430}, {1, OUT, OUT}}}, {{{20000, 250, 250}, {1, OUT, OUT}}}}, false},
+        {"walk in from the door, sit", {{{{3000, 430, 250}, {10000, 250, 250}, {1, OUT, OUT}}}}, false},
+        {"sit by the door after walking there", {{{{4000, 100, 100}, {3000, 100, 320}, {12000, 320, 320}, {1, OUT, OUT}}}}, false},
+        {"leave, come back, leave again", {{{{4000, 150, 150}, {3000, 150, 430}, {2000, OUT, OUT}, {2500, 430, 200}, {5000, 200, 200}, {2500, 200, 430}, {1, OUT, OUT}}}}, true},
+    };
+    bool ok = true;
+    double sumSensor = 0, sumClear = 0;
+    unsigned n = 0;
+    for (uint32_t seed = 1; seed <= 20; seed++) {
+        for (const Scenario &s : scenarios) {
+            Result r = replay(simulate(s.people, 8000, seed), tr);
+            bool good = !r.falseClears && (s.expectClear ? r.clears > 0 : !r.clears);
+            ok &= good;
+            if (seed == 1 || !good) print(s.name, r, s.expectClear);
+            if (s.expectClear && r.truthClearMs >= 0 && r.sensorClearMs >= 0) {
+                int32_t c = r.earlyClearMs >= 0 && r.earlyClearMs < r.sensorClearMs ? r.earlyClearMs : r.sensorClearMs;
+                sumSensor += (r.sensorClearMs - r.truthClearMs) / 1000.0;
+                sumClear += (c - r.truthClearMs) / 1000.0;
+                n++;
+            }
+        }
+    }
+    printf("mean occupied->clear after leaving through the door (%u runs): sensor only %.2f s, with early clear %.2f s\n", n, sumSensor / n, sumClear / n);
+    printf("%s\n", ok ? "PASS" : "FAIL");
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,196 @@
+// Boot to first frame, cold against warm starts: every boot is a forked
+// child running ld2410c_init() on a fresh virtual clock against the same
+// simulated sensor, which keeps running (and keeps its settings) over MCU
+// resets. RTC no-init memory is carried from one boot to the next, or filled
+// with noise for a power-on.
+//
+//   warm_start_sim [rounds]   default 20
+//
+// The sensor sends a frame every 100 ms (random phase per boot, none while
+// in config mode); the first frame is the first one the wrapper decodes, as
+// ld2410c_boot_stats() and the vendor BootFirstFrameMs attribute report it.
+// Each round boots, in order:
+//   power-on         RTC noise: cold
+//   software reset   warm, re-read 5 s after the first frame
+//   panic, task WDT  warm
+//   brownout         cold (the sensor may have browned out too)
+//   sensor changed   firmware updated while the MCU was down: warm, the
+//                    re-read finds it and reloads (StartKind 2); engineering
+//                    mode for the last 2 s publishes the firmware version
+//   corrupt record   one bit flipped in RTC memory: cold
+//   sensor in config MCU reset in the middle of a config session: warm, no
+//                    frames until the wrapper sends a config exit 300 ms in
+// Commands counts what the sensor was sent during ld2410c_init() / in all.
+#include "ld2410c_wrapper.h"
+#include "MatterInterface.h"
+#include "esp_matter.h"
+#include "esp_matter_standin.h"
+#include "esp_timer.h"
+#include "host_idf.h"
+#include "ld2410_sim.h"
+#include <sys/mman.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <vector>
+
+// DiagnosticLogProvider.cpp needs the CHIP diagnostic logs server; not built here
+void ld2410c_register_diagnostic_logs(esp_matter::node_t *node) { (void)node; }
+
+#define BOOT_MS 12000 // past the publish hold-off and the warm re-read
+#define RTC_MAX 256
+
+// What a boot hands back to the parent
+struct Result {
+    bool ran;
+    ld2410c_boot_stats_t boot;
+    uint32_t attrFirstFrame, attrStartKind;
+    char firmware[32];
+    uint32_t initCommands, commands;
+    size_t rtcLen;
+    uint8_t rtc[RTC_MAX];
+};
+
+static uint32_t attr_u(uint16_t endpoint, uint32_t id) {
+    const esp_matter_attr_val_t *v = esp_matter_standin::value(endpoint, LD2410C_CLUSTER_ID, id);
+    return v ? v->val.u32 : 0xFFFFFFFF;
+}
+
+static void boot(LD2410Sim &sim, uint32_t phaseMs, bool gates, Result *out) {
+    host_clock_set_us(0);
+    uint32_t cmd0 = sim.commands();
+    ld2410c_init();
+    out->initCommands = sim.commands() - cmd0;
+    esp_matter_node_t *node = esp_matter_node_create_wrapper();
+    uint16_t endpoint = create_occupancy_sensor_endpoint(node, "warm");
+    ld2410c_set_vendor_endpoint(endpoint);
+
+    LD2410Sim::Target t;
+    t.status = 2;
+    t.stationaryCm = t.distanceCm = 180;
+    t.stationarySignal = 60;
+    // Frames sent while init held the UART in config mode or was not reading are gone
+    uint32_t first = phaseMs;
+    while ((int64_t)first * 1000 < esp_timer_get_time()) first += 100;
+    for (uint32_t ms = first; ms < BOOT_MS; ms += 100) {
+        if (esp_timer_get_time() < (int64_t)ms * 1000) host_clock_set_us((int64_t)ms * 1000);
+        // The firmware version attribute goes out with the gate arrays
+        if (gates && ms >= BOOT_MS - 2000) ld2410c_set_gate_demand(LD2410C_GATE_DEMAND_APP, true);
+        sim.emitFrame(t);
+        ld2410c_run_commands();
+        ld2410c_poll();
+        esp_matter_standin::flush_reports();
+    }
+    ld2410c_boot_stats(&out->boot);
+    out->attrFirstFrame = attr_u(endpoint, LD2410C_ATTR_BOOT_FIRST_FRAME_MS);
+    out->attrStartKind = attr_u(endpoint, LD2410C_ATTR_START_KIND);
+    const esp_matter_attr_val_t *fw = esp_matter_standin::value(endpoint, LD2410C_CLUSTER_ID, LD2410C_ATTR_FIRMWARE_VERSION);
+    if (fw && fw->val.a.b) snprintf(out->firmware, sizeof(out->firmware), "%.*s", (int)fw->val.a.s, (const char *)fw->val.a.b);
+    out->commands = sim.commands() - cmd0;
+    uint8_t *rtc = host_rtc_noinit(&out->rtcLen);
+    if (rtc && out->rtcLen <= RTC_MAX) memcpy(out->rtc, rtc, out->rtcLen);
+    out->ran = true;
+}
+
+// One MCU boot in a child process: the sensor, NVS and RTC memory as the
+// parent holds them; the RTC memory comes back
+static Result run(LD2410Sim &sim, esp_reset_reason_t reason, uint32_t phaseMs, bool inConfig, bool gates, Result *shared) {
+    memset(shared, 0, sizeof(*shared));
+    host_set_reset_reason(reason);
+    fflush(stdout);
+    pid_t pid = fork();
+    if (pid == 0) {
+        if (inConfig) sim.bootIntoConfig();
+        boot(sim, phaseMs, gates, shared);
+        _exit(0);
+    }
+    int status = 0;
+    waitpid(pid, &status, 0);
+    Result r = *shared;
+    size_t len;
+    uint8_t *rtc = host_rtc_noinit(&len);
+    if (r.ran && rtc && len == r.rtcLen) memcpy(rtc, r.rtc, len);
+    return r;
+}
+
+struct Case {
+    const char *name;
+    esp_reset_reason_t reason;
+    uint8_t expectKind;
+    std::vector<uint32_t> firstMs;
+    uint32_t initCommands = 0, commands = 0;
+    bool ok = true;
+};
+
+int main(int argc, char **argv) {
+    unsigned rounds = argc > 1 ? (unsigned)atoi(argv[1]) : 20;
+    if (!rounds) { fprintf(stderr, "usage: warm_start_sim [rounds]\n"); return 1; }
+    Result *shared = (Result *)mmap(nullptr, sizeof(Result), PROT_READ | PROT_WRITE, MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+    size_t rtcLen;
+    uint8_t *rtc = host_rtc_noinit(&rtcLen);
+    if (shared == MAP_FAILED || !rtc || rtcLen > RTC_MAX) { fprintf(stderr, "no RTC no-init section\n"); return 1; }
+
+    LD2410Sim sim(UART_NUM_1);
+    std::mt19937 rng(2410);
+    enum { POWERON, SW, PANIC, TASK_WDT, BROWNOUT, CHANGED, CORRUPT, IN_CONFIG, CASES };
+    Case cases[CASES] = {
+        {"power-on", ESP_RST_POWERON, LD2410C_START_COLD, {}},
+        {"software reset", ESP_RST_SW, LD2410C_START_WARM, {}},
+        {"panic", ESP_RST_PANIC, LD2410C_START_WARM, {}},
+        {"task WDT", ESP_RST_TASK_WDT, LD2410C_START_WARM, {}},
+        {"brownout", ESP_RST_BROWNOUT, LD2410C_START_COLD, {}},
+        {"sensor changed", ESP_RST_SW, LD2410C_START_WARM_STALE, {}},
+        {"corrupt record", ESP_RST_SW, LD2410C_START_COLD, {}},
+        {"sensor in config", ESP_RST_SW, LD2410C_START_WARM, {}},
+    };
+    bool ok = true;
+    for (unsigned r = 0; r < rounds; r++) {
+        for (int c = 0; c < CASES; c++) {
+            Case &k = cases[c];
+            if (c == POWERON) for (size_t i = 0; i < rtcLen; i++) rtc[i] = (uint8_t)rng();
+            // Alternates 2.44 / 2.45, same capabilities
+            bool updated = r & 1;
+            if (c == CHANGED) sim.setFirmware(2, updated ? 0x44 : 0x45);
+            if (c == CORRUPT) rtc[rng() % rtcLen] ^= (uint8_t)(1u << (rng() % 8));
+            Result res = run(sim, k.reason, 1 + rng() % 100, c == IN_CONFIG, c == CHANGED, shared);
+            k.ok &= res.ran && res.boot.first_frame_ms && res.boot.start_kind == k.expectKind;
+            // Published as seen; warm starts re-read by the end of the boot
+            k.ok &= res.attrFirstFrame == res.boot.first_frame_ms && res.attrStartKind == res.boot.start_kind;
+            k.ok &= res.boot.start_kind == LD2410C_START_COLD || res.boot.confirmed;
+            if (c == CHANGED) k.ok &= strstr(res.firmware, updated ? "2.44" : "2.45") == res.firmware;
+            if (!res.ran) { printf("%s: boot %u crashed\n", k.name, r); ok = false; continue; }
+            k.firstMs.push_back(res.boot.first_frame_ms);
+            k.initCommands += res.initCommands;
+            k.commands += res.commands;
+        }
+    }
+
+    printf("%-18s %10s %8s %8s %8s %13s   (ms from boot to first frame, %u boots each)\n", "boot", "start", "mean",
+           "min", "max", "commands", rounds);
+    static const char *const KINDS[] = {"cold", "warm", "warm/stale"};
+    double coldMin = 1e9, warmMax = 0;
+    for (int c = 0; c < CASES; c++) {
+        Case &k = cases[c];
+        if (k.firstMs.empty()) continue;
+        double mean = 0;
+        for (uint32_t v : k.firstMs) mean += v;
+        mean /= k.firstMs.size();
+        uint32_t mn = *std::min_element(k.firstMs.begin(), k.firstMs.end());
+        uint32_t mx = *std::max_element(k.firstMs.begin(), k.firstMs.end());
+        printf("%-18s %10s %8.0f %8u %8u %6.1f/%-6.1f %s\n", k.name, KINDS[k.expectKind], mean, mn, mx,
+               (double)k.initCommands / k.firstMs.size(), (double)k.commands / k.firstMs.size(), k.ok ? "" : "FAIL");
+        ok &= k.ok;
+        if (k.expectKind == LD2410C_START_COLD) coldMin = std::min(coldMin, (double)mn);
+        else warmMax = std::max(warmMax, (double)mx);
+        // Nothing asked of the sensor before streaming on a warm start
+        if (k.expectKind != LD2410C_START_COLD) ok &= k.initCommands == 0;
+    }
+    // Every warm boot streams before the fastest cold one
+    ok &= warmMax < coldMin;
+    printf("%s\n", ok ? "PASS" : "FAIL");
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,142 @@
+// Work-stealing thread pool for the host tools.
+//
+// Every worker owns a deque: it pushes and pops its own tasks at the back
+// (newest first, still warm in cache) and, when empty, steals the oldest
+// task from the front of another worker's deque. Tasks may submit more
+// tasks; from a worker they land on that worker's own deque. parallelFor()
+// splits a range in halves on demand, so idle workers steal big pieces and
+// uneven task costs even out without a central queue.
+#pragma once
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+class WorkPool {
+public:
+    typedef std::function<void()> Task;
+
+    explicit WorkPool(unsigned threads = 0) {
+        if (!threads) threads = std::thread::hardware_concurrency();
+        if (!threads) threads = 1;
+        for (unsigned i = 0; i < threads; i++) queues.emplace_back(new Queue);
+        for (unsigned i = 0; i < threads; i++) workers.emplace_back([this, i] { run(i); });
+    }
+    ~WorkPool() {
+        {
+            std::lock_guard<std::mutex> l(idleLock);
+            stopping = true;
+        }
+        idle.notify_all();
+        for (std::thread &t : workers) t.join();
+    }
+
+    unsigned threads() const { return (unsigned)workers.size(); }
+    uint64_t steals() const { return stolen.load(); }
+
+    void submit(Task t) {
+        unsigned q = self() >= 0 ? (unsigned)self() : next++ % queues.size();
+        pending++;
+        {
+            std::lock_guard<std::mutex> l(queues[q]->lock);
+            queues[q]->tasks.push_back(std::move(t));
+        }
+        std::lock_guard<std::mutex> l(idleLock);
+        idle.notify_one();
+    }
+
+    // Blocks until every submitted task (and the tasks they submitted) ran
+    void wait() {
+        std::unique_lock<std::mutex> l(idleLock);
+        done.wait(l, [this] { return pending.load() == 0; });
+    }
+
+    // fn(begin, end) over [0, n) in pieces of at most grain
+    template <typename F>
+    void parallelFor(size_t n, size_t grain, F fn) {
+        if (!grain) grain = 1;
+        auto body = std::make_shared<F>(fn);
+        size_t per = (n + threads() - 1) / threads();
+        for (size_t b = 0; b < n; b += per) split(b, b + per < n ? b + per : n, grain, body);
+        wait();
+    }
+
+private:
+    struct Queue {
+        std::mutex lock;
+        std::deque<Task> tasks;
+    };
+    std::vector<std::unique_ptr<Queue>> queues;
+    std::vector<std::thread> workers;
+    std::atomic<uint64_t> pending{0};
+    std::atomic<uint64_t> stolen{0};
+    std::atomic<unsigned> next{0};
+    std::mutex idleLock;
+    std::condition_variable idle, done;
+    bool stopping = false;
+
+    // Worker index of the calling thread in this pool, -1 outside it
+    struct Current { const WorkPool *pool = nullptr; int id = -1; };
+    static Current &current() { static thread_local Current c; return c; }
+    int self() const { return current().pool == this ? current().id : -1; }
+
+    template <typename F>
+    void split(size_t b, size_t e, size_t grain, std::shared_ptr<F> body) {
+        submit([this, b, e, grain, body] {
+            size_t end = e;
+            // Hand out the upper halves; whoever is idle steals them
+            while (end - b > grain) {
+                size_t mid = b + (end - b) / 2;
+                split(mid, end, grain, body);
+                end = mid;
+            }
+            (*body)(b, end);
+        });
+    }
+
+    bool take(unsigned me, Task &t) {
+        {
+            Queue &q = *queues[me];
+            std::lock_guard<std::mutex> l(q.lock);
+            if (!q.tasks.empty()) { t = std::move(q.tasks.back()); q.tasks.pop_back(); return true; }
+        }
+        for (size_t k = 1; k < queues.size(); k++) {
+            Queue &q = *queues[(me + k) % queues.size()];
+            std::lock_guard<std::mutex> l(q.lock);
+            if (!q.tasks.empty()) {
+                t = std::move(q.tasks.front());
+                q.tasks.pop_front();
+                stolen++;
+                return true;
+            }
+        }
+        return false;
+    }
+
+    void run(unsigned me) {
+        current().pool = this;
+        current().id = (int)me;
+        for (;;) {
+            Task t;
+            if (take(me, t)) {
+                t();
+                if (--pending == 0) {
+                    std::lock_guard<std::mutex> l(idleLock);
+                    done.notify_all();
+                }
+                continue;
+            }
+            std::unique_lock<std::mutex> l(idleLock);
+            if (stopping) return;
+            // Woken by a submit; the timeout covers a task pushed between take() and here
+            idle.wait_for(l, std::chrono::milliseconds(1));
+        }
+    }
+};
@@ -0,0 +1,128 @@
+// Zone configuration through the vendor SetZone command: invoked the way the
+// interaction model would, run on the sensor task, checked against the zone
+// endpoints' Occupancy and the copy persisted in NVS.
+//
+//   zone_config
+//
+// Moves the far zone onto a target that only it covers, removes it while it
+// is occupied (its endpoint must clear), adds a zone past the last existing
+// one, and rejects out-of-range fields without queueing anything.
+#include "ld2410c_wrapper.h"
+#include "MatterInterface.h"
+#include "esp_matter.h"
+#include "esp_matter_standin.h"
+#include "esp_timer.h"
+#include "host_idf.h"
+#include "ld2410_sim.h"
+#include "ld2410_zones.h"
+#include <cstdio>
+
+// DiagnosticLogProvider.cpp needs the CHIP diagnostic logs server; not built here
+void ld2410c_register_diagnostic_logs(esp_matter::node_t *node) { (void)node; }
+
+static uint16_t g_endpoint = 0xFFFF;
+static uint16_t g_zone_endpoints[LD2410C_ZONE_MAX] = {0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF};
+static uint32_t g_t_ms = 0;
+
+static bool check(const char *what, bool ok) {
+    printf("%-58s %s\n", what, ok ? "ok" : "FAIL");
+    return ok;
+}
+
+static esp_err_t set_zone(uint16_t zone, uint16_t startCm, uint16_t endCm, uint16_t moving, uint16_t stationary, uint16_t hold) {
+    using Field = chip::TLV::TLVReader::Field;
+    const Field f[] = {
+        {0, chip::TLV::kTLVType_UnsignedInteger, zone},
+        {1, chip::TLV::kTLVType_UnsignedInteger, startCm},
+        {2, chip::TLV::kTLVType_UnsignedInteger, endCm},
+        {3, chip::TLV::kTLVType_UnsignedInteger, moving},
+        {4, chip::TLV::kTLVType_UnsignedInteger, stationary},
+        {5, chip::TLV::kTLVType_UnsignedInteger, hold},
+    };
+    esp_err_t err = esp_matter_standin::invoke(g_endpoint, LD2410C_CLUSTER_ID, LD2410C_CMD_SET_ZONE, f, 6);
+    ld2410c_run_commands();
+    return err;
+}
+
+static uint32_t last_status() {
+    const esp_matter_attr_val_t *v = esp_matter_standin::value(g_endpoint, LD2410C_CLUSTER_ID, LD2410C_ATTR_LAST_COMMAND_STATUS);
+    return v ? v->val.u8 : 0xFFFFFFFF;
+}
+
+static bool zone_occupied(uint8_t zone) {
+    const esp_matter_attr_val_t *v = esp_matter_standin::value(g_zone_endpoints[zone], 0x0406, 0x0000);
+    return v && (v->val.u8 & 1);
+}
+
+// Someone still at distanceCm: energy on its 75 cm gate only
+static void frames(LD2410Sim &sim, uint16_t distanceCm, unsigned n) {
+    LD2410Sim::Target tg;
+    if (distanceCm) {
+        tg.status = 2;
+        tg.stationaryCm = tg.distanceCm = distanceCm;
+        tg.stationarySignal = 80;
+        tg.stationaryGates[distanceCm / 75] = 80;
+    }
+    for (unsigned i = 0; i < n; i++, g_t_ms += 100) {
+        if (esp_timer_get_time() < (int64_t)g_t_ms * 1000) host_clock_set_us((int64_t)g_t_ms * 1000);
+        sim.emitFrame(tg);
+        ld2410c_poll();
+    }
+    esp_matter_standin::flush_reports();
+}
+
+static bool saved(uint8_t count, uint8_t zone, uint16_t startCm, uint16_t endCm) {
+    LD2410Zones z;
+    return z.load() && z.count() == count && z.config(zone).startCm == startCm && z.config(zone).endCm == endCm;
+}
+
+int main() {
+    LD2410Sim sim(UART_NUM_1);
+    ld2410c_init();
+    esp_matter_node_t *node = esp_matter_node_create_wrapper();
+    g_endpoint = create_occupancy_sensor_endpoint(node, "zones");
+    ld2410c_set_vendor_endpoint(g_endpoint);
+    for (uint8_t z = 0; z < ld2410c_zone_count(); z++) {
+        if (!ld2410c_zone_reachable(z)) continue;
+        g_zone_endpoints[z] = create_zone_occupancy_endpoint(node);
+        ld2410c_set_zone_endpoint(z, g_zone_endpoints[z]);
+    }
+    ld2410c_set_gate_demand(LD2410C_GATE_DEMAND_APP, true);
+    esp_matter_standin::set_subscribers(1);
+    g_t_ms = (uint32_t)(esp_timer_get_time() / 1000);
+    frames(sim, 0, 400); // past the publish hold-off, engineering mode on
+
+    bool ok = check("two default zones, both with endpoints", ld2410c_zone_count() == 2 && g_zone_endpoints[1] != 0xFFFF);
+    ok &= check("nothing saved before the first SetZone", !saved(2, 0, 0, 150));
+
+    // 225 cm sits on gate 3 (center 262 cm): outside both defaults
+    frames(sim, 225, 30);
+    ok &= check("target at 225 cm: default zones clear", !zone_occupied(0) && !zone_occupied(1));
+
+    ok &= check("SetZone 1 -> 150-300 cm accepted",
+                set_zone(1, 150, 300, 40, 30, 20) == ESP_OK && last_status() == LD2410C_CMD_STATUS_SUCCESS);
+    ok &= check("zone 1 persisted", saved(2, 1, 150, 300));
+    frames(sim, 225, 30);
+    ok &= check("target at 225 cm: zone 1 occupied, zone 0 clear", zone_occupied(1) && !zone_occupied(0));
+
+    ok &= check("SetZone 1 -> empty removes it", set_zone(1, 0, 0, 40, 30, 20) == ESP_OK && last_status() == LD2410C_CMD_STATUS_SUCCESS);
+    frames(sim, 225, 2);
+    ok &= check("removed while occupied: its endpoint clears", ld2410c_zone_count() == 1 && !zone_occupied(1));
+    ok &= check("removal persisted", saved(1, 0, 0, 150));
+
+    ok &= check("SetZone 2 -> 450-600 cm accepted", set_zone(2, 450, 600, 40, 30, 20) == ESP_OK);
+    ok &= check("zone 1 left empty, zone 2 reachable (endpoint at restart)",
+                ld2410c_zone_count() == 3 && !ld2410c_zone_reachable(1) && ld2410c_zone_reachable(2) && saved(3, 2, 450, 600));
+
+    // Rejected in the command callback: nothing queued, last status untouched
+    ld2410c_update_vendor_command_status(LD2410C_CMD_SET_ZONE, LD2410C_CMD_STATUS_NONE);
+    bool rejected = set_zone(LD2410C_ZONE_MAX, 0, 150, 40, 30, 20) == ESP_ERR_INVALID_ARG;
+    rejected &= set_zone(0, 300, 150, 40, 30, 20) == ESP_ERR_INVALID_ARG;
+    rejected &= set_zone(0, 0, 150, 101, 30, 20) == ESP_ERR_INVALID_ARG;
+    rejected &= set_zone(0, 0, 150, 40, 30, 300) == ESP_ERR_INVALID_ARG;
+    ok &= check("bad zone, range, threshold, hold rejected", rejected && last_status() == LD2410C_CMD_STATUS_NONE);
+    ok &= check("config unchanged after the rejects", saved(3, 0, 0, 150) && saved(3, 2, 450, 600));
+
+    printf("%s\n", ok ? "PASS" : "FAIL");
+    return ok ? 0 : 1;
+}
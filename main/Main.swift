@@ -37,25 +37,19 @@ func app_main() {
     // Start Matter
     Matter.start(deviceEventCallback)
 
-    var lastPresence = false
-
-    // Keep the main thread alive
+    // Occupancy transitions are pushed by the LD2410C sensor task; block on
+    // them instead of polling so changes are applied within one frame.
+    var event = ld2410c_occupancy_event_t()
     while true {
-        ld2410c_poll()
-        let isPresent = ld2410c_is_present()
-
-        if isPresent != lastPresence {
-            occupancySensor.setOccupied(isPresent)
-            if isPresent {
-                print("Occupancy detected")
-            } else {
-                print("Occupancy cleared")
-            }
-            lastPresence = isPresent
+        guard ld2410c_wait_occupancy_event(&event, UInt32.max) else {
+            continue
+        }
+        occupancySensor.setOccupied(event.present)
+        if event.present {
+            print("Occupancy detected")
+        } else {
+            print("Occupancy cleared")
         }
-
-        // Poll every 250ms
-        vTaskDelay(ms_to_ticks(250))
     }
 }
 
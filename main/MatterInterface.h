@@ -18,8 +18,17 @@ typedef void (*device_event_callback_t)(const void *event, intptr_t context);
 esp_matter_node_t *esp_matter_node_create_wrapper();
 void esp_matter_start_wrapper(device_event_callback_t callback);
 uint16_t create_occupancy_sensor_endpoint(esp_matter_node_t *node, const char *room_name);
+// OccupancySensing endpoint for one LD2410C distance zone
+uint16_t create_zone_occupancy_endpoint(esp_matter_node_t *node, uint8_t zone);
 void set_occupancy_attribute_value(uint16_t endpoint_id, bool occupied);
 
+// Attribute handles (Attribute.swift): resolved once, typed setters
+typedef struct matter_attribute_handle_s matter_attribute_handle_t;
+matter_attribute_handle_t *matter_attribute_bind(uint16_t endpoint_id, uint32_t cluster_id, uint32_t attribute_id);
+bool matter_attribute_set_uint(matter_attribute_handle_t *handle, uint32_t value);
+bool matter_attribute_set_int(matter_attribute_handle_t *handle, int32_t value);
+bool matter_attribute_set_bytes(matter_attribute_handle_t *handle, const uint8_t *bytes, uint16_t len);
+
 #ifdef __cplusplus
 }
 #endif
@@ -44,9 +44,34 @@ static const uint8_t CMD_BT_ON[]           = {0x04,0x00,0xA4,0x00,0x01,0x00};
 static const uint8_t CMD_BT_OFF[]          = {0x04,0x00,0xA4,0x00,0x00,0x00};
 static const uint8_t CMD_BT_PASSWD[]       = {0x08,0x00,0xA9,0x00,0x48,0x69,0x4C,0x69,0x6E,0x6B}; // default "HiL i n k"
 
-// Gate parameter templates (mutable fields will be patched before sending)
-static uint8_t CMD_GATE_PARAM[0x16] = {0x14,0x00,0x64,0x00,0x00,0x00,0x00,0x00,0,0,1,0,0,0,0,0,2,0,0,0,0,0};
-static uint8_t CMD_MAX_GATE[0x16]  = {0x14,0x00,0x60,0x00,0x00,0x00,8,0,0,0,1,0,8,0,0,0,2,0,5,0,0,0};
+// Gate parameter templates (value fields are patched by the encode* helpers)
+static const uint8_t CMD_GATE_PARAM[LD2410_PARAM_FRAME] = {0x14,0x00,0x64,0x00,0x00,0x00,0x00,0x00,0,0,1,0,0,0,0,0,2,0,0,0,0,0};
+static const uint8_t CMD_MAX_GATE[LD2410_PARAM_FRAME]  = {0x14,0x00,0x60,0x00,0x00,0x00,8,0,0,0,1,0,8,0,0,0,2,0,5,0,0,0};
+
+// Minimum firmware per optional command group. The minor byte is printed in
+// hex by getFirmware(), so "2.44" is {2, 0x44}. Plain LD2410 units report 1.x
+// and have neither Bluetooth nor the later commands.
+static const struct { uint32_t cap; uint8_t major; uint8_t minor; } CAP_TABLE[] = {
+    { LD2410_CAP_BLUETOOTH,       2, 0x00 },
+    { LD2410_CAP_MAC,             2, 0x00 },
+    { LD2410_CAP_RESOLUTION,      2, 0x04 },
+    { LD2410_CAP_AUX_CONTROL,     2, 0x04 },
+    { LD2410_CAP_AUTO_THRESHOLDS, 2, 0x44 },
+};
+
+// ACK deadline bounds per command class. The floor covers the UART read
+// granularity (one RTOS tick) and scheduling jitter; the ceiling is the old
+// fixed deadline and is used until the first sample. Reboot/factory reset are
+// never resent: a lost ACK there usually means the sensor is already restarting.
+static const struct { uint16_t floorMs; uint16_t ceilMs; uint8_t retries; } RTT_LIMITS[LD2410Driver::RTT_CLASSES] = {
+    {  50,  500, 2 }, // RTT_CONFIG
+    {  50,  800, 2 }, // RTT_QUERY
+    {  50,  800, 2 }, // RTT_WRITE
+    { 200, 2000, 0 }, // RTT_SYSTEM
+};
+static const uint8_t RTT_MAX_BACKOFF = 3;
+// Longest command frame we send (gate parameters): header + len + 0x14 + tail
+static const uint32_t MAX_CMD_FRAME = 4 + 2 + 0x14 + 4;
 
 static const char *STATUS_STR[7] = {
     "No target",
@@ -118,12 +143,15 @@ bool LD2410Driver::readFrame() {
     return true;
 }
 
-bool LD2410Driver::waitForAck(const uint8_t *expectedCmdIds, size_t count, uint32_t giveUpAt) {
-    if (!giveUpAt) giveUpAt = nowMillis() + timeout_ms;
+bool LD2410Driver::waitForAck(uint16_t expectedAck, uint32_t giveUpAt) {
     uint8_t last4[4] = {0};
-    while (nowMillis() < giveUpAt) {
+    uint32_t now;
+    while ((now = nowMillis()) < giveUpAt) {
         uint8_t b;
-        int r = uart_read_bytes(uart_num, &b, 1, pdMS_TO_TICKS(15));
+        // Never block past the deadline, but always for at least one tick
+        uint32_t left = giveUpAt - now;
+        TickType_t wait = pdMS_TO_TICKS(left < 15 ? left : 15);
+        int r = uart_read_bytes(uart_num, &b, 1, wait ? wait : 1);
         if (r == 1) {
             // shift register
             last4[0] = last4[1];
@@ -149,7 +177,14 @@ bool LD2410Driver::waitForAck(const uint8_t *expectedCmdIds, size_t count, uint3
                 // store payload only for parser
                 inBufI = frameLen + 4; // including tail for convenience
                 if (debug_mode) debugHex(inBuf, inBufI, "ACK payload");
-                if (processAck()) return true;
+                uint16_t ackId = inBuf[0] | (inBuf[1] << 8);
+                bool ok = processAck();
+                if (!expectedAck) {
+                    if (ok) return true;
+                } else if (ackId == expectedAck) {
+                    ackAccepted = ok; // a NAK ends the wait too
+                    return true;
+                }
             }
             // Data frame header
             if (memcmp(last4, HEAD_DATA, 4) == 0) {
@@ -164,9 +199,11 @@ bool LD2410Driver::waitForAck(const uint8_t *expectedCmdIds, size_t count, uint3
                         idx++;
                         if (memcmp(win, TAIL_DATA, 4) == 0) {
                             inBufI = idx; // payload + tail
-                            if (debug_mode) debugHex(inBuf, inBufI, "DATA payload");
-                            processData();
-                            return true;
+                            if (processData()) frameCount++;
+                            // A repeat would only print the previous dump again
+                            if (debug_mode && !repeated) debugHex(inBuf, inBufI, "DATA payload");
+                            if (!expectedAck) return true;
+                            break;
                         }
                     }
                 }
@@ -178,8 +215,55 @@ bool LD2410Driver::waitForAck(const uint8_t *expectedCmdIds, size_t count, uint3
     return false;
 }
 
+bool LD2410Driver::transact(const uint8_t *cmd, RttClass cls) {
+    const uint16_t expected = (uint16_t)(cmd[2] | (cmd[3] << 8)) | 0x100;
+    RttStats &st = rtt[cls];
+    for (uint8_t attempt = 0; attempt <= RTT_LIMITS[cls].retries; attempt++) {
+        if (attempt) st.retries++;
+        uint32_t rto = (uint32_t)rttDeadline(cls) << st.backoff;
+        if (rto > RTT_LIMITS[cls].ceilMs) rto = RTT_LIMITS[cls].ceilMs;
+        sendCommand(cmd);
+        int64_t sent = esp_timer_get_time();
+        if (waitForAck(expected, nowMillis() + rto)) {
+            // Karn: an ACK after a resend can't be matched to either send, so no sample
+            if (attempt == 0) addRttSample(cls, (uint32_t)(esp_timer_get_time() - sent));
+            st.backoff = 0;
+            return ackAccepted;
+        }
+        st.timeouts++;
+        if (st.backoff < RTT_MAX_BACKOFF) st.backoff++;
+        if (debug_mode) ESP_LOGW(TAG, "No ACK for cmd 0x%02X after %u ms", cmd[2], (unsigned)rto);
+    }
+    return false;
+}
+
+uint16_t LD2410Driver::rttDeadline(RttClass cls) const {
+    const RttStats &st = rtt[cls];
+    // No sample yet: the old fixed deadline
+    if (!st.samples) return RTT_LIMITS[cls].ceilMs;
+    return st.rto_ms;
+}
+
+void LD2410Driver::addRttSample(RttClass cls, uint32_t us) {
+    // RFC 6298 smoothing (alpha 1/8, beta 1/4)
+    RttStats &st = rtt[cls];
+    if (!st.samples) {
+        st.srtt_us = us;
+        st.rttvar_us = us / 2;
+    } else {
+        uint32_t err = us > st.srtt_us ? us - st.srtt_us : st.srtt_us - us;
+        st.rttvar_us = st.rttvar_us - st.rttvar_us / 4 + err / 4;
+        st.srtt_us = st.srtt_us - st.srtt_us / 8 + us / 8;
+    }
+    if (st.samples < 0xFFFF) st.samples++;
+    uint32_t rto = (st.srtt_us + 4 * st.rttvar_us + 999) / 1000;
+    if (rto < RTT_LIMITS[cls].floorMs) rto = RTT_LIMITS[cls].floorMs;
+    if (rto > RTT_LIMITS[cls].ceilMs) rto = RTT_LIMITS[cls].ceilMs;
+    st.rto_ms = (uint16_t)rto;
+}
+
 LD2410Driver::Response LD2410Driver::check() {
-    bool got = waitForAck(nullptr, 0, nowMillis() + 5); // short poll
+    bool got = waitForAck(0, nowMillis() + 5); // short poll
     if (!got) return FAIL;
     if (isDataValid()) return DATA;
     return ACK;
@@ -188,65 +272,197 @@ LD2410Driver::Response LD2410Driver::check() {
 bool LD2410Driver::configMode(bool enable) {
     if (enable && isConfig) return true;
     if (!enable && !isConfig) return true;
-    sendCommand(enable ? CMD_CONFIG_ENABLE : CMD_CONFIG_DISABLE);
-    if (waitForAck(nullptr,0, nowMillis()+500)) {
-        // processAck sets flags
-        return isConfig == enable;
+    // processAck sets flags
+    return transact(enable ? CMD_CONFIG_ENABLE : CMD_CONFIG_DISABLE, RTT_CONFIG) && isConfig == enable;
+}
+
+bool LD2410Driver::forceConfigExit() {
+    isConfig = true;
+    bool ok = configMode(false);
+    isConfig = false; // no ACK: it was not in config mode (or is not listening)
+    return ok;
+}
+
+// setBaud() enumeration 1..8
+static const uint32_t BAUD_RATES[8] = {9600, 19200, 38400, 57600, 115200, 230400, 256000, 460800};
+
+bool LD2410Driver::probeBaud(uint32_t rate, uint32_t listenMs) {
+    uart_set_baudrate(uart_num, rate);
+    uart_flush_input(uart_num);
+    // A streaming sensor shows up within a few frame periods
+    uint32_t before = frameCount;
+    uint32_t until = nowMillis() + listenMs;
+    while (frameCount == before && nowMillis() < until) waitForAck(0, until);
+    if (frameCount != before) return true;
+    // Quiet: may sit in config mode. One attempt, no RTT sample
+    isConfig = false;
+    sendCommand(CMD_CONFIG_ENABLE);
+    if (!waitForAck(0x1FF, nowMillis() + 150) || !ackAccepted) return false;
+    configMode(false);
+    return true;
+}
+
+uint32_t LD2410Driver::scanBaud() {
+    uint32_t found = 0;
+    if (probeBaud(LD2410_BAUD_RATE, 250)) return LD2410_BAUD_RATE;
+    for (uint32_t rate : BAUD_RATES) {
+        if (rate != LD2410_BAUD_RATE && probeBaud(rate, 250)) { found = rate; break; }
     }
-    return false;
+    if (!found) {
+        uart_set_baudrate(uart_num, LD2410_BAUD_RATE);
+        return 0;
+    }
+    ESP_LOGW(TAG, "Sensor answers at %u baud, moving it back to %u", (unsigned)found, (unsigned)LD2410_BAUD_RATE);
+    uint8_t idx = 0;
+    while (BAUD_RATES[idx] != LD2410_BAUD_RATE) idx++;
+    // The new rate applies after the reboot setBaud() ends with
+    if (setBaud(idx + 1) && probeBaud(LD2410_BAUD_RATE, 1500)) return LD2410_BAUD_RATE;
+    return probeBaud(found, 1500) ? found : 0;
 }
 
 bool LD2410Driver::enhancedMode(bool enable) {
     if (isEnhanced == enable) return true;
-    bool ok = configMode(true) && sendCommand(enable ? CMD_ENG_ON : CMD_ENG_OFF) && waitForAck(nullptr,0, nowMillis()+500);
+    bool ok = configMode(true) && transact(enable ? CMD_ENG_ON : CMD_ENG_OFF, RTT_WRITE);
     if (ok && !enable) isEnhanced = false;
     if (configMode(false)) return ok;
     return ok;
 }
 
+void LD2410Driver::buildCapabilities() {
+    uint32_t c = 0;
+    for (const auto &e : CAP_TABLE) {
+        if (firmwareMajor > e.major || (firmwareMajor == e.major && firmwareMinor >= e.minor)) c |= e.cap;
+    }
+    // A receive buffer smaller than our largest frame would truncate config writes
+    if (bufferSize && bufferSize < MAX_CMD_FRAME) {
+        ESP_LOGW(TAG, "Sensor buffer %u bytes < %u, config writes may fail", (unsigned)bufferSize, (unsigned)MAX_CMD_FRAME);
+    }
+    caps = c | LD2410_CAP_KNOWN;
+    ESP_LOGI(TAG, "Firmware %u.%02X protocol v%u: capabilities 0x%02X", firmwareMajor, firmwareMinor, (unsigned)version, (unsigned)(caps & LD2410_CAP_ALL));
+}
+
+void LD2410Driver::setFirmware(const uint8_t *raw) {
+    // Another firmware than the one the capabilities were built from
+    if ((caps & LD2410_CAP_KNOWN) && (raw[1] != firmwareMajor || raw[0] != firmwareMinor)) caps = 0;
+    memcpy(firmwareRaw, raw, sizeof(firmwareRaw));
+    // Layout follows Arduino: bytes after status
+    firmwareStr = byteToHex(raw[1], false) + std::string(".") + byteToHex(raw[0]) + std::string(".") + byteToHex(raw[5]) + byteToHex(raw[4]) + byteToHex(raw[3]) + byteToHex(raw[2]);
+    firmwareMajor = raw[1]; firmwareMinor = raw[0];
+}
+
+bool LD2410Driver::snapshot(Snapshot &out) const {
+    if (!firmwareMajor || !maxRange) return false;
+    memset(&out, 0, sizeof(out)); // padding too: callers checksum the bytes
+    memcpy(out.firmware, firmwareRaw, sizeof(out.firmware));
+    out.version = (uint16_t)version;
+    out.bufferSize = (uint16_t)bufferSize;
+    out.fineRes = (int8_t)fineRes;
+    out.maxRange = maxRange;
+    out.noOneWindow = noOne_window;
+    out.movingN = movingThresholds.N;
+    out.stationaryN = stationaryThresholds.N;
+    memcpy(out.moving, movingThresholds.values, sizeof(out.moving));
+    memcpy(out.stationary, stationaryThresholds.values, sizeof(out.stationary));
+    return true;
+}
+
+void LD2410Driver::restore(const Snapshot &s) {
+    version = s.version;
+    bufferSize = s.bufferSize;
+    caps = 0;
+    setFirmware(s.firmware);
+    if (firmwareMajor) buildCapabilities();
+    fineRes = s.fineRes;
+    maxRange = s.maxRange;
+    noOne_window = s.noOneWindow;
+    memcpy(movingThresholds.values, s.moving, sizeof(s.moving));
+    memcpy(stationaryThresholds.values, s.stationary, sizeof(s.stationary));
+    movingThresholds.setN(s.movingN);
+    stationaryThresholds.setN(s.stationaryN);
+}
+
+bool LD2410Driver::refreshSnapshot() {
+    bool ok = configMode(true) && transact(CMD_QUERY_FIRMWARE, RTT_QUERY) && transact(CMD_QUERY_PARAM, RTT_QUERY);
+    if (ok && !(caps & LD2410_CAP_KNOWN)) buildCapabilities();
+    if (ok && supports(LD2410_CAP_RESOLUTION)) ok = transact(CMD_QUERY_RES, RTT_QUERY);
+    configMode(false);
+    return ok;
+}
+
+uint32_t LD2410Driver::getCapabilities() {
+    if (!(caps & LD2410_CAP_KNOWN)) {
+        if (!firmwareMajor) requestFirmware();
+        if (firmwareMajor) buildCapabilities();
+        else return LD2410_CAP_ALL; // unknown: permissive, retried on next call
+    }
+    return caps & LD2410_CAP_ALL;
+}
+
 bool LD2410Driver::requestMAC() {
-    bool ok = configMode(true) && sendCommand(CMD_QUERY_MAC) && waitForAck(nullptr,0, nowMillis()+500);
+    if (!supports(LD2410_CAP_MAC)) return false;
+    bool ok = configMode(true) && transact(CMD_QUERY_MAC, RTT_QUERY);
     configMode(false);
     return ok;
 }
 
 bool LD2410Driver::requestFirmware() {
-    bool ok = configMode(true) && sendCommand(CMD_QUERY_FIRMWARE) && waitForAck(nullptr,0, nowMillis()+500);
+    bool ok = configMode(true) && transact(CMD_QUERY_FIRMWARE, RTT_QUERY);
     configMode(false);
     return ok;
 }
 
 bool LD2410Driver::requestResolution() {
-    bool ok = configMode(true) && sendCommand(CMD_QUERY_RES) && waitForAck(nullptr,0, nowMillis()+500);
+    if (!supports(LD2410_CAP_RESOLUTION)) return false;
+    bool ok = configMode(true) && transact(CMD_QUERY_RES, RTT_QUERY);
     configMode(false);
     return ok;
 }
 
 bool LD2410Driver::setResolution(bool fine) {
-    bool ok = configMode(true) && sendCommand(fine ? CMD_RES_FINE : CMD_RES_COARSE) && sendCommand(CMD_QUERY_RES) && waitForAck(nullptr,0, nowMillis()+500);
+    if (!supports(LD2410_CAP_RESOLUTION)) return false;
+    bool ok = configMode(true) && transact(fine ? CMD_RES_FINE : CMD_RES_COARSE, RTT_WRITE) && transact(CMD_QUERY_RES, RTT_QUERY);
     configMode(false);
     return ok;
 }
 
 bool LD2410Driver::requestParameters() {
-    bool ok = configMode(true) && sendCommand(CMD_QUERY_PARAM) && waitForAck(nullptr,0, nowMillis()+800);
+    bool ok = configMode(true) && transact(CMD_QUERY_PARAM, RTT_QUERY);
     configMode(false);
     return ok;
 }
 
-bool LD2410Driver::setGateParameters(uint8_t gate, uint8_t movingThreshold, uint8_t stationaryThreshold) {
-    if (movingThreshold > 100) movingThreshold = 100;
-    if (stationaryThreshold > 100) stationaryThreshold = 100;
-    uint8_t *cmd = CMD_GATE_PARAM;
-    if (gate > 8) { cmd[6] = 0xFF; cmd[7] = 0xFF; }
-    else { cmd[6] = gate; cmd[7] = 0; }
-    cmd[12] = movingThreshold;
-    cmd[18] = stationaryThreshold;
-    bool ok = configMode(true) && sendCommand(cmd) && sendCommand(CMD_QUERY_PARAM) && waitForAck(nullptr,0, nowMillis()+800);
+void LD2410Driver::encodeGateFrame(uint8_t *out, uint8_t gate, uint8_t movingThreshold, uint8_t stationaryThreshold) {
+    memcpy(out, CMD_GATE_PARAM, LD2410_PARAM_FRAME);
+    if (gate > 8) { out[6] = 0xFF; out[7] = 0xFF; }
+    else { out[6] = gate; out[7] = 0; }
+    out[12] = movingThreshold > 100 ? 100 : movingThreshold;
+    out[18] = stationaryThreshold > 100 ? 100 : stationaryThreshold;
+}
+
+void LD2410Driver::encodeMaxGateFrame(uint8_t *out, uint8_t movingGate, uint8_t stationaryGate, uint8_t noOneWindow) {
+    memcpy(out, CMD_MAX_GATE, LD2410_PARAM_FRAME);
+    out[6]  = movingGate > 8 ? 8 : movingGate;
+    out[12] = stationaryGate > 8 ? 8 : stationaryGate;
+    out[18] = noOneWindow;
+}
+
+bool LD2410Driver::writeParameterFrames(const uint8_t *const *frames, uint8_t count) {
+    if (!count) return true;
+    bool ok = configMode(true);
+    for (uint8_t i = 0; i < count && ok; i++) ok = transact(frames[i], RTT_WRITE);
+    // One query refreshes the cached thresholds for the whole batch
+    ok = ok && transact(CMD_QUERY_PARAM, RTT_QUERY);
     configMode(false);
     return ok;
 }
 
+bool LD2410Driver::setGateParameters(uint8_t gate, uint8_t movingThreshold, uint8_t stationaryThreshold) {
+    uint8_t cmd[LD2410_PARAM_FRAME];
+    encodeGateFrame(cmd, gate, movingThreshold, stationaryThreshold);
+    const uint8_t *frames[] = {cmd};
+    return writeParameterFrames(frames, 1);
+}
+
 bool LD2410Driver::setMovingThreshold(uint8_t gate, uint8_t movingThreshold) {
     if (gate > 8) return false;
     if (!movingThresholds.N) requestParameters();
@@ -260,27 +476,22 @@ bool LD2410Driver::setStationaryThreshold(uint8_t gate, uint8_t stationaryThresh
 }
 
 bool LD2410Driver::setGateParameters(const ValuesArray &moving, const ValuesArray &stationary, uint8_t noOneWindow) {
-    if (!configMode(true)) return false;
-    bool success = true;
-    for (uint8_t i=0;i<9 && success;i++) {
-        success = setGateParameters(i, moving.values[i], stationary.values[i]);
-        vTaskDelay(pdMS_TO_TICKS(20));
+    uint8_t cmds[10][LD2410_PARAM_FRAME];
+    const uint8_t *frames[10];
+    for (uint8_t i = 0; i < 9; i++) {
+        encodeGateFrame(cmds[i], i, moving.values[i], stationary.values[i]);
+        frames[i] = cmds[i];
     }
-    success = success && setMaxGate(moving.N, stationary.N, noOneWindow);
-    configMode(false);
-    return success;
+    encodeMaxGateFrame(cmds[9], moving.N, stationary.N, noOneWindow);
+    frames[9] = cmds[9];
+    return writeParameterFrames(frames, 10);
 }
 
 bool LD2410Driver::setMaxGate(uint8_t movingGate, uint8_t stationaryGate, uint8_t noOneWindow) {
-    if (movingGate > 8) movingGate = 8;
-    if (stationaryGate > 8) stationaryGate = 8;
-    uint8_t *cmd = CMD_MAX_GATE;
-    cmd[6]  = movingGate;
-    cmd[12] = stationaryGate;
-    cmd[18] = noOneWindow;
-    bool ok = configMode(true) && sendCommand(cmd) && sendCommand(CMD_QUERY_PARAM) && waitForAck(nullptr,0, nowMillis()+800);
-    configMode(false);
-    return ok;
+    uint8_t cmd[LD2410_PARAM_FRAME];
+    encodeMaxGateFrame(cmd, movingGate, stationaryGate, noOneWindow);
+    const uint8_t *frames[] = {cmd};
+    return writeParameterFrames(frames, 1);
 }
 
 bool LD2410Driver::setNoOneWindow(uint8_t noOneWindow) {
@@ -306,27 +517,29 @@ bool LD2410Driver::setMaxStationaryGate(uint8_t stationaryGate) {
 }
 
 bool LD2410Driver::requestReset() {
-    bool ok = configMode(true) && sendCommand(CMD_RESET) && sendCommand(CMD_QUERY_PARAM) && sendCommand(CMD_QUERY_RES) && waitForAck(nullptr,0, nowMillis()+1000);
+    bool ok = configMode(true) && transact(CMD_RESET, RTT_SYSTEM) && transact(CMD_QUERY_PARAM, RTT_QUERY)
+        && (!supports(LD2410_CAP_RESOLUTION) || transact(CMD_QUERY_RES, RTT_QUERY));
     configMode(false);
     return ok;
 }
 
 bool LD2410Driver::requestReboot() {
-    bool ok = configMode(true) && sendCommand(CMD_REBOOT) && waitForAck(nullptr,0, nowMillis()+500);
+    bool ok = configMode(true) && transact(CMD_REBOOT, RTT_SYSTEM);
     configMode(false);
     isEnhanced = false; isConfig = false;
     return ok;
 }
 
-bool LD2410Driver::requestBTon() { bool ok = configMode(true) && sendCommand(CMD_BT_ON) && waitForAck(nullptr,0, nowMillis()+500); configMode(false); return ok; }
-bool LD2410Driver::requestBToff() { bool ok = configMode(true) && sendCommand(CMD_BT_OFF) && waitForAck(nullptr,0, nowMillis()+500); configMode(false); return ok; }
+bool LD2410Driver::requestBTon() { if (!supports(LD2410_CAP_BLUETOOTH)) return false; bool ok = configMode(true) && transact(CMD_BT_ON, RTT_WRITE); configMode(false); return ok; }
+bool LD2410Driver::requestBToff() { if (!supports(LD2410_CAP_BLUETOOTH)) return false; bool ok = configMode(true) && transact(CMD_BT_OFF, RTT_WRITE); configMode(false); return ok; }
 
 bool LD2410Driver::setBTpassword(const char *passwd) {
+    if (!supports(LD2410_CAP_BLUETOOTH)) return false;
     uint8_t cmd[10]; memcpy(cmd, CMD_BT_PASSWD, 10);
     for (int i=0;i<6;i++) {
         cmd[4+i] = (passwd && (int)strlen(passwd) > i) ? (uint8_t)passwd[i] : (uint8_t)' ';
     }
-    bool ok = configMode(true) && sendCommand(cmd) && waitForAck(nullptr,0, nowMillis()+500);
+    bool ok = configMode(true) && transact(cmd, RTT_WRITE);
     configMode(false); return ok;
 }
 
@@ -335,27 +548,30 @@ bool LD2410Driver::resetBTpassword() { return setBTpassword(nullptr); }
 bool LD2410Driver::setBaud(uint8_t baud) {
     if (baud < 1 || baud > 8) return false;
     uint8_t cmd[6] = {0x04,0x00,0xA1,0x00,baud,0x00};
-    bool ok = configMode(true) && sendCommand(cmd) && requestReboot();
+    bool ok = configMode(true) && transact(cmd, RTT_WRITE) && requestReboot();
     return ok;
 }
 
-bool LD2410Driver::requestAuxConfig() { bool ok = configMode(true) && sendCommand(CMD_QUERY_AUX) && waitForAck(nullptr,0, nowMillis()+500); configMode(false); return ok; }
+bool LD2410Driver::requestAuxConfig() { if (!supports(LD2410_CAP_AUX_CONTROL)) return false; bool ok = configMode(true) && transact(CMD_QUERY_AUX, RTT_QUERY); configMode(false); return ok; }
 
 bool LD2410Driver::autoThresholds(uint8_t timeout_s) {
+    if (!supports(LD2410_CAP_AUTO_THRESHOLDS)) return false;
     uint8_t cmd[6]; memcpy(cmd, CMD_AUTO_BEGIN, 6); cmd[4] = timeout_s; // modify timeout
-    bool ok = configMode(true) && sendCommand(cmd) && waitForAck(nullptr,0, nowMillis()+500);
+    bool ok = configMode(true) && transact(cmd, RTT_WRITE);
     configMode(false); return ok;
 }
 
 AutoStatus LD2410Driver::getAutoStatus() {
-    bool res = configMode(true) && sendCommand(CMD_AUTO_QUERY) && waitForAck(nullptr,0, nowMillis()+500);
+    if (!supports(LD2410_CAP_AUTO_THRESHOLDS)) return AutoStatus::NOT_SET;
+    bool res = configMode(true) && transact(CMD_AUTO_QUERY, RTT_QUERY);
     configMode(false);
     return res ? autoStatus : AutoStatus::NOT_SET;
 }
 
 bool LD2410Driver::setAuxControl(LightControl lc, uint8_t light_threshold, OutputControl oc) {
+    if (!supports(LD2410_CAP_AUX_CONTROL)) return false;
     uint8_t cmd[8]; memcpy(cmd, CMD_AUX_DEFAULT, 8); cmd[4] = (uint8_t)lc; cmd[5] = light_threshold; cmd[6] = (uint8_t)oc;
-    bool ok = configMode(true) && sendCommand(cmd) && sendCommand(CMD_QUERY_AUX) && waitForAck(nullptr,0, nowMillis()+500); configMode(false); return ok;
+    bool ok = configMode(true) && transact(cmd, RTT_WRITE) && transact(CMD_QUERY_AUX, RTT_QUERY); configMode(false); return ok;
 }
 
 bool LD2410Driver::resetAuxControl() { return setAuxControl(LightControl::NO_LIGHT_CONTROL,0, OutputControl::DEFAULT_LOW); }
@@ -384,6 +600,7 @@ uint32_t LD2410Driver::getVersion() { if (!version) { configMode(true); configMo
 const LD2410Driver::SensorData &LD2410Driver::getSensorData() { return sData; }
 uint8_t LD2410Driver::getResolution() {
     if (fineRes >= 0) return (fineRes == 1) ? 20 : 75;
+    if (!supports(LD2410_CAP_RESOLUTION)) { fineRes = 0; return 75; } // fixed 75 cm gates
     requestResolution();
     if (fineRes >= 0) return (fineRes == 1) ? 20 : 75;
     return 0;
@@ -426,9 +643,7 @@ bool LD2410Driver::processAck() {
             }
             break;
         case 0x1A0: // firmware
-            // Layout follows Arduino: bytes after status
-            firmwareStr = byteToHex(inBuf[7], false) + std::string(".") + byteToHex(inBuf[6]) + std::string(".") + byteToHex(inBuf[11]) + byteToHex(inBuf[10]) + byteToHex(inBuf[9]) + byteToHex(inBuf[8]);
-            firmwareMajor = inBuf[7]; firmwareMinor = inBuf[6];
+            setFirmware(inBuf + 6);
             break;
         case 0x1AB: // query resolution
             fineRes = inBuf[4];
@@ -459,7 +674,7 @@ bool LD2410Driver::processAck() {
     return true;
 }
 
-bool LD2410Driver::processData() {
+bool LD2410Driver::decodeDataFrame(const uint8_t *p, size_t len, SensorData &out, uint8_t *light, uint8_t *outPin) {
     // Observed data frame layout (basic mode) from sensor on UART after 0xF4F3F2F1 header:
     // [0] lenLo
     // [1] lenHi  (payload length starting at index 2 up to (1+len))
@@ -477,31 +692,84 @@ bool LD2410Driver::processData() {
     // [13] reserved / threshold indicator (often 0x55)
     // [14] reserved (often 0x00)
     // Then 4 byte tail 0xF8 0xF7 0xF6 0xF5 already present at end of buffer.
-    // Enhanced mode frames would differ (length & additional per-gate values); not yet observed here.
+    // Engineering mode frames ([2] == 0x01) insert after [12]:
+    // [13] max moving gate N, [14] max stationary gate M,
+    // moving gate energies 0..N, stationary gate energies 0..M,
+    // light level, output pin level, then the 0x55 0x00 trailer.
 
-    if (inBufI < 2 + 13 + 4) return false; // minimal size check
-    const uint8_t *p = inBuf;
+    if (len < 2 + 13 + 4) return false; // minimal size check
     uint16_t payloadLen = p[0] | (p[1] << 8);
     // Sanity: payloadLen bytes follow starting at p[2]; we captured payloadLen + 2 + tail (4)
-    if (payloadLen + 2 + 4 != inBufI) {
-        // Allow some tolerance: if larger (enhanced) we'll add later
-        if (payloadLen + 2 + 4 > inBufI) return false;
+    // Trailing bytes beyond the declared length are ignored
+    if (payloadLen + 2u + 4u > len) return false;
+    bool engineering = (p[2] == 0x01);
+    if ((p[2] != 0x02 && !engineering) || p[3] != 0xAA) return false;
+
+    uint8_t nM = 0, nS = 0;
+    if (engineering) {
+        nM = p[13] > 8 ? 8 : p[13];
+        nS = p[14] > 8 ? 8 : p[14];
+        // energies (N+1 + M+1) + light + out must fit in the declared payload
+        if (15u + nM + 1 + nS + 1 + 2 > 2u + payloadLen) return false;
+    }
+    out.status = p[4] & 0x07;
+    out.mTargetDistance = p[5] | (p[6] << 8);
+    out.mTargetSignal = p[7];
+    out.sTargetDistance = p[8] | (p[9] << 8);
+    out.sTargetSignal = p[10];
+    out.distance = p[11] | (p[12] << 8);
+    // Basic frames carry no per-gate arrays (N = 0) and no light / out levels
+    out.mTargetSignals.setN(nM);
+    out.sTargetSignals.setN(nS);
+    uint8_t l = 0, o = 0;
+    if (engineering) {
+        const uint8_t *e = p + 15;
+        for (uint8_t i=0;i<=nM;i++) out.mTargetSignals.values[i] = *e++;
+        for (uint8_t i=0;i<=nS;i++) out.sTargetSignals.values[i] = *e++;
+        l = *e++;
+        o = *e++;
+    }
+    if (light) *light = l;
+    if (outPin) *outPin = o;
+    return true;
+}
+
+// Also records p as the last frame when it differs
+bool LD2410Driver::sameAsLast(const uint8_t *p, size_t len) {
+    if (len < 2 + LD2410_BASIC_PAYLOAD + 4) return false;
+    uint16_t payloadLen = p[0] | (p[1] << 8);
+    if (payloadLen + 2u + 4u > len) return false;
+    bool valid = isDataValid();
+    if (payloadLen == LD2410_BASIC_PAYLOAD) {
+        bool same = valid && lastLen == payloadLen && memcmp(lastBasic, p + 2, LD2410_BASIC_PAYLOAD) == 0;
+        if (!same) memcpy(lastBasic, p + 2, LD2410_BASIC_PAYLOAD);
+        lastLen = payloadLen;
+        return same;
     }
-    if (p[2] != 0x02 || p[3] != 0xAA) return false;
+    uint32_t h = 2166136261u;
+    for (uint16_t i = 0; i < payloadLen; i++) h = (h ^ p[2 + i]) * 16777619u;
+    bool same = valid && lastLen == payloadLen && lastHash == h;
+    lastLen = payloadLen;
+    lastHash = h;
+    return same;
+}
 
+bool LD2410Driver::processData() {
+    repeated = skipRepeats && sameAsLast(inBuf, inBufI);
+    if (repeated) {
+        repeatCount++;
+        sData.timestamp = nowMillis();
+        if (frameCb) frameCb(sData, frameCbCtx);
+        return true;
+    }
+    if (!decodeDataFrame(inBuf, inBufI, sData, &lightLevel, &outLevel)) {
+        lastLen = 0;
+        return false;
+    }
     sData.timestamp = nowMillis();
-    sData.status = p[4] & 0x07;
-    sData.mTargetDistance = p[5] | (p[6] << 8);
-    sData.mTargetSignal = p[7];
-    sData.sTargetDistance = p[8] | (p[9] << 8);
-    sData.sTargetSignal = p[10];
-    sData.distance = p[11] | (p[12] << 8);
-    // Basic frame => no per-gate arrays
-    isEnhanced = false;
-    sData.mTargetSignals.setN(0);
-    sData.sTargetSignals.setN(0);
-    // Light / out levels not provided in this frame type
-    lightLevel = 0;
-    outLevel = 0;
+    // Auto-threshold progress is reported in-band; no need to query it
+    if (sData.status >= 4) autoStatus = (sData.status == 4) ? AutoStatus::IN_PROGRESS : (sData.status == 5) ? AutoStatus::COMPLETED : AutoStatus::NOT_IN_PROGRESS;
+    isEnhanced = inBuf[2] == 0x01;
+    if (frameCb) frameCb(sData, frameCbCtx);
     return true;
 }
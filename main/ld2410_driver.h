@@ -10,6 +10,10 @@
 // Baud rate defined by original library
 #define LD2410_BAUD_RATE 256000
 #define LD2410_BUFFER_SIZE 0x40
+// Gate / max-gate parameter command as sendCommand() takes it (length word + payload)
+#define LD2410_PARAM_FRAME 0x16
+// Basic-mode data payload (type .. trailer), compared as is for repeats
+#define LD2410_BASIC_PAYLOAD 13
 
 enum class LightControl : int8_t {
     NOT_SET = -1,
@@ -31,6 +35,17 @@ enum class AutoStatus : int8_t {
     COMPLETED = 2
 };
 
+// Optional command groups, gated by firmware revision (see CAP_TABLE)
+enum LD2410Capability : uint32_t {
+    LD2410_CAP_RESOLUTION      = 1u << 0, // 0xAA/0xAB distance resolution
+    LD2410_CAP_AUX_CONTROL     = 1u << 1, // 0xAD/0xAE light sensor / OUT pin
+    LD2410_CAP_AUTO_THRESHOLDS = 1u << 2, // 0x0B/0x1B auto calibration
+    LD2410_CAP_BLUETOOTH       = 1u << 3, // 0xA4/0xA9 BT on/off, password
+    LD2410_CAP_MAC             = 1u << 4, // 0xA5 BT MAC query
+    LD2410_CAP_ALL             = 0x1Fu,
+    LD2410_CAP_KNOWN           = 1u << 31 // set once built from a firmware reply
+};
+
 class LD2410Driver {
 public:
     enum Response : uint8_t { FAIL = 0, ACK, DATA };
@@ -53,7 +68,24 @@ public:
         ValuesArray sTargetSignals; // Enhanced mode only
     };
 
+    // Command classes with their own round-trip estimate (ACK deadlines)
+    enum RttClass : uint8_t { RTT_CONFIG = 0, RTT_QUERY, RTT_WRITE, RTT_SYSTEM, RTT_CLASSES };
+
+    struct RttStats {
+        uint32_t srtt_us = 0;   // smoothed round trip
+        uint32_t rttvar_us = 0; // smoothed mean deviation
+        uint16_t rto_ms = 0;    // deadline for a first attempt (0 until sampled)
+        uint16_t samples = 0;
+        uint16_t retries = 0;   // commands resent after a lost ACK
+        uint16_t timeouts = 0;  // attempts that got no ACK
+        uint8_t backoff = 0;    // current exponential backoff shift
+    };
+
+    // Invoked from processData() for every decoded data frame
+    typedef void (*FrameCallback)(const SensorData &data, void *ctx);
+
     LD2410Driver(uart_port_t uart_num, bool debug = false);
+    void setFrameCallback(FrameCallback cb, void *ctx) { frameCb = cb; frameCbCtx = ctx; }
 
     // Controls
     bool begin();
@@ -74,6 +106,16 @@ public:
     bool setNoOneWindow(uint8_t noOneWindow);
     bool setMaxMovingGate(uint8_t movingGate);
     bool setMaxStationaryGate(uint8_t stationaryGate);
+    // Parameter writes encoded ahead of time (LD2410_PARAM_FRAME bytes each).
+    // writeParameterFrames() sends them in one config session followed by one
+    // parameter query; false at the first frame that fails.
+    static void encodeGateFrame(uint8_t *out, uint8_t gate, uint8_t movingThreshold, uint8_t stationaryThreshold);
+    static void encodeMaxGateFrame(uint8_t *out, uint8_t movingGate, uint8_t stationaryGate, uint8_t noOneWindow);
+    bool writeParameterFrames(const uint8_t *const *frames, uint8_t count);
+    // Decodes one data frame: p starts after the F4F3F2F1 header (length
+    // bytes first), len covers payload and tail. Fills everything but the
+    // timestamp; false (out untouched) on a malformed frame. Used offline too.
+    static bool decodeDataFrame(const uint8_t *p, size_t len, SensorData &out, uint8_t *light = nullptr, uint8_t *outPin = nullptr);
     bool requestReset();
     bool requestReboot();
     bool requestBTon();
@@ -84,9 +126,58 @@ public:
     bool requestAuxConfig();
     bool autoThresholds(uint8_t timeout_s = 10);
     AutoStatus getAutoStatus();
+    AutoStatus cachedAutoStatus() const { return autoStatus; } // no UART traffic
     bool setAuxControl(LightControl lc, uint8_t light_threshold, OutputControl oc);
     bool resetAuxControl();
 
+    // Capabilities: built once from firmware/config-mode replies. Until then
+    // (or if the firmware never answers) every command is attempted.
+    uint32_t getCapabilities();
+    bool supports(uint32_t cap) const { return !(caps & LD2410_CAP_KNOWN) || (caps & cap) == cap; }
+
+    // What the sensor told us about itself: firmware, protocol, resolution
+    // and gate parameters. A caller that keeps it over an MCU reset the
+    // sensor did not see (no power cut) restores it instead of asking again.
+    // Mode and aux settings are left out: frames show the mode, the aux
+    // getters query on first use. Plain data (no initializers), so it can
+    // live in memory no constructor touches.
+    struct Snapshot {
+        uint8_t firmware[6];   // 0x1A0 reply: minor, major, build (LE)
+        uint16_t version;      // from the enter-config ACK
+        uint16_t bufferSize;
+        int8_t fineRes;
+        uint8_t maxRange;
+        uint8_t noOneWindow;
+        uint8_t movingN, stationaryN; // max gate indexes
+        uint8_t moving[9];
+        uint8_t stationary[9];
+    };
+    // false until the firmware and the parameters were read
+    bool snapshot(Snapshot &out) const;
+    void restore(const Snapshot &s);
+    // Reads all of it again in one config session
+    bool refreshSnapshot();
+
+    // Link recovery (stale-sensor watchdog). forceConfigExit() sends the
+    // exit even when we believe config mode is off (sensor rebooted into it).
+    // scanBaud() finds the rate the sensor answers on, moves it back to
+    // LD2410_BAUD_RATE if it can, and leaves the UART on the working rate;
+    // 0 when nothing answered on any rate.
+    bool forceConfigExit();
+    uint32_t scanBaud();
+    uint32_t framesDecoded() const { return frameCount; }
+
+    // Repeated frames: a data frame identical to the previous one (basic:
+    // the 13 payload bytes; engineering: length + FNV-1a of the payload) only
+    // refreshes the timestamp; decode is skipped and the frame callback sees
+    // frameRepeated(). Frames after the data expired always decode.
+    void setSkipRepeats(bool on) { skipRepeats = on; lastLen = 0; }
+    bool frameRepeated() const { return repeated; }
+    uint32_t framesRepeated() const { return repeatCount; }
+
+    // Command round-trip statistics (srtt + 4 * rttvar, TCP-RTO style)
+    const RttStats &getRttStats(RttClass cls) const { return rtt[cls < RTT_CLASSES ? cls : 0]; }
+
     // Status flags
     bool inConfigMode() const { return isConfig; }
     bool inBasicMode() const { return !isEnhanced; }
@@ -152,7 +243,9 @@ private:
     std::string firmwareStr;
     uint8_t firmwareMajor = 0;
     uint8_t firmwareMinor = 0;
+    uint8_t firmwareRaw[6] = {0};
     int fineRes = -1; // -1 unknown; 0 coarse 75cm; 1 fine 20cm
+    uint32_t caps = 0;
     bool isEnhanced = false;
     bool isConfig = false;
 
@@ -162,9 +255,22 @@ private:
     uint8_t headBuf[4] = {0};
     uint8_t headBufI = 0;
 
+    // Frame observer
+    FrameCallback frameCb = nullptr;
+    void *frameCbCtx = nullptr;
+
     // Timing
-    uint32_t timeout_ms = 2000; // command timeout
     uint32_t dataLifespan_ms = 500; // validity of last data
+    RttStats rtt[RTT_CLASSES];
+    bool ackAccepted = false; // status of the last matched ACK
+    uint32_t frameCount = 0;  // data frames decoded
+    // Fingerprint of the last data frame (lastLen 0 = none)
+    bool skipRepeats = true;
+    bool repeated = false;
+    uint16_t lastLen = 0;
+    uint32_t lastHash = 0;
+    uint8_t lastBasic[LD2410_BASIC_PAYLOAD] = {0};
+    uint32_t repeatCount = 0;
 
     // Helpers
     bool isDataValid() const;
@@ -172,8 +278,17 @@ private:
     bool readFrame();
     bool processAck();
     bool processData();
+    bool sameAsLast(const uint8_t *p, size_t len);
     uint32_t nowMillis() const; // wrapper around esp_timer
     void debugHex(const uint8_t *buf, size_t len, const char *prefix = nullptr);
     std::string byteToHex(uint8_t b, bool addZero = true) const;
-    bool waitForAck(const uint8_t *expectedCmdIds = nullptr, size_t count = 0, uint32_t giveUpAt = 0);
+    void buildCapabilities();
+    void setFirmware(const uint8_t *raw);
+    // expectedAck 0: return on any ACK or data frame; otherwise only on that ACK id
+    bool waitForAck(uint16_t expectedAck, uint32_t giveUpAt);
+    // Send + wait with adaptive deadline and retries; false on timeout or NAK
+    bool transact(const uint8_t *cmd, RttClass cls);
+    uint16_t rttDeadline(RttClass cls) const;
+    bool probeBaud(uint32_t rate, uint32_t listenMs);
+    void addRttSample(RttClass cls, uint32_t us);
 };
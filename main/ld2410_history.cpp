@@ -0,0 +1,345 @@
+#include "ld2410_history.h"
+#include <cstring>
+
+static_assert(LD2410_HISTORY_BLOCK_SIZE >= 5 + 3 * 4 + 3 * LD2410_HIST_CHANNELS * 3, "history block too small for one record");
+static_assert(LD2410_HIST_CHANNELS <= 28, "changed-slot mask must fit a 4-byte varint");
+
+static const uint32_t TICK_MS[LD2410_HISTORY_TIERS]     = {100, 1000, 60000};
+static const uint32_t WINDOW_TICKS[LD2410_HISTORY_TIERS] = {600, 3600, 0};
+// Span the ring should hold; below it the aggregate tiers degrade
+static const uint32_t TARGET_TICKS[LD2410_HISTORY_TIERS] = {600, 3600, 1440};
+static const uint8_t LEVELS[LD2410_HISTORY_TIERS]        = {1, LD2410_HISTORY_LEVELS, LD2410_HISTORY_LEVELS};
+
+// Pace check at every block opened, over the last LOOKBACK blocks. SPARE
+// blocks of the ring are not counted on: the open one and the one holding
+// the window start.
+#define LEVEL_LOOKBACK 4
+#define LEVEL_SPARE 2
+
+#define SIGNALS_DISTANCE ((1u << LD2410_HIST_MOVING_SIGNAL) | (1u << LD2410_HIST_STATIONARY_SIGNAL) | (1u << LD2410_HIST_DISTANCE))
+#define MOVING_GATES (((1u << 9) - 1) << LD2410_HIST_MOVING_GATE0)
+#define STATIONARY_GATES (((1u << 9) - 1) << LD2410_HIST_STATIONARY_GATE0)
+
+// Slots the aggregate tiers keep per level, per group (min, mean, max); the
+// others stay 0. Flags keep their mean (share of the interval), gate
+// energies their max, the moving and stationary distances their mean: while
+// someone walks these all change every second. Each level up drops more of
+// them, stationary gates first, and doubles the deadbands; the last keeps
+// only the flags and the mean distance.
+static const uint32_t AGGREGATE_KEPT[LD2410_HISTORY_LEVELS][3] = {
+    {1u << LD2410_HIST_DISTANCE, (1u << LD2410_HIST_MOVING_GATE0) - 1, SIGNALS_DISTANCE | MOVING_GATES | STATIONARY_GATES},
+    {1u << LD2410_HIST_DISTANCE, (1u << LD2410_HIST_MOVING_GATE0) - 1, SIGNALS_DISTANCE | MOVING_GATES},
+    {1u << LD2410_HIST_DISTANCE, (1u << LD2410_HIST_MOVING_GATE0) - 1, SIGNALS_DISTANCE},
+    {0, 7u | (1u << LD2410_HIST_DISTANCE), 0},
+};
+
+// Aggregate slots hold until they move by at least this much. Gate energies
+// jitter by a few units and distances by a gate from frame to frame; written
+// out exactly, that noise changed most slots every second.
+static const uint8_t AGGREGATE_DEADBAND[LD2410_HIST_CHANNELS] = {
+    1, 1, 1,                   // occupied / moving / stationary %
+    20, 5, 20, 5, 20,          // distances cm, signals
+    5, 5, 5, 5, 5, 5, 5, 5, 5, // moving gates
+    5, 5, 5, 5, 5, 5, 5, 5, 5, // stationary gates
+};
+
+static uint8_t *putVarint(uint8_t *p, uint32_t v) {
+    while (v >= 0x80) { *p++ = (uint8_t)(v | 0x80); v >>= 7; }
+    *p++ = (uint8_t)v;
+    return p;
+}
+
+static uint8_t *putLE32(uint8_t *p, uint32_t v) {
+    p[0] = (uint8_t)v; p[1] = (uint8_t)(v >> 8); p[2] = (uint8_t)(v >> 16); p[3] = (uint8_t)(v >> 24);
+    return p + 4;
+}
+
+static uint8_t *putLE16(uint8_t *p, uint16_t v) {
+    p[0] = (uint8_t)v; p[1] = (uint8_t)(v >> 8);
+    return p + 2;
+}
+
+LD2410History::LD2410History() {
+    tiers[0].storage = tier0Storage; tiers[0].meta = tier0Meta; tiers[0].blocks = LD2410_HISTORY_TIER0_BLOCKS; tiers[0].groups = 1;
+    tiers[0].deadband = nullptr;
+    tiers[1].storage = tier1Storage; tiers[1].meta = tier1Meta; tiers[1].blocks = LD2410_HISTORY_TIER1_BLOCKS; tiers[1].groups = 3;
+    tiers[1].deadband = AGGREGATE_DEADBAND;
+    tiers[2].storage = tier2Storage; tiers[2].meta = tier2Meta; tiers[2].blocks = LD2410_HISTORY_TIER2_BLOCKS; tiers[2].groups = 3;
+    tiers[2].deadband = AGGREGATE_DEADBAND;
+    for (uint8_t t = 0; t < LD2410_HISTORY_TIERS; t++) {
+        tiers[t].tickMs = TICK_MS[t];
+        tiers[t].windowTicks = WINDOW_TICKS[t];
+        tiers[t].targetTicks = TARGET_TICKS[t];
+        tiers[t].levels = LEVELS[t];
+    }
+    clear();
+}
+
+void LD2410History::clear() {
+    for (uint8_t t = 0; t < LD2410_HISTORY_TIERS; t++) {
+        Tier &tr = tiers[t];
+        tr.nextSeq = 0;
+        tr.open = false;
+        tr.gap = true;
+        tr.level = 0;
+        tr.lastTick = 0;
+        memset(tr.prev, 0, sizeof(tr.prev));
+        for (uint16_t i = 0; i < tr.blocks; i++) tr.meta[i] = BlockMeta();
+        acc[t].n = 0;
+    }
+    haveRaw = false;
+    dropped = 0;
+}
+
+void LD2410History::addSample(uint32_t now_ms, const Sample &s) {
+    // Tier 0: first sample of every 100 ms tick
+    uint32_t tick = now_ms / tiers[0].tickMs;
+    if (!haveRaw || tick != rawTick) {
+        appendRecord(0, tick, s.v, false);
+        rawTick = tick;
+        haveRaw = true;
+    }
+    for (uint8_t t = 1; t < LD2410_HISTORY_TIERS; t++) accumulate(t, now_ms / tiers[t].tickMs, s);
+}
+
+void LD2410History::markGap(uint32_t now_ms) {
+    for (uint8_t t = 1; t < LD2410_HISTORY_TIERS; t++) flushAccumulator(t);
+    for (uint8_t t = 0; t < LD2410_HISTORY_TIERS; t++) appendRecord(t, now_ms / tiers[t].tickMs, nullptr, true);
+    haveRaw = false;
+}
+
+void LD2410History::accumulate(uint8_t t, uint32_t tick, const Sample &s) {
+    Accumulator &a = acc[t];
+    if (a.n && tick != a.tick) flushAccumulator(t);
+    if (!a.n) {
+        a.tick = tick;
+        for (uint8_t c = 0; c < LD2410_HIST_CHANNELS; c++) { a.mn[c] = s.v[c]; a.mx[c] = s.v[c]; a.sum[c] = s.v[c]; }
+        a.n = 1;
+        return;
+    }
+    for (uint8_t c = 0; c < LD2410_HIST_CHANNELS; c++) {
+        uint16_t v = s.v[c];
+        if (v < a.mn[c]) a.mn[c] = v;
+        if (v > a.mx[c]) a.mx[c] = v;
+        a.sum[c] += v;
+    }
+    a.n++;
+}
+
+void LD2410History::flushAccumulator(uint8_t t) {
+    Accumulator &a = acc[t];
+    if (!a.n) return;
+    uint16_t slots[3 * LD2410_HIST_CHANNELS];
+    for (uint8_t c = 0; c < LD2410_HIST_CHANNELS; c++) {
+        slots[c] = a.mn[c];
+        slots[LD2410_HIST_CHANNELS + c] = (uint16_t)((a.sum[c] + a.n / 2) / a.n);
+        slots[2 * LD2410_HIST_CHANNELS + c] = a.mx[c];
+    }
+    appendRecord(t, a.tick, slots, false);
+    a.n = 0;
+}
+
+uint16_t LD2410History::deadband(uint8_t tier, uint8_t level, uint16_t slot) {
+    if (!tier || tier >= LD2410_HISTORY_TIERS) return 1;
+    if (slot >= 3 * LD2410_HIST_CHANNELS || level >= LD2410_HISTORY_LEVELS) return 0;
+    uint8_t c = slot % LD2410_HIST_CHANNELS;
+    return ((AGGREGATE_KEPT[level][slot / LD2410_HIST_CHANNELS] >> c) & 1) ? (uint16_t)(AGGREGATE_DEADBAND[c] << level) : 0;
+}
+
+bool LD2410History::changed(const Tier &tr, uint16_t slot, uint16_t v) {
+    uint16_t old = tr.prev[slot];
+    uint16_t d = v > old ? v - old : old - v;
+    return d && d >= (tr.deadband ? tr.deadband[slot % LD2410_HIST_CHANNELS] << tr.level : 1);
+}
+
+void LD2410History::keep(const Tier &tr, const uint16_t *slots, uint16_t *out) {
+    if (!tr.deadband) {
+        memcpy(out, slots, tr.groups * LD2410_HIST_CHANNELS * sizeof(uint16_t));
+        return;
+    }
+    for (uint16_t i = 0; i < tr.groups * LD2410_HIST_CHANNELS; i++) {
+        out[i] = ((AGGREGATE_KEPT[tr.level][i / LD2410_HIST_CHANNELS] >> (i % LD2410_HIST_CHANNELS)) & 1) ? slots[i] : 0;
+    }
+}
+
+size_t LD2410History::encodeRecord(const Tier &tr, uint32_t dt, const uint16_t *slots, bool gap, uint8_t *out) const {
+    uint8_t *p = putVarint(out, (dt << 1) | (gap ? 1u : 0u));
+    if (gap) return p - out;
+    for (uint8_t g = 0; g < tr.groups; g++) {
+        uint32_t mask = 0;
+        for (uint8_t c = 0; c < LD2410_HIST_CHANNELS; c++) {
+            uint16_t i = g * LD2410_HIST_CHANNELS + c;
+            mask |= (uint32_t)changed(tr, i, slots[i]) << c;
+        }
+        p = putVarint(p, mask);
+    }
+    for (uint16_t i = 0; i < tr.groups * LD2410_HIST_CHANNELS; i++) {
+        if (!changed(tr, i, slots[i])) continue;
+        int32_t d = (int32_t)slots[i] - (int32_t)tr.prev[i];
+        p = putVarint(p, ((uint32_t)d << 1) ^ (uint32_t)(d >> 31));
+    }
+    return p - out;
+}
+
+void LD2410History::openBlock(Tier &tr, uint32_t tick) {
+    if (tr.nextSeq >= tr.blocks) dropped++;
+    if (tr.levels > 1 && tr.nextSeq) tr.level = paceLevel(tr, tick);
+    BlockMeta &m = tr.meta[tr.nextSeq % tr.blocks];
+    m.seq = tr.nextSeq++;
+    m.startTick = tick;
+    m.endTick = tick;
+    m.used = 0;
+    m.level = tr.level;
+    tr.open = true;
+    tr.lastTick = tick;
+    memset(tr.prev, 0, sizeof(tr.prev)); // keyframe: first record encodes against zero
+}
+
+// Level for the block opened at tick. Block i of those inside the target
+// span (oldest first) leaves it at startTick + target; until then at most
+// free + i new blocks fit, free being what the span leaves of the ring. The
+// tightest of these is the pace blocks must keep: the level goes up while
+// the last blocks were quicker, down once they last twice as long. Only
+// once the span fills half the ring: a short burst (a walk across the
+// room) spends the other half, and the level drops back once it ages out.
+uint8_t LD2410History::paceLevel(const Tier &tr, uint32_t tick) const {
+    uint32_t room = tr.blocks - LEVEL_SPARE;
+    uint32_t s = firstSeq(tr);
+    while (s < tr.nextSeq && metaFor(tr, s).startTick + tr.targetTicks <= tick) s++;
+    uint32_t inSpan = tr.nextSeq - s;
+    if (inSpan + LEVEL_LOOKBACK >= room) return tr.levels - 1;
+    uint32_t free = room - inSpan;
+    uint32_t need = tr.targetTicks / room; // ticks per block
+    for (uint32_t i = 0; s + i < tr.nextSeq; i++) {
+        uint32_t left = metaFor(tr, s + i).startTick + tr.targetTicks - tick;
+        uint32_t n = (left + free + i - 1) / (free + i);
+        if (n > need) need = n;
+    }
+    uint32_t k = tr.nextSeq < LEVEL_LOOKBACK ? tr.nextSeq : LEVEL_LOOKBACK;
+    uint32_t covered = tick - metaFor(tr, tr.nextSeq - k).startTick;
+    bool pressed = 2 * inSpan >= room;
+    if (pressed && covered < k * need) return tr.level + 1 < tr.levels ? tr.level + 1 : tr.level;
+    if ((!pressed || covered >= 2 * k * need) && tr.level) return tr.level - 1;
+    return tr.level;
+}
+
+void LD2410History::appendRecord(uint8_t t, uint32_t tick, const uint16_t *in, bool gap) {
+    Tier &tr = tiers[t];
+    size_t n = tr.groups * LD2410_HIST_CHANNELS;
+    if (gap && tr.gap) return;
+    uint16_t slots[3 * LD2410_HIST_CHANNELS];
+    if (!gap) keep(tr, in, slots);
+    if (!gap && tr.open && !tr.gap) {
+        size_t i = 0;
+        while (i < n && !changed(tr, (uint16_t)i, slots[i])) i++;
+        if (i == n) return; // hold
+    }
+    if (tick < tr.lastTick) tick = tr.lastTick;
+
+    uint8_t rec[LD2410_HISTORY_BLOCK_SIZE];
+    size_t len = 0;
+    if (tr.open) {
+        len = encodeRecord(tr, tick - tr.lastTick, slots, gap, rec);
+        if (tr.meta[(tr.nextSeq - 1) % tr.blocks].used + len > LD2410_HISTORY_BLOCK_SIZE) tr.open = false;
+    }
+    if (!tr.open) {
+        openBlock(tr, tick);
+        if (!gap) keep(tr, in, slots); // the new block's level
+        len = encodeRecord(tr, 0, slots, gap, rec);
+    }
+    BlockMeta &m = tr.meta[(tr.nextSeq - 1) % tr.blocks];
+    memcpy(tr.storage + (size_t)((tr.nextSeq - 1) % tr.blocks) * LD2410_HISTORY_BLOCK_SIZE + m.used, rec, len);
+    m.used += len;
+    m.endTick = tick;
+    tr.lastTick = tick;
+    tr.gap = gap;
+    if (gap) return;
+    // Slots inside their deadband keep the value the decoder holds
+    for (size_t i = 0; i < n; i++) {
+        if (changed(tr, (uint16_t)i, slots[i])) tr.prev[i] = slots[i];
+    }
+}
+
+uint32_t LD2410History::firstSeq(const Tier &tr) const {
+    return (tr.nextSeq > tr.blocks) ? tr.nextSeq - tr.blocks : 0;
+}
+
+uint32_t LD2410History::firstExportSeq(const Tier &tr, uint32_t now_ms) const {
+    if (!tr.nextSeq) return 0;
+    uint32_t nowTick = now_ms / tr.tickMs;
+    uint32_t cutoff = (tr.windowTicks && nowTick > tr.windowTicks) ? nowTick - tr.windowTicks : 0;
+    // From the block holding the values at the cutoff: a quiet room writes
+    // nothing, so that block can have started long before it
+    uint32_t s = firstSeq(tr);
+    while (s < tr.nextSeq - 1 && metaFor(tr, s + 1).startTick <= cutoff) s++;
+    return s; // the newest block is always exported: it holds the current values
+}
+
+size_t LD2410History::exportSize(uint32_t now_ms) const {
+    size_t total = headerSize();
+    for (uint8_t t = 0; t < LD2410_HISTORY_TIERS; t++) {
+        const Tier &tr = tiers[t];
+        for (uint32_t s = firstExportSeq(tr, now_ms); s < tr.nextSeq; s++) total += 7 + metaFor(tr, s).used;
+    }
+    return total;
+}
+
+void LD2410History::beginExport(Cursor &c, uint32_t now_ms) const {
+    uint8_t *p = c.stage;
+    memcpy(p, "LDH1", 4); p += 4;
+    *p++ = 3;
+    *p++ = LD2410_HIST_CHANNELS;
+    *p++ = LD2410_HISTORY_TIERS;
+    *p++ = 0;
+    p = putLE32(p, now_ms);
+    for (uint8_t t = 0; t < LD2410_HISTORY_TIERS; t++) {
+        const Tier &tr = tiers[t];
+        c.nextSeq[t] = firstExportSeq(tr, now_ms);
+        c.endSeq[t] = tr.nextSeq;
+        c.lastUsed[t] = tr.nextSeq ? metaFor(tr, tr.nextSeq - 1).used : 0;
+        p = putLE32(p, tr.tickMs);
+        p = putLE16(p, (uint16_t)(c.endSeq[t] - c.nextSeq[t]));
+        p = putLE16(p, tr.groups);
+    }
+    c.stageLen = (uint16_t)(p - c.stage);
+    c.stageOff = 0;
+    c.tier = 0;
+    c.done = false;
+}
+
+size_t LD2410History::readExport(Cursor &c, uint8_t *out, size_t cap) const {
+    size_t n = 0;
+    while (n < cap && !c.done) {
+        if (c.stageOff < c.stageLen) {
+            size_t k = c.stageLen - c.stageOff;
+            if (k > cap - n) k = cap - n;
+            memcpy(out + n, c.stage + c.stageOff, k);
+            c.stageOff += k;
+            n += k;
+            continue;
+        }
+        while (c.tier < LD2410_HISTORY_TIERS && c.nextSeq[c.tier] >= c.endSeq[c.tier]) c.tier++;
+        if (c.tier >= LD2410_HISTORY_TIERS) { c.done = true; break; }
+        const Tier &tr = tiers[c.tier];
+        uint32_t s = c.nextSeq[c.tier]++;
+        const BlockMeta &m = metaFor(tr, s);
+        uint8_t *p = c.stage;
+        if (m.seq != s) {
+            // Evicted since beginExport: keep the promised block count, send it empty
+            p = putLE32(p, 0);
+            p = putLE16(p, 0);
+            *p++ = 0;
+        } else {
+            uint16_t used = m.used;
+            if (s + 1 == c.endSeq[c.tier] && used > c.lastUsed[c.tier]) used = c.lastUsed[c.tier];
+            p = putLE32(p, m.startTick);
+            p = putLE16(p, used);
+            *p++ = m.level;
+            memcpy(p, tr.storage + (size_t)(s % tr.blocks) * LD2410_HISTORY_BLOCK_SIZE, used);
+            p += used;
+        }
+        c.stageLen = (uint16_t)(p - c.stage);
+        c.stageOff = 0;
+    }
+    return n;
+}
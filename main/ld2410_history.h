@@ -0,0 +1,179 @@
+// Fixed-memory, multi-tier time-series history of LD2410 frames, exported
+// as a Matter diagnostic log (BDX transfer).
+//
+// Tiers (each a ring of fixed-size blocks, oldest block evicted first):
+//   0: raw samples at 10 Hz (100 ms ticks), exported window 60 s
+//   1: 1 s min/mean/max aggregates, exported window 1 h
+//   2: 1 min min/mean/max aggregates, whatever fits in the ring (~1 day)
+// Retention is bounded by the ring size: about 44 KB in all. The rings are
+// sized from what host/history_sim measures with engineering mode on all
+// day: 60 s of raw samples take up to 64 blocks of tier 0's 72. Tiers 1 and
+// 2 hold their span (1 h, 1 day) by degrading instead: when the blocks
+// written lately would push the start of the span out of the ring, new
+// blocks go up a level (below) until the pace fits, and back down once it
+// has room again. Someone at a desk who gets up now and then costs under a
+// tenth of tier 1's blocks a level; nonstop walking runs at level 2-3.
+//
+// Records are delta + varint compressed against the previous record of the
+// same block; the first record of every block is a keyframe (delta vs 0), so
+// blocks decode independently. A record is only written when at least one
+// slot changed, so a quiet room costs (almost) nothing: the decoder holds the
+// last values until the next record.
+//
+// Record encoding:
+//   varint (dtTicks << 1 | gap)      ticks since previous record in the block
+//   if !gap:
+//     groups x varint(changedMask)  one 26-bit mask per slot group
+//     zigzag varint delta           for every changed slot, in slot order
+// A gap record marks "no valid sensor data from this tick on".
+// Tier 0 has one slot group (the channels), kept exactly. Tiers 1 and 2
+// have three (min, mean, max of every channel) but keep only some of them,
+// the rest read 0; which ones depends on the block's level:
+//   level  min       mean                         max
+//   0      distance  flags, distances, signals    signals, distance, every gate
+//   1      distance  flags, distances, signals    signals, distance, moving gates
+//   2      distance  flags, distances, signals    signals, distance
+//   3      -         flags, distance              -
+// and count a slot as changed only once it has moved by the channel's
+// deadband (1 for flags, 20 cm, 5 for signals and gates, doubled per level)
+// from the value last written: the decoder holds that value, off by less
+// than the deadband. LD2410History::deadband() has both per level and slot.
+//
+// Export stream (little endian):
+//   "LDH1" u8 version(3) u8 channels u8 tiers u8 reserved u32 nowMs
+//   tiers x { u32 tickMs u16 blockCount u16 groups }
+//   then per tier, oldest first, blockCount x { u32 startTick u16 used u8 level, used bytes }
+// The first block of a windowed tier holds the values at the window start.
+// A block evicted while the log is being transferred is sent with used = 0.
+// Version 1 kept every aggregate slot exactly, version 2 had no levels.
+#pragma once
+#include <cstdint>
+#include <cstddef>
+
+#ifndef LD2410_HISTORY_BLOCK_SIZE
+#define LD2410_HISTORY_BLOCK_SIZE 256
+#endif
+#ifndef LD2410_HISTORY_TIER0_BLOCKS
+#define LD2410_HISTORY_TIER0_BLOCKS 72 // 18 KB
+#endif
+#ifndef LD2410_HISTORY_TIER1_BLOCKS
+#define LD2410_HISTORY_TIER1_BLOCKS 64 // 16 KB
+#endif
+#ifndef LD2410_HISTORY_TIER2_BLOCKS
+#define LD2410_HISTORY_TIER2_BLOCKS 24 // 6 KB
+#endif
+
+#define LD2410_HISTORY_TIERS 3
+#define LD2410_HISTORY_LEVELS 4 // aggregate tiers: 0 full .. 3 flags and distance only
+
+// Channel layout of a sample. Flags are stored as 0/100 so the 1 s / 1 min
+// mean reads directly as a percentage.
+enum LD2410HistoryChannel : uint8_t {
+    LD2410_HIST_OCCUPIED = 0,
+    LD2410_HIST_MOVING,
+    LD2410_HIST_STATIONARY,
+    LD2410_HIST_MOVING_DIST,
+    LD2410_HIST_MOVING_SIGNAL,
+    LD2410_HIST_STATIONARY_DIST,
+    LD2410_HIST_STATIONARY_SIGNAL,
+    LD2410_HIST_DISTANCE,
+    LD2410_HIST_MOVING_GATE0,                          // 9 gates
+    LD2410_HIST_STATIONARY_GATE0 = LD2410_HIST_MOVING_GATE0 + 9, // 9 gates
+    LD2410_HIST_CHANNELS = LD2410_HIST_STATIONARY_GATE0 + 9
+};
+
+class LD2410History {
+public:
+    struct Sample {
+        uint16_t v[LD2410_HIST_CHANNELS] = {0};
+    };
+
+    // Streaming export state. One block is staged at a time, so eviction
+    // during a transfer never tears a block.
+    struct Cursor {
+        uint8_t stage[7 + LD2410_HISTORY_BLOCK_SIZE];
+        uint16_t stageLen = 0;
+        uint16_t stageOff = 0;
+        uint8_t tier = 0;
+        bool done = true;
+        uint32_t nextSeq[LD2410_HISTORY_TIERS] = {0};
+        uint32_t endSeq[LD2410_HISTORY_TIERS] = {0};   // exclusive
+        uint16_t lastUsed[LD2410_HISTORY_TIERS] = {0}; // fill of the open block at begin
+    };
+
+    LD2410History();
+
+    void addSample(uint32_t now_ms, const Sample &s);
+    void markGap(uint32_t now_ms); // sensor data became invalid
+    void clear();
+
+    size_t exportSize(uint32_t now_ms) const;
+    void beginExport(Cursor &c, uint32_t now_ms) const;
+    size_t readExport(Cursor &c, uint8_t *out, size_t cap) const; // c.done once finished
+
+    uint32_t droppedBlocks() const { return dropped; }
+    // Smallest change of a slot (group * LD2410_HIST_CHANNELS + channel) that
+    // a block of the tier at the level writes out: 1 = exact, 0 = not kept
+    // (always 0)
+    static uint16_t deadband(uint8_t tier, uint8_t level, uint16_t slot);
+
+private:
+    struct BlockMeta {
+        uint32_t seq = 0;
+        uint32_t startTick = 0;
+        uint32_t endTick = 0;
+        uint16_t used = 0;
+        uint8_t level = 0;
+    };
+
+    struct Tier {
+        uint8_t *storage;      // blocks * LD2410_HISTORY_BLOCK_SIZE
+        BlockMeta *meta;
+        uint16_t blocks;
+        uint8_t groups;        // slot groups (1 raw, 3 aggregated)
+        const uint8_t *deadband; // per channel, nullptr = exact
+        uint32_t tickMs;
+        uint32_t windowTicks;  // 0 = no export cutoff
+        uint32_t targetTicks;  // span the ring should hold
+        uint8_t levels;        // 1 = never degrades
+        uint8_t level = 0;     // of the open block
+        uint32_t nextSeq = 0;  // seq of the block that will be opened next
+        bool open = false;     // a block is currently being written
+        bool gap = true;       // last record was a gap (or nothing written yet)
+        uint32_t lastTick = 0; // tick of the last record in the open block
+        uint16_t prev[3 * LD2410_HIST_CHANNELS] = {0};
+    };
+
+    struct Accumulator {
+        uint16_t mn[LD2410_HIST_CHANNELS];
+        uint16_t mx[LD2410_HIST_CHANNELS];
+        uint32_t sum[LD2410_HIST_CHANNELS];
+        uint32_t n = 0;
+        uint32_t tick = 0;
+    };
+
+    uint8_t tier0Storage[LD2410_HISTORY_TIER0_BLOCKS * LD2410_HISTORY_BLOCK_SIZE];
+    uint8_t tier1Storage[LD2410_HISTORY_TIER1_BLOCKS * LD2410_HISTORY_BLOCK_SIZE];
+    uint8_t tier2Storage[LD2410_HISTORY_TIER2_BLOCKS * LD2410_HISTORY_BLOCK_SIZE];
+    BlockMeta tier0Meta[LD2410_HISTORY_TIER0_BLOCKS];
+    BlockMeta tier1Meta[LD2410_HISTORY_TIER1_BLOCKS];
+    BlockMeta tier2Meta[LD2410_HISTORY_TIER2_BLOCKS];
+    Tier tiers[LD2410_HISTORY_TIERS];
+    Accumulator acc[LD2410_HISTORY_TIERS]; // [0] unused
+    bool haveRaw = false;
+    uint32_t rawTick = 0;
+    uint32_t dropped = 0;
+
+    void accumulate(uint8_t t, uint32_t tick, const Sample &s);
+    void flushAccumulator(uint8_t t);
+    void appendRecord(uint8_t t, uint32_t tick, const uint16_t *slots, bool gap);
+    size_t encodeRecord(const Tier &tr, uint32_t dt, const uint16_t *slots, bool gap, uint8_t *out) const;
+    static bool changed(const Tier &tr, uint16_t slot, uint16_t v);
+    static void keep(const Tier &tr, const uint16_t *slots, uint16_t *out);
+    void openBlock(Tier &tr, uint32_t tick);
+    uint8_t paceLevel(const Tier &tr, uint32_t tick) const;
+    uint32_t firstSeq(const Tier &tr) const;
+    uint32_t firstExportSeq(const Tier &tr, uint32_t now_ms) const;
+    const BlockMeta &metaFor(const Tier &tr, uint32_t seq) const { return tr.meta[seq % tr.blocks]; }
+    size_t headerSize() const { return 12 + 8 * LD2410_HISTORY_TIERS; }
+};
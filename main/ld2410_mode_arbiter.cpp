@@ -0,0 +1,38 @@
+#include "ld2410_mode_arbiter.h"
+
+void LD2410ModeArbiter::reset(uint32_t now_ms) {
+    lastMs = now_ms;
+    releasedMs = now_ms;
+    attempted = false;
+}
+
+bool LD2410ModeArbiter::update(uint32_t now_ms, uint8_t demand, bool engineering) {
+    (current ? st.engineeringMs : st.basicMs) += now_ms - lastMs;
+    lastMs = now_ms;
+    current = engineering;
+    if (want && !demand) releasedMs = now_ms;
+    want = demand;
+    // Stay in engineering mode for the idle time after the last demand
+    bool target = demand || (engineering && now_ms - releasedMs < prm.idleMs);
+    // A switch that did not take (failed, or the frames still show the old
+    // mode) is tried again after retryMs, not on every frame
+    if (target != engineering && attempted && target == attemptTarget && now_ms - attemptMs < prm.retryMs) return engineering;
+    return target;
+}
+
+void LD2410ModeArbiter::switched(uint32_t now_ms, bool ok, uint32_t cost_ms) {
+    st.switchMs += cost_ms;
+    st.lastSwitchMs = cost_ms;
+    // The config session counts toward the mode that was left
+    (current ? st.engineeringMs : st.basicMs) += now_ms - lastMs;
+    lastMs = now_ms;
+    attempted = true;
+    attemptTarget = !current;
+    attemptMs = now_ms;
+    if (ok) {
+        st.switches++;
+        current = !current;
+    } else {
+        st.failures++;
+    }
+}
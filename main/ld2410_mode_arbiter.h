@@ -0,0 +1,63 @@
+// Engineering mode on demand.
+//
+// Engineering frames carry the per-gate energies but are about twice as long
+// as basic frames, and every switch costs a config session during which no
+// frames arrive. Consumers of gate data raise demand bits; the sensor runs in
+// engineering mode while any bit is set and drops back to basic mode idleMs
+// after the last one cleared, so short gaps in demand do not flap the mode.
+// A switch that failed or did not take is retried after retryMs.
+//
+// Pure state machine: the caller runs the switch and reports switched().
+#pragma once
+#include <cstdint>
+
+class LD2410ModeArbiter {
+public:
+    enum Demand : uint8_t {
+        DEMAND_ZONES        = 1u << 0, // zones evaluating someone in the room
+        DEMAND_SUBSCRIPTION = 1u << 1, // a subscription covers the gate signal attributes
+        DEMAND_CALIBRATION  = 1u << 2, // auto thresholds running
+        DEMAND_APP          = 1u << 3, // application request (ld2410c_set_gate_demand)
+    };
+
+    struct Params {
+        uint32_t idleMs = 30000;
+        uint32_t retryMs = 5000;
+    };
+
+    struct Stats {
+        uint32_t switches = 0;       // mode changes that succeeded
+        uint32_t failures = 0;
+        uint32_t switchMs = 0;       // config-mode time of all switch attempts
+        uint32_t lastSwitchMs = 0;
+        uint64_t engineeringMs = 0;  // time in each mode
+        uint64_t basicMs = 0;
+    };
+
+    LD2410ModeArbiter() {}
+    explicit LD2410ModeArbiter(const Params &p) : prm(p) {}
+
+    void setParams(const Params &p) { prm = p; }
+    const Params &params() const { return prm; }
+    void reset(uint32_t now_ms);
+
+    // Current demand and sensor mode; returns the mode to switch to, or the
+    // current one when nothing is to be done
+    bool update(uint32_t now_ms, uint8_t demand, bool engineering);
+    // The switch handed out by update() ran for cost_ms
+    void switched(uint32_t now_ms, bool ok, uint32_t cost_ms);
+
+    uint8_t demand() const { return want; }
+    const Stats &stats() const { return st; }
+
+private:
+    Params prm;
+    Stats st;
+    uint8_t want = 0;
+    uint32_t lastMs = 0;      // time accounted up to here
+    uint32_t releasedMs = 0;  // demand went to 0
+    uint32_t attemptMs = 0;   // last switch
+    bool attemptTarget = false;
+    bool attempted = false;
+    bool current = false;     // mode at the last update()
+};
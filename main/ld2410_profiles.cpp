@@ -0,0 +1,104 @@
+#include "ld2410_profiles.h"
+#include "nvs.h"
+#include <cstdio>
+#include <cstring>
+
+static const char *NVS_NS = "ld2410_prof";
+static const char *NVS_ACTIVE = "active";
+
+static void slot_key(uint8_t slot, char *key) { snprintf(key, 8, "slot%u", slot); }
+
+bool LD2410Profiles::set(uint8_t slot, const LD2410Profile &p) {
+    if (slot >= LD2410_PROFILE_MAX) return false;
+    slots[slot] = p;
+    slots[slot].name[LD2410_PROFILE_NAME_LEN - 1] = 0;
+    encode(slot);
+    // The sensor may hold the old contents of the active slot
+    if (slot == current) current = LD2410_PROFILE_NONE;
+    return true;
+}
+
+const LD2410Profile *LD2410Profiles::get(uint8_t slot) const {
+    return slot < LD2410_PROFILE_MAX && slots[slot].name[0] ? &slots[slot] : nullptr;
+}
+
+void LD2410Profiles::encode(uint8_t slot) {
+    const LD2410Profile &p = slots[slot];
+    for (uint8_t g = 0; g < 9; g++) LD2410Driver::encodeGateFrame(frames[slot][g], g, p.moving[g], p.stationary[g]);
+    LD2410Driver::encodeMaxGateFrame(frames[slot][9], p.maxMovingGate, p.maxStationaryGate, p.noOneWindow);
+}
+
+uint8_t LD2410Profiles::plan(uint8_t slot, const uint8_t **out) const {
+    if (!get(slot)) return 0;
+    uint8_t n = 0;
+    for (uint8_t f = 0; f < LD2410_PROFILE_FRAMES; f++) {
+        if ((known >> f) & 1 && memcmp(sensor[f], frames[slot][f], LD2410_PARAM_FRAME) == 0) continue;
+        if (out) out[n] = frames[slot][f];
+        n++;
+    }
+    return n;
+}
+
+void LD2410Profiles::applied(uint8_t slot) {
+    if (!get(slot)) return;
+    memcpy(sensor, frames[slot], sizeof(sensor));
+    known = (1u << LD2410_PROFILE_FRAMES) - 1;
+    current = slot;
+}
+
+void LD2410Profiles::sensorParams(const LD2410Driver::ValuesArray &moving, const LD2410Driver::ValuesArray &stationary, uint8_t noOneWindow) {
+    known = 0;
+    for (uint8_t g = 0; g <= moving.N && g <= stationary.N; g++) {
+        LD2410Driver::encodeGateFrame(sensor[g], g, moving.values[g], stationary.values[g]);
+        known |= 1u << g;
+    }
+    LD2410Driver::encodeMaxGateFrame(sensor[9], moving.N, stationary.N, noOneWindow);
+    known |= 1u << 9;
+    // Active is whichever slot the read-back matches (the old one first)
+    if (current != LD2410_PROFILE_NONE && plan(current, nullptr) == 0) return;
+    current = LD2410_PROFILE_NONE;
+    for (uint8_t s = 0; s < LD2410_PROFILE_MAX && current == LD2410_PROFILE_NONE; s++) {
+        if (get(s) && plan(s, nullptr) == 0) current = s;
+    }
+}
+
+void LD2410Profiles::invalidate() {
+    known = 0;
+    current = LD2410_PROFILE_NONE;
+}
+
+uint8_t LD2410Profiles::load() {
+    nvs_handle_t h;
+    if (nvs_open(NVS_NS, NVS_READONLY, &h) != ESP_OK) return LD2410_PROFILE_NONE;
+    for (uint8_t s = 0; s < LD2410_PROFILE_MAX; s++) {
+        char key[8];
+        slot_key(s, key);
+        LD2410Profile p;
+        size_t len = sizeof(p);
+        // A size mismatch is a blob from another layout: keep the default
+        if (nvs_get_blob(h, key, &p, &len) == ESP_OK && len == sizeof(p)) set(s, p);
+    }
+    uint8_t active = LD2410_PROFILE_NONE;
+    if (nvs_get_u8(h, NVS_ACTIVE, &active) != ESP_OK || !get(active)) active = LD2410_PROFILE_NONE;
+    nvs_close(h);
+    return active;
+}
+
+bool LD2410Profiles::save(uint8_t slot) const {
+    if (!get(slot)) return false;
+    nvs_handle_t h;
+    if (nvs_open(NVS_NS, NVS_READWRITE, &h) != ESP_OK) return false;
+    char key[8];
+    slot_key(slot, key);
+    bool ok = nvs_set_blob(h, key, &slots[slot], sizeof(LD2410Profile)) == ESP_OK && nvs_commit(h) == ESP_OK;
+    nvs_close(h);
+    return ok;
+}
+
+bool LD2410Profiles::saveActive() const {
+    nvs_handle_t h;
+    if (nvs_open(NVS_NS, NVS_READWRITE, &h) != ESP_OK) return false;
+    bool ok = nvs_set_u8(h, NVS_ACTIVE, current) == ESP_OK && nvs_commit(h) == ESP_OK;
+    nvs_close(h);
+    return ok;
+}
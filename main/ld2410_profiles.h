@@ -0,0 +1,63 @@
+// Named LD2410 threshold profiles with low-latency switching.
+//
+// A profile is a complete detection setup: per-gate moving/stationary
+// thresholds, max moving/stationary gate and the no-one window. Each slot is
+// encoded into its ten parameter frames (9 gates + max gates) when it is set,
+// so a switch sends ready-made frames in one config session.
+//
+// The manager also tracks what the sensor currently holds, per frame. A
+// switch only sends the frames that differ; parameters not known (after boot
+// or a write from outside a profile) are always sent. Slots and the active
+// slot persist in NVS.
+#pragma once
+#include <cstdint>
+#include "ld2410_driver.h"
+
+#define LD2410_PROFILE_MAX 4
+#define LD2410_PROFILE_NONE 0xFF // sensor parameters match no profile
+#define LD2410_PROFILE_FRAMES 10 // gates 0..8, then max gates + no-one window
+#define LD2410_PROFILE_NAME_LEN 12
+
+struct LD2410Profile {
+    char name[LD2410_PROFILE_NAME_LEN] = {0}; // empty = slot unused
+    uint8_t moving[9] = {0};                   // gate energy 0..100
+    uint8_t stationary[9] = {0};
+    uint8_t maxMovingGate = 8;
+    uint8_t maxStationaryGate = 8;
+    uint8_t noOneWindow = 5;                   // s
+};
+
+class LD2410Profiles {
+public:
+    bool set(uint8_t slot, const LD2410Profile &p);
+    // nullptr if the slot is unused
+    const LD2410Profile *get(uint8_t slot) const;
+    uint8_t active() const { return current; }
+
+    // Frames that take the sensor from its known parameters to slot; 0 if
+    // it already holds them. Pointers stay valid until the slot is set again;
+    // frames may be nullptr to only count.
+    uint8_t plan(uint8_t slot, const uint8_t **frames) const;
+    // The sensor accepted all of slot's frames
+    void applied(uint8_t slot);
+    // Parameters read back from the sensor (query 0x61); gates above the
+    // reported max gates are left unknown. A slot that matches becomes active.
+    void sensorParams(const LD2410Driver::ValuesArray &moving, const LD2410Driver::ValuesArray &stationary, uint8_t noOneWindow);
+    // Parameters changed outside a profile; the next switch sends everything
+    void invalidate();
+
+    // NVS: load() fills slots found in flash and the saved active slot
+    // (which the sensor may no longer hold: only a switch sets active())
+    uint8_t load();
+    bool save(uint8_t slot) const;
+    bool saveActive() const;
+
+private:
+    LD2410Profile slots[LD2410_PROFILE_MAX];
+    uint8_t frames[LD2410_PROFILE_MAX][LD2410_PROFILE_FRAMES][LD2410_PARAM_FRAME];
+    uint8_t sensor[LD2410_PROFILE_FRAMES][LD2410_PARAM_FRAME]; // last frame the sensor accepted
+    uint16_t known = 0;  // bit per frame: sensor[] is valid
+    uint8_t current = LD2410_PROFILE_NONE;
+
+    void encode(uint8_t slot);
+};
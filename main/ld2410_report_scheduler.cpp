@@ -0,0 +1,39 @@
+#include "ld2410_report_scheduler.h"
+
+void LD2410ReportScheduler::setParams(const Params &p, uint32_t now_ms) {
+    prm = p;
+    st = Stats();
+    nextMs = now_ms;
+    flushed = false;
+    edgePending = false;
+}
+
+void LD2410ReportScheduler::edge(uint32_t now_ms) {
+    st.edges++;
+    edgeMs = now_ms;
+    edgePending = true;
+}
+
+bool LD2410ReportScheduler::due(uint32_t now_ms) {
+    if (!icd()) {
+        edgePending = false;
+        if (flushed && now_ms - lastMs < prm.intervalMs) return false;
+    } else if ((int32_t)(now_ms - nextMs) >= 0) {
+        // On the grid; windows that passed without a call are skipped
+        uint32_t missed = (now_ms - nextMs) / prm.checkInMs;
+        st.skipped += missed;
+        nextMs += (missed + 1) * prm.checkInMs;
+        st.bursts++;
+        edgePending = false;
+    } else if (edgePending) {
+        edgePending = false;
+        // The edge woke the radio; nothing new to add if this wake already flushed
+        if (flushed && edgeMs - lastMs < prm.activeWindowMs) return false;
+        st.piggybacked++;
+    } else {
+        return false;
+    }
+    flushed = true;
+    lastMs = now_ms;
+    return true;
+}
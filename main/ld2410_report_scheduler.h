@@ -0,0 +1,58 @@
+// When vendor telemetry may go out to the Matter stack.
+//
+// Continuous mode (checkInMs 0): at most every intervalMs, the way the sensor
+// task always published. ICD mode: telemetry is held and flushed in one burst
+// per check-in, at the start of each active window; windows sit on multiples
+// of checkInMs from setParams(), so the radio wakes on a fixed grid a sleepy
+// end device can schedule around. A window missed entirely (task blocked on a
+// long command) is skipped, not made up.
+//
+// Occupancy edges never wait: the caller sends them at once and reports them
+// with edge(), which lets held telemetry ride along on that wake instead of
+// costing a radio wake of its own.
+//
+// Pure state machine on the caller's clock; values are sampled when a flush is
+// due, so the held state is simply the latest reading.
+#pragma once
+#include <cstdint>
+
+class LD2410ReportScheduler {
+public:
+    struct Params {
+        uint32_t intervalMs = 250;     // continuous mode throttle
+        uint32_t checkInMs = 0;        // ICD check-in interval, 0 = continuous
+        uint32_t activeWindowMs = 300; // ICD active mode after each wake
+    };
+
+    struct Stats {
+        uint32_t bursts = 0;      // telemetry flushes on the check-in grid
+        uint32_t edges = 0;       // occupancy edges sent at once
+        uint32_t piggybacked = 0; // telemetry flushes riding on an edge wake
+        uint32_t skipped = 0;     // windows missed entirely
+    };
+
+    LD2410ReportScheduler() {}
+    explicit LD2410ReportScheduler(const Params &p) : prm(p) {}
+
+    // Starts the window grid at now_ms and clears the stats
+    void setParams(const Params &p, uint32_t now_ms);
+    const Params &params() const { return prm; }
+    bool icd() const { return prm.checkInMs != 0; }
+
+    // An occupancy edge went out now
+    void edge(uint32_t now_ms);
+    // True when the held telemetry should be flushed now
+    bool due(uint32_t now_ms);
+
+    uint32_t nextWindowMs() const { return nextMs; }
+    const Stats &stats() const { return st; }
+
+private:
+    Params prm;
+    Stats st;
+    uint32_t nextMs = 0;    // start of the next window (ICD) or next publish
+    uint32_t lastMs = 0;    // last telemetry flush
+    uint32_t edgeMs = 0;
+    bool edgePending = false;
+    bool flushed = false;
+};
@@ -0,0 +1,94 @@
+#include "ld2410_subgate.h"
+
+// Above any gate energy (0..100): disabled gates never hold the peak
+static const int16_t THR_NEVER = 0x7FFF;
+
+// Gate centers in cm Q4: (g + 0.5) * gate size
+static const uint16_t CENTERS_75[LD2410_SUBGATE_GATES] = {600, 1800, 3000, 4200, 5400, 6600, 7800, 9000, 10200};
+static const uint16_t CENTERS_20[LD2410_SUBGATE_GATES] = {160, 480, 800, 1120, 1440, 1760, 2080, 2400, 2720};
+
+void LD2410SubGate::setResolution(uint8_t cm) {
+    gateCm = (cm == 20) ? 20 : 75;
+    centers = gateCm == 20 ? CENTERS_20 : CENTERS_75;
+    curvQ4 = prm.curvature * 16;
+    LD2410Tracker::Params tp = prm.track;
+    tp.gateCm = 2 * gateCm;
+    trk.setParams(tp);
+    reset();
+}
+
+void LD2410SubGate::setThresholds(const uint8_t *moving, uint8_t nMoving, const uint8_t *stationary, uint8_t nStationary) {
+    for (uint8_t g = 0; g < LD2410_SUBGATE_GATES; g++) {
+        mThr[g] = (g <= nMoving && moving[g]) ? moving[g] : THR_NEVER;
+        sThr[g] = (g <= nStationary && stationary[g]) ? stationary[g] : THR_NEVER;
+    }
+}
+
+void LD2410SubGate::reset() {
+    raw = 0;
+    trk.reset();
+}
+
+int LD2410SubGate::bestGate(const uint8_t *e, uint8_t n, const int16_t *thr, int16_t &margin) const {
+    // Strongest gate at or above its threshold
+    int best = -1;
+    for (uint8_t g = 0; g <= n; g++) {
+        if (e[g] < prm.minEnergy || e[g] < thr[g]) continue;
+        if (best < 0 || e[g] > e[best]) best = g;
+    }
+    if (best < 0) return -1;
+    margin = (int16_t)(e[best] - thr[best]);
+    // On to the top of its peak: a neighbour with a higher threshold (or
+    // none) can still hold more energy
+    while (best > 0 && e[best - 1] > e[best]) best--;
+    while (best < n && e[best + 1] > e[best]) best++;
+    return best;
+}
+
+int32_t LD2410SubGate::peakQ4(const uint8_t *e, uint8_t n, uint8_t g) const {
+    if (!centers || g > n || n >= LD2410_SUBGATE_GATES) return -1;
+    // Offset from the gate center in gate units Q8, within +-128
+    int32_t off = 0;
+    if (g > 0 && g < n) {
+        int32_t a = e[g - 1], b = e[g], c = e[g + 1];
+        int32_t den = a - 2 * b + c;
+        if (den < 0) off = 128 * (a - c) / den;
+    } else if (g < n || g > 0) {
+        // One neighbour: a parabola of the learned curvature through both
+        // gates puts the peak (b - c) / curvature gates short of midway
+        int32_t b = e[g], c = g < n ? e[g + 1] : e[g - 1];
+        off = 128 - 128 * 16 * (b - c) / curvQ4;
+        if (off < 0) off = 0;
+        if (g == n) off = -off;
+    }
+    if (off > 128) off = 128;
+    if (off < -128) off = -128;
+    return (int32_t)centers[g] + off * gateCm / 16;
+}
+
+void LD2410SubGate::update(uint32_t now_ms, const uint8_t *moving, uint8_t nMoving, const uint8_t *stationary, uint8_t nStationary) {
+    if (!centers) setResolution(gateCm);
+    int32_t est = -1;
+    if (moving && stationary) {
+        if (nMoving >= LD2410_SUBGATE_GATES) nMoving = LD2410_SUBGATE_GATES - 1;
+        if (nStationary >= LD2410_SUBGATE_GATES) nStationary = LD2410_SUBGATE_GATES - 1;
+        int16_t mMargin = 0, sMargin = 0;
+        int mg = bestGate(moving, nMoving, mThr, mMargin);
+        int sg = bestGate(stationary, nStationary, sThr, sMargin);
+        const uint8_t *e = nullptr;
+        uint8_t n = 0;
+        int g = -1;
+        if (mg >= 0 && (sg < 0 || mMargin >= sMargin)) { e = moving; n = nMoving; g = mg; }
+        else if (sg >= 0) { e = stationary; n = nStationary; g = sg; }
+        if (g >= 0) {
+            est = peakQ4(e, n, (uint8_t)g);
+            // Peaks with both neighbours teach the curvature the edge gates use
+            if (g > 0 && g < n) {
+                int32_t k = (2 * e[g] - e[g - 1] - e[g + 1]) * 8; // Q4
+                if (k >= 2 * 16 && k <= 50 * 16) curvQ4 += (k - curvQ4) / 32;
+            }
+        }
+    }
+    if (est >= 0) raw = est;
+    trk.update(now_ms, (uint16_t)((est + 8) >> 4), est >= 0);
+}
@@ -0,0 +1,66 @@
+// Sub-gate target distance from the per-gate energies of engineering frames.
+//
+// The sensor reports distances in gate steps (75 cm coarse / 20 cm fine), so
+// a target walking slowly jumps from gate center to gate center. Gate
+// energies are on a log (dB-like) scale and a target spills into the gates
+// next to it, so a parabola through the strongest gate and its two
+// neighbours places the peak between gate centers. At the first and last
+// gate only one neighbour exists; the parabola then takes the curvature
+// learned from the peaks that had both.
+//
+// The peak is the strongest gate at or above its detection threshold (moved
+// to the top of the peak it sits on), on the moving or the stationary
+// profile, whichever peak is further above its threshold. Gate centers
+// come from fixed per-resolution tables; all math is integer (cm Q4). The
+// per-frame estimate goes through an LD2410Tracker (outlier gate of two
+// gates), which smooths it without lagging a walking target and publishes
+// through its deadband.
+#pragma once
+#include "ld2410_tracker.h"
+#include <cstdint>
+
+#define LD2410_SUBGATE_GATES 9
+
+class LD2410SubGate {
+public:
+    struct Params {
+        uint8_t minEnergy = 20;     // peak gate energy below this is no target
+        uint8_t curvature = 12;     // energy drop to a neighbour gate from a target at a gate center, until learned
+        // alpha 0.5, beta 0.125, outlier gate (two gates, set with the
+        // resolution), 3 misses, 2 cm deadband, 10 cm/s, lost after 1 s
+        LD2410Tracker::Params track = {128, 32, 150, 3, 2, 10, 1000};
+    };
+
+    LD2410SubGate() {}
+    explicit LD2410SubGate(const Params &p) : prm(p) {}
+
+    void setParams(const Params &p) { prm = p; setResolution(gateCm); }
+    void setResolution(uint8_t gateCm); // 20 or 75; anything else means 75
+    uint8_t resolution() const { return gateCm; }
+    // Sensor detection thresholds, as LD2410Trajectory::setThresholds
+    void setThresholds(const uint8_t *moving, uint8_t nMoving, const uint8_t *stationary, uint8_t nStationary);
+    void reset();
+
+    // One frame. Gate arrays are nullptr in basic mode (n = max gate index).
+    void update(uint32_t now_ms, const uint8_t *moving, uint8_t nMoving, const uint8_t *stationary, uint8_t nStationary);
+
+    bool valid() const { return trk.tracking(); }
+    uint16_t rawCm() const { return (uint16_t)((raw + 8) >> 4); }     // last frame's estimate
+    uint16_t distanceCm() const { return trk.distanceCm(); }
+    uint16_t reportedCm() const { return trk.reportedCm(); }
+
+    // Peak position over one energy profile, cm Q4; -1 without a peak
+    int32_t peakQ4(const uint8_t *e, uint8_t n, uint8_t g) const;
+
+private:
+    Params prm;
+    uint8_t gateCm = 75;
+    const uint16_t *centers = nullptr;
+    int16_t mThr[LD2410_SUBGATE_GATES] = {};
+    int16_t sThr[LD2410_SUBGATE_GATES] = {};
+    int32_t curvQ4 = 12 * 16;
+    int32_t raw = 0;      // cm Q4
+    LD2410Tracker trk;
+
+    int bestGate(const uint8_t *e, uint8_t n, const int16_t *thr, int16_t &margin) const;
+};
@@ -0,0 +1,178 @@
+#include "ld2410_telemetry.h"
+#include "esp_log.h"
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <arpa/inet.h>
+#include <unistd.h>
+#include <cerrno>
+#include <cstring>
+
+static const char *TAG_TELEMETRY = "ld2410_telemetry";
+
+static_assert(LD2410_TELEMETRY_BATCH <= 255, "batch count is a u8");
+static_assert(sizeof(sockaddr_in6) <= 28 && sizeof(sockaddr_in) <= 28, "destination buffer too small");
+
+static uint8_t *putLE16(uint8_t *p, uint16_t v) {
+    p[0] = (uint8_t)v; p[1] = (uint8_t)(v >> 8);
+    return p + 2;
+}
+
+static uint8_t *putLE32(uint8_t *p, uint32_t v) {
+    p[0] = (uint8_t)v; p[1] = (uint8_t)(v >> 8); p[2] = (uint8_t)(v >> 16); p[3] = (uint8_t)(v >> 24);
+    return p + 4;
+}
+
+LD2410Telemetry::LD2410Telemetry() {}
+
+bool LD2410Telemetry::start(const char *collector, uint16_t port) {
+    uint8_t addr[28] = {0};
+    uint8_t len = 0;
+    if (collector && strchr(collector, ':')) {
+        sockaddr_in6 *a = (sockaddr_in6 *)addr;
+        a->sin6_family = AF_INET6;
+        a->sin6_port = htons(port);
+        if (inet_pton(AF_INET6, collector, &a->sin6_addr) == 1) len = sizeof(sockaddr_in6);
+    } else if (collector) {
+        sockaddr_in *a = (sockaddr_in *)addr;
+        a->sin_family = AF_INET;
+        a->sin_port = htons(port);
+        if (inet_pton(AF_INET, collector, &a->sin_addr) == 1) len = sizeof(sockaddr_in);
+    }
+    if (!len || !port) {
+        ESP_LOGE(TAG_TELEMETRY, "Invalid collector %s:%u", collector ? collector : "(null)", port);
+        return false;
+    }
+    if (!lock) lock = xSemaphoreCreateMutex();
+    xSemaphoreTake(lock, portMAX_DELAY);
+    memcpy(dest, addr, sizeof(dest));
+    destLen = len;
+    destGen++;
+    tail = head; // nothing older than the new session
+    st = Stats();
+    on = true;
+    xSemaphoreGive(lock);
+    ESP_LOGI(TAG_TELEMETRY, "Streaming frames to %s:%u", collector, port);
+    return true;
+}
+
+void LD2410Telemetry::stop() {
+    if (!lock) return;
+    xSemaphoreTake(lock, portMAX_DELAY);
+    on = false;
+    tail = head;
+    xSemaphoreGive(lock);
+}
+
+void LD2410Telemetry::push(const Record &r) {
+    if (!on) return;
+    xSemaphoreTake(lock, portMAX_DELAY);
+    if (head - tail >= LD2410_TELEMETRY_RING) {
+        tail++;
+        st.queueDropped++;
+    }
+    uint8_t *p = ring[head % LD2410_TELEMETRY_RING];
+    p = putLE32(p, head);
+    p = putLE32(p, r.timestampMs);
+    *p++ = r.status;
+    *p++ = (uint8_t)((r.movingN << 4) | (r.stationaryN & 0x0F));
+    p = putLE16(p, r.movingCm);
+    *p++ = r.movingSignal;
+    p = putLE16(p, r.stationaryCm);
+    *p++ = r.stationarySignal;
+    p = putLE16(p, r.distanceCm);
+    memcpy(p, r.movingGates, 9);
+    memcpy(p + 9, r.stationaryGates, 9);
+    head++;
+    st.pushed++;
+    xSemaphoreGive(lock);
+}
+
+void LD2410Telemetry::closeSocket() {
+    if (sock >= 0) close(sock);
+    sock = -1;
+}
+
+uint16_t LD2410Telemetry::pump() {
+    if (!lock) return 0;
+    if (!on) {
+        closeSocket();
+        return 0;
+    }
+    uint8_t addr[28];
+    uint8_t addrLen;
+    uint8_t gen;
+    xSemaphoreTake(lock, portMAX_DELAY);
+    memcpy(addr, dest, sizeof(addr));
+    addrLen = destLen;
+    gen = destGen;
+    xSemaphoreGive(lock);
+    if (sock >= 0 && gen != sockGen) closeSocket();
+    if (sock < 0) {
+        sock = socket(((sockaddr *)addr)->sa_family, SOCK_DGRAM, 0);
+        if (sock < 0) {
+            ESP_LOGW(TAG_TELEMETRY, "socket() failed: errno %d", errno);
+            return 0;
+        }
+        sockGen = gen;
+    }
+
+    uint16_t sent = 0;
+    for (;;) {
+        // Copy one batch out under the lock; the sensor task may keep pushing
+        // (and dropping the oldest) while it is on the wire
+        xSemaphoreTake(lock, portMAX_DELAY);
+        uint32_t first = tail;
+        uint32_t n = head - tail;
+        if (n > LD2410_TELEMETRY_BATCH) n = LD2410_TELEMETRY_BATCH;
+        uint8_t *p = datagram;
+        memcpy(p, "LDT1", 4);
+        p[4] = 1;
+        p[5] = (uint8_t)n;
+        p[6] = LD2410_TELEMETRY_RECORD_SIZE;
+        p[7] = 0;
+        putLE32(p + 8, st.queueDropped);
+        p += LD2410_TELEMETRY_HEADER_SIZE;
+        for (uint32_t i = 0; i < n; i++, p += LD2410_TELEMETRY_RECORD_SIZE) {
+            memcpy(p, ring[(first + i) % LD2410_TELEMETRY_RING], LD2410_TELEMETRY_RECORD_SIZE);
+        }
+        xSemaphoreGive(lock);
+        if (!n) break;
+
+        if (sendto(sock, datagram, p - datagram, MSG_DONTWAIT, (sockaddr *)addr, addrLen) < 0) {
+            int err = errno;
+            xSemaphoreTake(lock, portMAX_DELAY);
+            st.sendErrors++;
+            xSemaphoreGive(lock);
+            // Buffer or route trouble is transient: keep the batch queued.
+            // Anything else gets a fresh socket on the next pass.
+            if (err != EAGAIN && err != EWOULDBLOCK && err != ENOMEM && err != ENOBUFS &&
+                err != EHOSTUNREACH && err != ENETUNREACH) {
+                ESP_LOGW(TAG_TELEMETRY, "sendto failed: errno %d", err);
+                closeSocket();
+            }
+            break;
+        }
+        sent++;
+        xSemaphoreTake(lock, portMAX_DELAY);
+        st.datagrams++;
+        if ((int32_t)(first + n - tail) > 0) tail = first + n; // drops may have moved it already
+        xSemaphoreGive(lock);
+    }
+    return sent;
+}
+
+LD2410Telemetry::Stats LD2410Telemetry::stats() {
+    if (!lock) return Stats();
+    xSemaphoreTake(lock, portMAX_DELAY);
+    Stats s = st;
+    xSemaphoreGive(lock);
+    return s;
+}
+
+size_t LD2410Telemetry::queued() {
+    if (!lock) return 0;
+    xSemaphoreTake(lock, portMAX_DELAY);
+    size_t n = head - tail;
+    xSemaphoreGive(lock);
+    return n;
+}
@@ -0,0 +1,90 @@
+// Full-rate raw frame telemetry over UDP, for data collection on a LAN.
+//
+// Matter reporting is throttled and shaped for controllers; this exporter
+// sends every decoded frame to one collector instead. Records are packed on
+// push into a fixed ring (the send queue). When the ring is full the oldest
+// unsent record is dropped, so a slow or unreachable collector never blocks
+// the sensor task. A pump pass (telemetry task) sends the queued records in
+// batches of up to LD2410_TELEMETRY_BATCH per datagram. A send that fails
+// with a transient error (no buffer, no route) leaves the records queued for
+// the next pass.
+//
+// Datagram (little endian):
+//   "LDT1" u8 version(1) u8 count u8 recordSize u8 reserved u32 queueDropped
+//   count x record:
+//     u32 seq u32 timestampMs u8 status u8 gates (movingN << 4 | stationaryN)
+//     u16 movingCm u8 movingSignal u16 stationaryCm u8 stationarySignal u16 distanceCm
+//     9 x u8 moving gate energy, 9 x u8 stationary gate energy (0 in basic mode)
+// seq increments per pushed record, so the collector sees both queue drops
+// (also counted in queueDropped) and network loss as gaps.
+#pragma once
+#include <cstdint>
+#include <cstddef>
+#include "freertos/FreeRTOS.h"
+#include "freertos/semphr.h"
+
+#ifndef LD2410_TELEMETRY_RING
+#define LD2410_TELEMETRY_RING 64 // records, ~3 s of engineering frames
+#endif
+#ifndef LD2410_TELEMETRY_BATCH
+#define LD2410_TELEMETRY_BATCH 32 // records per datagram (12 + 32 * 36 bytes)
+#endif
+
+#define LD2410_TELEMETRY_HEADER_SIZE 12
+#define LD2410_TELEMETRY_RECORD_SIZE 36
+
+class LD2410Telemetry {
+public:
+    struct Record {
+        uint32_t timestampMs = 0;
+        uint8_t status = 0;
+        uint16_t movingCm = 0;
+        uint8_t movingSignal = 0;
+        uint16_t stationaryCm = 0;
+        uint8_t stationarySignal = 0;
+        uint16_t distanceCm = 0;
+        uint8_t movingN = 0;           // max gate index, 0 in basic mode
+        uint8_t stationaryN = 0;
+        uint8_t movingGates[9] = {0};
+        uint8_t stationaryGates[9] = {0};
+    };
+
+    struct Stats {
+        uint32_t pushed = 0;
+        uint32_t queueDropped = 0;  // oldest records overwritten while queued
+        uint32_t datagrams = 0;
+        uint32_t sendErrors = 0;    // transient failures, records kept
+    };
+
+    LD2410Telemetry();
+
+    // collector: IPv4 or IPv6 literal. Records pushed before start are ignored.
+    bool start(const char *collector, uint16_t port);
+    void stop();
+    bool enabled() const { return on; }
+
+    // Sensor task, once per decoded frame
+    void push(const Record &r);
+    // Telemetry task: send everything queued. Returns datagrams sent.
+    uint16_t pump();
+
+    Stats stats();
+    size_t queued();
+
+private:
+    SemaphoreHandle_t lock = nullptr;
+    volatile bool on = false;
+    uint8_t ring[LD2410_TELEMETRY_RING][LD2410_TELEMETRY_RECORD_SIZE];
+    uint32_t head = 0; // seq of the next record pushed
+    uint32_t tail = 0; // seq of the oldest queued record
+    Stats st;
+    uint8_t dest[28] = {0}; // sockaddr_in / sockaddr_in6
+    uint8_t destLen = 0;
+    uint8_t destGen = 0;    // bumped by start(), the pump reopens its socket
+    // Pump side only
+    int sock = -1;
+    uint8_t sockGen = 0;
+    uint8_t datagram[LD2410_TELEMETRY_HEADER_SIZE + LD2410_TELEMETRY_BATCH * LD2410_TELEMETRY_RECORD_SIZE];
+
+    void closeSocket();
+};
@@ -0,0 +1,67 @@
+#include "ld2410_tracker.h"
+
+// Longest prediction step; frames normally arrive every ~100 ms
+static const uint32_t MAX_DT_MS = 1000;
+
+void LD2410Tracker::reset() {
+    x = 0; v = 0;
+    misses = 0;
+    active = false;
+    repCm = 0;
+    repVel = 0;
+}
+
+void LD2410Tracker::start(uint32_t now_ms, uint16_t cm) {
+    x = (int32_t)cm << 8;
+    v = 0;
+    misses = 0;
+    active = true;
+    lastMs = now_ms;
+    lastSeenMs = now_ms;
+    repCm = cm;
+    repVel = 0;
+}
+
+void LD2410Tracker::update(uint32_t now_ms, uint16_t measuredCm, bool valid) {
+    if (!valid) {
+        if (active && now_ms - lastSeenMs > prm.lostMs) reset();
+        return;
+    }
+    if (!active) { start(now_ms, measuredCm); return; }
+
+    uint32_t dt = now_ms - lastMs;
+    if (dt == 0) dt = 1;
+    if (dt > MAX_DT_MS) dt = MAX_DT_MS;
+    lastMs = now_ms;
+
+    int32_t xp = x + (int32_t)(((int64_t)v * dt) / 1000);
+    int32_t r = ((int32_t)measuredCm << 8) - xp;
+    int32_t absR = r < 0 ? -r : r;
+    if (absR > ((int32_t)prm.gateCm << 8)) {
+        outliers++;
+        if (++misses >= prm.maxMisses) {
+            start(now_ms, measuredCm); // the target really moved
+            return;
+        }
+        x = xp; // coast on the prediction
+        updateReported();
+        return;
+    }
+    misses = 0;
+    lastSeenMs = now_ms;
+    x = xp + (int32_t)(((int64_t)prm.alphaQ8 * r) >> 8);
+    v += (int32_t)(((int64_t)prm.betaQ8 * r * 1000) / ((int64_t)dt << 8));
+    if (x < 0) x = 0;
+    updateReported();
+}
+
+void LD2410Tracker::updateReported() {
+    int32_t cm = distanceCm();
+    int32_t d = cm - repCm;
+    if (d >= prm.deadbandCm || -d >= prm.deadbandCm) repCm = (uint16_t)cm;
+    int32_t vel = velocityCmS();
+    int32_t dv = vel - repVel;
+    if (dv >= prm.velDeadbandCmS || -dv >= prm.velDeadbandCmS) repVel = (int16_t)vel;
+    // A target that stopped should settle at exactly zero
+    if (vel > -prm.velDeadbandCmS / 2 && vel < prm.velDeadbandCmS / 2) repVel = 0;
+}
@@ -0,0 +1,55 @@
+// Alpha-beta tracker for LD2410 target distances.
+//
+// Smooths the frame-to-frame jitter of the reported distance, estimates the
+// radial velocity and rejects outliers (residuals beyond a gate; after
+// maxMisses consecutive rejects the track re-initialises on the new value).
+// State is fixed point: distance in cm Q8, velocity in cm/s Q8.
+//
+// Consumers that publish the output should use reportedCm()/reportedVelocity():
+// they only move when the estimate leaves a deadband around the last reported
+// value, so a still target produces no attribute churn.
+#pragma once
+#include <cstdint>
+
+class LD2410Tracker {
+public:
+    struct Params {
+        uint16_t alphaQ8 = 77;        // 0.30 position gain
+        uint16_t betaQ8 = 13;         // 0.05 velocity gain
+        uint16_t gateCm = 75;         // outlier gate on the residual
+        uint8_t maxMisses = 5;        // consecutive outliers before re-init
+        uint8_t deadbandCm = 5;       // reported distance hysteresis
+        uint8_t velDeadbandCmS = 10;  // reported velocity hysteresis
+        uint16_t lostMs = 1000;       // no measurement for this long drops the track
+    };
+
+    LD2410Tracker() {}
+    explicit LD2410Tracker(const Params &p) : prm(p) {}
+
+    void setParams(const Params &p) { prm = p; }
+    void reset();
+    // One frame. valid=false when the sensor reports no target of this type.
+    void update(uint32_t now_ms, uint16_t measuredCm, bool valid);
+
+    bool tracking() const { return active; }
+    uint16_t distanceCm() const { return active ? (uint16_t)((x + 128) >> 8) : 0; }
+    int16_t velocityCmS() const { return active ? (int16_t)(v / 256) : 0; }
+    uint16_t reportedCm() const { return repCm; }
+    int16_t reportedVelocity() const { return repVel; }
+    uint32_t rejected() const { return outliers; }
+
+private:
+    Params prm;
+    int32_t x = 0;      // cm Q8
+    int32_t v = 0;      // cm/s Q8
+    uint32_t lastMs = 0;
+    uint32_t lastSeenMs = 0;
+    uint8_t misses = 0;
+    bool active = false;
+    uint16_t repCm = 0;
+    int16_t repVel = 0;
+    uint32_t outliers = 0;
+
+    void start(uint32_t now_ms, uint16_t cm);
+    void updateReported();
+};
@@ -0,0 +1,104 @@
+#include "ld2410_trajectory.h"
+
+void LD2410Trajectory::setThresholds(const uint8_t *moving, uint8_t nMoving, const uint8_t *stationary, uint8_t nStationary) {
+    mN = nMoving > 8 ? 8 : nMoving;
+    sN = nStationary > 8 ? 8 : nStationary;
+    for (uint8_t g = 0; g < 9; g++) {
+        mThr[g] = g <= mN ? moving[g] : 0;
+        sThr[g] = g <= sN ? stationary[g] : 0;
+    }
+    hasThr = true;
+}
+
+void LD2410Trajectory::reset() {
+    head = count = 0;
+    st = IDLE;
+    speed = 0;
+    armedUntil = 0;
+    empty = detected = 0;
+}
+
+bool LD2410Trajectory::frameEmpty(uint8_t status, uint8_t movingSignal, uint8_t stationarySignal,
+                                  const uint8_t *movingGates, uint8_t nMoving, const uint8_t *stationaryGates, uint8_t nStationary) const {
+    (void)status; // held by the sensor through its no-one window, so no evidence either way
+    if (!hasThr || !movingGates || !stationaryGates) return movingSignal < prm.emptySignal && stationarySignal < prm.emptySignal;
+    for (uint8_t g = 0; g <= nMoving && g <= mN; g++) {
+        if (mThr[g] && movingGates[g] >= mThr[g]) return false;
+    }
+    for (uint8_t g = 0; g <= nStationary && g <= sN; g++) {
+        if (sThr[g] && stationaryGates[g] >= sThr[g]) return false;
+    }
+    return true;
+}
+
+LD2410Trajectory::State LD2410Trajectory::classify(uint32_t now_ms) {
+    // Least-squares slope over the samples inside the window, newest first
+    int64_t n = 0, sx = 0, sy = 0, sxx = 0, sxy = 0;
+    uint32_t newest = 0, oldest = 0;
+    for (uint8_t i = 0; i < count; i++) {
+        uint8_t k = (uint8_t)((head + LD2410_TRAJ_HISTORY - 1 - i) % LD2410_TRAJ_HISTORY);
+        if (now_ms - histT[k] > prm.windowMs) break;
+        if (!n) newest = histT[k];
+        oldest = histT[k];
+        int64_t x = (int64_t)(int32_t)(histT[k] - now_ms), y = histCm[k];
+        n++; sx += x; sy += y; sxx += x * x; sxy += x * y;
+    }
+    int64_t den = n * sxx - sx * sx;
+    if (n < prm.minPoints || den <= 0) {
+        speed = 0;
+        return IDLE;
+    }
+    int64_t cmS = (n * sxy - sx * sy) * 1000 / den;
+    int64_t travel = cmS * (int64_t)(newest - oldest) / 1000;
+    int dir = (prm.exitStartCm == 0 && prm.exitEndCm != 0) ? -1 : 1;
+    cmS *= dir;
+    travel *= dir;
+    speed = (int16_t)(cmS > 0x7FFF ? 0x7FFF : cmS < -0x7FFF ? -0x7FFF : cmS);
+    if (cmS >= prm.minSpeedCmS && travel >= prm.minTravelCm) return DEPARTURE;
+    if (-cmS >= prm.minSpeedCmS && -travel >= prm.minTravelCm) return APPROACH;
+    return IDLE;
+}
+
+LD2410Trajectory::State LD2410Trajectory::update(uint32_t now_ms, uint8_t status, uint16_t movingCm, uint8_t movingSignal, uint8_t stationarySignal,
+                                                 const uint8_t *movingGates, uint8_t nMoving, const uint8_t *stationaryGates, uint8_t nStationary) {
+    // Sensor says nobody (or no data / auto thresholds running): nothing to clear early
+    if (status == 0 || status > 3) {
+        reset();
+        return st;
+    }
+    bool isEmpty = frameEmpty(status, movingSignal, stationarySignal, movingGates, nMoving, stationaryGates, nStationary);
+    bool sample = (status & 1) && movingSignal && movingCm;
+    if (sample) {
+        histT[head] = now_ms;
+        histCm[head] = movingCm;
+        head = (uint8_t)((head + 1) % LD2410_TRAJ_HISTORY);
+        if (count < LD2410_TRAJ_HISTORY) count++;
+    }
+    State motion = classify(now_ms);
+
+    if (st == CLEARED) {
+        if (isEmpty) {
+            detected = 0;
+            return st;
+        }
+        if (++detected < prm.rearmFrames) return st;
+        detected = 0; // someone is back
+    }
+
+    if (motion == DEPARTURE && sample && inExit(movingCm)) armedUntil = now_ms + prm.armMs;
+    bool armed = armedUntil && (int32_t)(armedUntil - now_ms) > 0;
+    if (!armed) armedUntil = 0;
+    if (armed && isEmpty) {
+        if (++empty >= prm.emptyFrames) {
+            st = CLEARED;
+            clearCount++;
+            armedUntil = 0;
+            empty = 0;
+            return st;
+        }
+    } else {
+        empty = 0;
+    }
+    st = armed ? EXITING : motion;
+    return st;
+}
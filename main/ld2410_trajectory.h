@@ -0,0 +1,84 @@
+// Approach / departure classification over the recent moving-target track,
+// and early occupancy clear when someone leaves through the exit zone.
+//
+// Every frame with a moving target adds its distance to a short history; a
+// least-squares fit over the last windowMs gives the radial speed. Moving
+// toward the exit zone is a departure, away from it an approach (without an
+// exit zone: away from / toward the sensor). The exit lies beyond the
+// room (range increasing) unless the zone starts at 0 cm, next to the sensor.
+//
+// A departure seen inside the exit zone arms the early clear for armMs.
+// While armed, emptyFrames consecutive frames without any detection (no gate
+// energy at or above its threshold) clear occupancy, instead of waiting out
+// the sensor's no-one window. A person who stops in the doorway, turns back
+// or anyone else still in the room keeps gates above threshold, so nothing
+// clears. rearmFrames frames with a detection end a clear.
+#pragma once
+#include <cstdint>
+
+#define LD2410_TRAJ_HISTORY 16
+
+class LD2410Trajectory {
+public:
+    enum State : uint8_t {
+        IDLE = 0,
+        APPROACH,
+        DEPARTURE,
+        EXITING, // departure reached the exit zone: early clear armed
+        CLEARED  // left through the exit zone, room empty
+    };
+
+    struct Params {
+        uint16_t exitStartCm = 0;   // exit zone [start, end); start == end: no early clear
+        uint16_t exitEndCm = 0;
+        uint16_t windowMs = 1500;   // history used for the speed fit
+        uint8_t minPoints = 5;
+        uint16_t minSpeedCmS = 25;
+        uint16_t minTravelCm = 60;  // fitted movement over the window
+        uint16_t armMs = 3000;      // after the last departure seen in the exit zone
+        uint8_t emptyFrames = 5;
+        uint8_t rearmFrames = 2;
+        uint8_t emptySignal = 20;   // basic-mode frames: both target signals below this = empty
+    };
+
+    LD2410Trajectory() {}
+    explicit LD2410Trajectory(const Params &p) : prm(p) {}
+
+    void setParams(const Params &p) { prm = p; reset(); }
+    const Params &params() const { return prm; }
+    // Sensor detection thresholds; gates above n or with threshold 0 never
+    // detect (the sensor leaves stationary gates 0..1 at 0)
+    void setThresholds(const uint8_t *moving, uint8_t nMoving, const uint8_t *stationary, uint8_t nStationary);
+    void reset();
+
+    // One frame. Gate arrays are nullptr in basic mode (n = max gate index).
+    State update(uint32_t now_ms, uint8_t status, uint16_t movingCm, uint8_t movingSignal, uint8_t stationarySignal,
+                 const uint8_t *movingGates, uint8_t nMoving, const uint8_t *stationaryGates, uint8_t nStationary);
+
+    State state() const { return st; }
+    bool earlyClear() const { return st == CLEARED; }
+    int16_t speedCmS() const { return speed; } // positive toward the exit
+    uint32_t clears() const { return clearCount; }
+
+private:
+    Params prm;
+    uint8_t mThr[9] = {0};
+    uint8_t sThr[9] = {0};
+    uint8_t mN = 0, sN = 0;
+    bool hasThr = false; // until set, frames are judged by the target signals
+
+    uint32_t histT[LD2410_TRAJ_HISTORY];
+    uint16_t histCm[LD2410_TRAJ_HISTORY];
+    uint8_t head = 0, count = 0;
+    State st = IDLE;
+    int16_t speed = 0;
+    uint32_t armedUntil = 0;
+    uint8_t empty = 0;
+    uint8_t detected = 0;
+    uint32_t clearCount = 0;
+
+    bool frameEmpty(uint8_t status, uint8_t movingSignal, uint8_t stationarySignal,
+                    const uint8_t *movingGates, uint8_t nMoving, const uint8_t *stationaryGates, uint8_t nStationary) const;
+    State classify(uint32_t now_ms);
+    bool inExit(uint16_t cm) const { return prm.exitStartCm != prm.exitEndCm && cm >= prm.exitStartCm && cm < prm.exitEndCm; }
+};
@@ -0,0 +1,41 @@
+#include "ld2410_watchdog.h"
+
+void LD2410Watchdog::reset(uint32_t now_ms) {
+    lastFrameMs = now_ms;
+    outage = false;
+    running = false;
+    step = 0;
+    current = STAGE_NONE;
+}
+
+void LD2410Watchdog::frame(uint32_t now_ms) {
+    if (outage) downtime = now_ms - lastFrameMs;
+    reset(now_ms);
+}
+
+LD2410Watchdog::Stage LD2410Watchdog::poll(uint32_t now_ms) {
+    if (running) return STAGE_NONE;
+    if (!outage) {
+        if (now_ms - lastFrameMs < prm.staleMs) return STAGE_NONE;
+        outage = true;
+        outageCount++;
+        step = 0;
+        nextMs = now_ms;
+    }
+    if ((int32_t)(now_ms - nextMs) < 0) return STAGE_NONE;
+    current = (Stage)(STAGE_EXIT_CONFIG + step % (STAGE_COUNT - 1));
+    // Settle time doubles per stage run in this outage, capped
+    uint32_t settle = prm.backoffMs;
+    for (uint8_t i = 0; i < step && settle < prm.maxBackoffMs; i++) settle <<= 1;
+    settleMs = settle < prm.maxBackoffMs ? settle : prm.maxBackoffMs;
+    if (step < 0xFF) step++;
+    attempts++;
+    running = true;
+    return current;
+}
+
+void LD2410Watchdog::finished(uint32_t now_ms) {
+    if (!running) return;
+    running = false;
+    nextMs = now_ms + settleMs;
+}
@@ -0,0 +1,65 @@
+// Stale-sensor watchdog for the LD2410 link.
+//
+// Fed with the time of every valid data frame. Once no frame has arrived for
+// staleMs, poll() hands out recovery stages in escalating order:
+//   1 exit config mode    sensor rebooted (brown-out) into config mode
+//   2 reboot              sensor alive on the UART but not streaming
+//   3 baud scan           sensor answers on another baud rate
+//   4 UART reinstall      our side of the link is wedged
+// and then starts over at 1. After each stage the link gets a settle time
+// that doubles per attempt (backoffMs .. maxBackoffMs), so a dead or
+// unplugged sensor costs little UART time. The first valid frame ends the
+// outage and resets the escalation.
+//
+// Pure state machine: the caller runs the stage and reports finished().
+#pragma once
+#include <cstdint>
+
+class LD2410Watchdog {
+public:
+    enum Stage : uint8_t {
+        STAGE_NONE = 0,
+        STAGE_EXIT_CONFIG,
+        STAGE_REBOOT,
+        STAGE_BAUD_SCAN,
+        STAGE_UART_REINSTALL,
+        STAGE_COUNT
+    };
+
+    struct Params {
+        uint32_t staleMs = 2000;       // no valid frame for this long = outage
+        uint32_t backoffMs = 500;      // settle time after the first stage
+        uint32_t maxBackoffMs = 30000;
+    };
+
+    LD2410Watchdog() {}
+    explicit LD2410Watchdog(const Params &p) : prm(p) {}
+
+    void setParams(const Params &p) { prm = p; }
+    // Starts the stale window without a frame (link up, nothing seen yet)
+    void reset(uint32_t now_ms);
+    void frame(uint32_t now_ms);
+    // Stage to run now, or STAGE_NONE
+    Stage poll(uint32_t now_ms);
+    // The stage handed out by poll() is done; the settle time starts now
+    void finished(uint32_t now_ms);
+
+    bool stale() const { return outage; }
+    Stage stage() const { return current; }        // last stage run in this outage
+    uint32_t recoveries() const { return attempts; } // stages run, all outages
+    uint32_t outages() const { return outageCount; }
+    uint32_t lastDowntimeMs() const { return downtime; }
+
+private:
+    Params prm;
+    uint32_t lastFrameMs = 0;
+    uint32_t nextMs = 0;     // earliest time for the next stage
+    uint32_t settleMs = 0;   // settle time of the stage in progress
+    uint8_t step = 0;        // stages run in this outage
+    bool outage = false;
+    bool running = false;    // poll() handed out a stage, finished() pending
+    Stage current = STAGE_NONE;
+    uint32_t attempts = 0;
+    uint32_t outageCount = 0;
+    uint32_t downtime = 0;
+};
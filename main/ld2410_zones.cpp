@@ -0,0 +1,133 @@
+#include "ld2410_zones.h"
+#include "nvs.h"
+#include <cstdio>
+#include <cstring>
+
+static const char *NVS_NS = "ld2410_zone";
+static const char *NVS_COUNT = "count";
+
+static void zone_key(uint8_t zone, char *key) { snprintf(key, 8, "zone%u", zone); }
+
+// Above any gate energy (0..100): gates outside a zone never hit
+static const int16_t THR_NEVER = 0x7FFF;
+
+LD2410Zones::LD2410Zones() {
+    reset();
+    rebuild();
+}
+
+bool LD2410Zones::configure(uint8_t zone, const LD2410ZoneConfig &c) {
+    if (zone >= LD2410_MAX_ZONES || c.endCm < c.startCm) return false;
+    cfg[zone] = c;
+    if (zone >= n) n = zone + 1;
+    rebuild();
+    return true;
+}
+
+void LD2410Zones::setCount(uint8_t count) {
+    n = count > LD2410_MAX_ZONES ? LD2410_MAX_ZONES : count;
+    rebuild();
+}
+
+void LD2410Zones::setResolution(uint8_t cm) {
+    gateCm = (cm == 20) ? 20 : 75;
+    rebuild();
+}
+
+void LD2410Zones::reset() {
+    memset(hold, 0, sizeof(hold));
+    occupied = 0;
+}
+
+void LD2410Zones::rebuild() {
+    for (uint8_t z = 0; z < LD2410_MAX_ZONES; z++) {
+        masks[z] = 0;
+        for (uint8_t g = 0; g < LD2410_ZONE_GATES; g++) {
+            uint32_t center = (uint32_t)g * gateCm + gateCm / 2;
+            bool in = z < n && center >= cfg[z].startCm && center < cfg[z].endCm;
+            mThr[z][g] = in ? cfg[z].movingThreshold : THR_NEVER;
+            sThr[z][g] = in ? cfg[z].stationaryThreshold : THR_NEVER;
+            masks[z] |= (uint16_t)in << g;
+        }
+    }
+}
+
+uint8_t LD2410Zones::applyHits(uint8_t hits) {
+    uint8_t result = 0;
+    for (uint8_t z = 0; z < n; z++) {
+        uint8_t hit = (uint8_t)(0u - ((hits >> z) & 1u)); // 0x00 / 0xFF
+        uint8_t h = hold[z];
+        h = (uint8_t)((hit & cfg[z].holdFrames) | (~hit & (h - (h != 0))));
+        hold[z] = h;
+        result |= (uint8_t)((h != 0) << z);
+    }
+    occupied = result;
+    return result;
+}
+
+uint8_t LD2410Zones::evaluate(const uint8_t *moving, uint8_t nMoving, const uint8_t *stationary, uint8_t nStationary) {
+    // Gates beyond the reported max gate read as zero energy
+    uint8_t m[LD2410_ZONE_GATES] = {0};
+    uint8_t s[LD2410_ZONE_GATES] = {0};
+    if (nMoving > 8) nMoving = 8;
+    if (nStationary > 8) nStationary = 8;
+    memcpy(m, moving, nMoving + 1);
+    memcpy(s, stationary, nStationary + 1);
+
+    uint8_t hits = 0;
+    for (uint8_t z = 0; z < n; z++) {
+        uint32_t hit = 0;
+        for (uint8_t g = 0; g < LD2410_ZONE_GATES; g++) {
+            // sign bit set <=> energy >= threshold
+            hit |= (uint32_t)((int32_t)mThr[z][g] - 1 - m[g]);
+            hit |= (uint32_t)((int32_t)sThr[z][g] - 1 - s[g]);
+        }
+        hits |= (uint8_t)((hit >> 31) << z);
+    }
+    return applyHits(hits);
+}
+
+uint8_t LD2410Zones::evaluateTargets(uint8_t status, uint16_t mDist, uint8_t mSig, uint16_t sDist, uint8_t sSig) {
+    uint32_t mOn = (status == 1 || status == 3);
+    uint32_t sOn = (status == 2 || status == 3);
+    uint8_t hits = 0;
+    for (uint8_t z = 0; z < n; z++) {
+        const LD2410ZoneConfig &c = cfg[z];
+        uint32_t mHit = mOn & (mDist >= c.startCm) & (mDist < c.endCm) & (mSig >= c.movingThreshold);
+        uint32_t sHit = sOn & (sDist >= c.startCm) & (sDist < c.endCm) & (sSig >= c.stationaryThreshold);
+        hits |= (uint8_t)((mHit | sHit) << z);
+    }
+    return applyHits(hits);
+}
+
+bool LD2410Zones::load() {
+    nvs_handle_t h;
+    if (nvs_open(NVS_NS, NVS_READONLY, &h) != ESP_OK) return false;
+    uint8_t count = 0;
+    bool found = nvs_get_u8(h, NVS_COUNT, &count) == ESP_OK;
+    for (uint8_t z = 0; found && z < count && z < LD2410_MAX_ZONES; z++) {
+        char key[8];
+        zone_key(z, key);
+        LD2410ZoneConfig c;
+        size_t len = sizeof(c);
+        // A size mismatch is a blob from another layout: keep the default
+        if (nvs_get_blob(h, key, &c, &len) == ESP_OK && len == sizeof(c) && c.startCm <= c.endCm) cfg[z] = c;
+    }
+    nvs_close(h);
+    if (found) setCount(count);
+    return found;
+}
+
+bool LD2410Zones::save() const {
+    nvs_handle_t h;
+    if (nvs_open(NVS_NS, NVS_READWRITE, &h) != ESP_OK) return false;
+    bool ok = nvs_set_u8(h, NVS_COUNT, n) == ESP_OK;
+    for (uint8_t z = 0; ok && z < n; z++) {
+        char key[8];
+        zone_key(z, key);
+        ok = nvs_set_blob(h, key, &cfg[z], sizeof(LD2410ZoneConfig)) == ESP_OK;
+    }
+    ok = ok && nvs_commit(h) == ESP_OK;
+    nvs_close(h);
+    return ok;
+}
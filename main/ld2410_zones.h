@@ -0,0 +1,67 @@
+// Distance-zone occupancy computed per frame from LD2410 gate energies.
+//
+// A zone is a distance range with its own moving/stationary energy
+// thresholds. Ranges are given in cm and mapped onto gates for the current
+// resolution (75 cm coarse / 20 cm fine): a gate belongs to a zone when its
+// center lies inside the range. The mapping is folded into a per-zone,
+// per-gate threshold table (gates outside the zone get an unreachable
+// threshold), so evaluation is a fixed, branch-free compare/OR pass over
+// 9 gates per zone with no allocation.
+//
+// Basic-mode frames carry no gate energies; zones then fall back to the
+// reported moving/stationary target distance and signal.
+//
+// The zone count and configs persist in NVS (load/save).
+#pragma once
+#include <cstdint>
+
+#ifndef LD2410_MAX_ZONES
+#define LD2410_MAX_ZONES 4
+#endif
+#define LD2410_ZONE_GATES 9
+
+struct LD2410ZoneConfig {
+    uint16_t startCm = 0;            // inclusive
+    uint16_t endCm = 0;              // exclusive; start == end disables the zone
+    uint8_t movingThreshold = 50;    // gate energy 0..100
+    uint8_t stationaryThreshold = 40;
+    uint8_t holdFrames = 10;         // empty frames before the zone clears
+};
+
+class LD2410Zones {
+public:
+    LD2410Zones();
+
+    bool configure(uint8_t zone, const LD2410ZoneConfig &cfg);
+    const LD2410ZoneConfig &config(uint8_t zone) const { return cfg[zone < LD2410_MAX_ZONES ? zone : 0]; }
+    void setCount(uint8_t n);
+    uint8_t count() const { return n; }
+    void setResolution(uint8_t gateCm); // 20 or 75; anything else means 75
+    uint8_t resolution() const { return gateCm; }
+    uint16_t gateMask(uint8_t zone) const { return zone < n ? masks[zone] : 0; }
+
+    // Engineering-mode pass. nMoving/nStationary are the max gate indexes.
+    uint8_t evaluate(const uint8_t *moving, uint8_t nMoving, const uint8_t *stationary, uint8_t nStationary);
+    // Basic-mode fallback from the target report (status bit0 moving, bit1 stationary).
+    uint8_t evaluateTargets(uint8_t status, uint16_t mDist, uint8_t mSig, uint16_t sDist, uint8_t sSig);
+    void reset();
+
+    uint8_t occupiedMask() const { return occupied; }
+
+    // NVS: load() replaces the count and configs with the saved ones, if any
+    bool load();
+    bool save() const;
+
+private:
+    LD2410ZoneConfig cfg[LD2410_MAX_ZONES];
+    int16_t mThr[LD2410_MAX_ZONES][LD2410_ZONE_GATES];
+    int16_t sThr[LD2410_MAX_ZONES][LD2410_ZONE_GATES];
+    uint16_t masks[LD2410_MAX_ZONES];
+    uint8_t hold[LD2410_MAX_ZONES];
+    uint8_t n = 0;
+    uint8_t gateCm = 75;
+    uint8_t occupied = 0;
+
+    void rebuild();
+    uint8_t applyHits(uint8_t hits);
+};
@@ -1,10 +1,28 @@
 #include "ld2410c_wrapper.h"
 #include "ld2410_driver.h"
+#include "ld2410_history.h"
+#include "ld2410_zones.h"
+#include "ld2410_tracker.h"
+#include "ld2410_subgate.h"
+#include "ld2410_telemetry.h"
+#include "ld2410_watchdog.h"
+#include "ld2410_profiles.h"
+#include "ld2410_trajectory.h"
+#include "ld2410_report_scheduler.h"
+#include "ld2410_mode_arbiter.h"
 #include "driver/uart.h"
 #include "esp_log.h"
 #include "freertos/FreeRTOS.h"
 #include "freertos/task.h"
+#include "freertos/semphr.h"
+#include "freertos/queue.h"
 #include "esp_timer.h"
+#include "esp_attr.h"
+#include "esp_system.h"
+#include "esp_rom_crc.h"
+#include <cstddef>
+#include <cstdio>
+#include <cstring>
 
 // Using UART1, but this can be changed.
 // Make sure to connect the LD2410C sensor to the correct pins on the ESP32-C6.
@@ -15,34 +33,599 @@
 #define LD2410_TX_PIN 2
 #define LD2410_RX_PIN 3
 
+// Sensor task: woken by UART RX events; the idle wake only exists so that
+// expiring data (sensor gone silent) still produces an occupancy transition.
+#define LD2410C_TASK_STACK 4096
+#define LD2410C_TASK_PRIO 5
+#define LD2410C_IDLE_WAKE_MS 100
+// Driver hex dumps of every frame and ACK; each builds a std::stringstream
+// on the sensor task's stack, so leave off outside bench debugging
+#ifndef LD2410C_DRIVER_DEBUG
+#define LD2410C_DRIVER_DEBUG false
+#endif
+// Pending configuration commands; each can hold the UART for seconds
+#define LD2410C_COMMAND_QUEUE_LEN 4
+// Settings changed from other tasks, applied by the sensor task
+#define LD2410C_SETTING_QUEUE_LEN 8
+// Raw telemetry sender. Define LD2410C_TELEMETRY_COLLECTOR (IP literal) to
+// stream from boot; otherwise ld2410c_telemetry_start() turns it on.
+#define LD2410C_TELEMETRY_STACK 3072
+#define LD2410C_TELEMETRY_PRIO 3
+#define LD2410C_TELEMETRY_FLUSH_MS 100
+#ifndef LD2410C_TELEMETRY_PORT
+#define LD2410C_TELEMETRY_PORT 24100
+#endif
+// Vendor attribute reporting. An ICD build holds telemetry and flushes it once
+// per check-in (ld2410_report_scheduler.h); occupancy edges always go out at once.
+#define LD2410C_PUBLISH_INTERVAL_MS 250
+#define LD2410C_PUBLISH_HOLDOFF_MS 4000 // Matter dynamic endpoints registered by then
+#ifndef LD2410C_ICD_CHECK_IN_MS
+#if defined(CONFIG_ENABLE_ICD_SERVER) && defined(CONFIG_ICD_IDLE_MODE_INTERVAL_SEC)
+#define LD2410C_ICD_CHECK_IN_MS (CONFIG_ICD_IDLE_MODE_INTERVAL_SEC * 1000)
+#else
+#define LD2410C_ICD_CHECK_IN_MS 0
+#endif
+#endif
+#ifndef LD2410C_ICD_ACTIVE_WINDOW_MS
+#if defined(CONFIG_ENABLE_ICD_SERVER) && defined(CONFIG_ICD_ACTIVE_MODE_INTERVAL_MS)
+#define LD2410C_ICD_ACTIVE_WINDOW_MS CONFIG_ICD_ACTIVE_MODE_INTERVAL_MS
+#else
+#define LD2410C_ICD_ACTIVE_WINDOW_MS 300
+#endif
+#endif
+// Repeated frames: after this many in a row, zones and trajectory have
+// settled on the input (longer than any zone hold and the early-clear arm
+// time) and stop being fed. Repeat share published per window.
+#define LD2410C_REPEAT_SETTLE_FRAMES 64
+#define LD2410C_REPEAT_WINDOW_FRAMES 600
+// Engineering mode on demand (ld2410_mode_arbiter.h): kept this long after
+// the last consumer of gate data went away
+#define LD2410C_GATE_IDLE_MS 30000
+// Warm start: a software / panic / watchdog reset restarts the MCU only, so
+// the sensor still holds what the driver read at the last boot. That state
+// lives in RTC memory and is re-read in one config session this long after
+// the first frame instead of before streaming.
+#define LD2410C_WARM_MAGIC 0x4C44574D // "MWDL"
+#define LD2410C_WARM_LAYOUT 1
+#define LD2410C_WARM_CONFIRM_MS 5000
+// A warm start without a frame this long after init: the reset landed in a
+// config session, which is left at once instead of after the watchdog's window
+#define LD2410C_WARM_QUIET_MS 300
+
 static const char *TAG_WRAPPER = "ld2410c_wrapper";
 static LD2410Driver* ld2410_sensor = nullptr;
 static uint32_t ld2410_init_time_ms = 0;
 static char ld2410_fw_str[32] = {0};
+static QueueHandle_t ld2410_uart_queue = nullptr;
+static uint32_t ld2410_caps = LD2410_CAP_ALL;
 
-void ld2410c_init() {
-    ESP_LOGI(TAG_WRAPPER, "Initializing LD2410C sensor driver.");
+// Occupancy transitions: a one-slot mailbox (latest state wins) for a
+// blocking consumer, plus an optional callback run on the sensor task.
+static QueueHandle_t ld2410_occupancy_mailbox = nullptr;
+static ld2410c_occupancy_callback_t ld2410_occupancy_cb = nullptr;
+static void *ld2410_occupancy_cb_ctx = nullptr;
+static volatile bool ld2410_present = false;
+static volatile uint8_t ld2410_last_status = 0xFF;
+static QueueHandle_t ld2410_command_queue = nullptr;
 
-    // Give the sensor a moment to power up fully before communication.
-    vTaskDelay(pdMS_TO_TICKS(500));
+// Sensor task state set from other tasks: queued and applied by the sensor
+// task before its next poll (directly before ld2410c_init())
+typedef enum {
+    LD2410C_SETTING_WATCHDOG_TIMEOUT, // a = stale ms
+    LD2410C_SETTING_EXIT_ZONE,        // a = start cm, b = end cm
+    LD2410C_SETTING_REPORT_MODE,      // a = check-in ms, b = active window ms
+    LD2410C_SETTING_SKIP_REPEATS,     // a = on
+} ld2410c_setting_id_t;
+typedef struct {
+    uint8_t id; // ld2410c_setting_id_t
+    uint32_t a, b;
+} ld2410c_setting_t;
+static QueueHandle_t ld2410_setting_queue = nullptr;
 
-    // Initialize the UART driver
+// Frame history served through the Diagnostic Logs cluster. Written from the
+// polling task, read from the Matter task, so guarded by a mutex.
+static LD2410History ld2410_history;
+static LD2410History::Cursor ld2410_history_cursor;
+static SemaphoreHandle_t ld2410_history_lock = nullptr;
+
+// Distance zones, each exposed as its own OccupancySensing endpoint.
+// {startCm, endCm, movingThreshold, stationaryThreshold, holdFrames}
+static const LD2410ZoneConfig ld2410_default_zones[] = {
+    {   0, 150, 40, 30, 20 }, // near: desk
+    { 300, 450, 40, 30, 20 }, // far: door
+};
+static LD2410Zones ld2410_zones;
+static uint16_t ld2410_zone_endpoints[LD2410_MAX_ZONES] = {0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF};
+static uint8_t ld2410_zone_published = 0;
+static uint8_t ld2410_zone_reachable = 0; // zones with at least one gate at the current resolution
+static bool ld2410_zones_mapped = false;
+static_assert(LD2410C_ZONE_MAX == LD2410_MAX_ZONES, "zone count");
+
+// Per-target-type distance trackers, fed every frame
+static volatile bool ld2410_tracking_enabled = true;
+static LD2410Tracker ld2410_track_moving;
+static LD2410Tracker ld2410_track_stationary;
+static LD2410Tracker ld2410_track_combined;
+
+// Distance between gate centers from the gate energies (sensor task only)
+static LD2410SubGate ld2410_subgate;
+
+// Warm start record, kept over resets that do not cut power. A power-on
+// leaves noise, which the magic, layout, size and CRC reject.
+typedef struct {
+    uint32_t magic;
+    uint16_t layout;
+    uint16_t size;
+    LD2410Driver::Snapshot snap;
+    uint32_t crc; // over everything before it
+} ld2410c_warm_record_t;
+static RTC_NOINIT_ATTR ld2410c_warm_record_t ld2410_warm;
+static uint8_t ld2410_start_kind = LD2410C_START_COLD;
+static bool ld2410_warm_unconfirmed = false;
+static bool ld2410_warm_exit_sent = false;
+static uint32_t ld2410_warm_confirm_ms = 0;
+static volatile uint32_t ld2410_first_frame_ms = 0;
+static bool ld2410_caps_published = false;
+
+// Link watchdog: escalating recovery when valid frames stop (sensor task only)
+static LD2410Watchdog ld2410_watchdog;
+
+// Threshold profiles (sensor task only). Defaults until a slot is saved:
+// {name, moving[9], stationary[9], maxMovingGate, maxStationaryGate, noOneWindow s}
+static_assert(LD2410C_PROFILE_COUNT == LD2410_PROFILE_MAX, "profile slot count");
+static const LD2410Profile ld2410_default_profiles[] = {
+    { "home",  {50, 50, 40, 30, 20, 15, 15, 15, 15}, {0, 0, 40, 40, 30, 30, 20, 20, 20}, 8, 8, 5 },   // sensor factory values
+    { "night", {50, 50, 40, 30, 20, 15, 15, 15, 15}, {0, 0, 25, 25, 20, 20, 15, 15, 15}, 6, 6, 30 },  // still sleepers, bedroom range
+    { "away",  {60, 60, 50, 40, 30, 25, 25, 25, 25}, {100, 100, 100, 100, 100, 100, 100, 100, 100}, 8, 8, 5 }, // movement only
+};
+static LD2410Profiles ld2410_profiles;
+static uint16_t ld2410_profile_switch_ms = 0;
+
+// Walk-out detection (sensor task only): leaving through the exit zone clears
+// occupancy without waiting out the no-one window. The exit defaults to the
+// door zone above.
+static LD2410Trajectory ld2410_trajectory(LD2410Trajectory::Params{300, 450});
+static uint8_t ld2410_trajectory_published = 0xFF;
+
+// Repeated-frame fast path (sensor task only)
+static bool ld2410_skip_repeats = true;
+static uint32_t ld2410_repeat_run = 0;       // repeated frames in a row
+static uint32_t ld2410_settled_skips = 0;
+static uint32_t ld2410_publish_skips = 0;
+static uint32_t ld2410_published_distinct = UINT32_MAX; // distinct frames at the last frame-derived publish
+
+// Engineering mode on demand (sensor task only); subscription / app bits are
+// raised from other tasks
+static_assert(LD2410C_GATE_DEMAND_SUBSCRIPTION == LD2410ModeArbiter::DEMAND_SUBSCRIPTION, "demand bits");
+static_assert(LD2410C_GATE_DEMAND_APP == LD2410ModeArbiter::DEMAND_APP, "demand bits");
+static LD2410ModeArbiter ld2410_mode(LD2410ModeArbiter::Params{LD2410C_GATE_IDLE_MS});
+static uint8_t ld2410_gate_demand = 0;
+static bool ld2410_mode_auto = true;
+
+// Vendor telemetry flush schedule (sensor task only)
+static LD2410ReportScheduler ld2410_reports(LD2410ReportScheduler::Params{
+    LD2410C_PUBLISH_INTERVAL_MS, LD2410C_ICD_CHECK_IN_MS, LD2410C_ICD_ACTIVE_WINDOW_MS});
+
+// Full-rate frame export, pushed from the sensor task, sent from its own task
+static LD2410Telemetry ld2410_telemetry;
+static TaskHandle_t ld2410_telemetry_task = nullptr;
+
+static void ld2410c_history_add(const LD2410Driver::SensorData &sd) {
+    LD2410History::Sample s;
+    uint8_t st = sd.status;
+    s.v[LD2410_HIST_OCCUPIED] = (st && st < 4) ? 100 : 0;
+    s.v[LD2410_HIST_MOVING] = (st == 1 || st == 3) ? 100 : 0;
+    s.v[LD2410_HIST_STATIONARY] = (st == 2 || st == 3) ? 100 : 0;
+    s.v[LD2410_HIST_MOVING_DIST] = (uint16_t)sd.mTargetDistance;
+    s.v[LD2410_HIST_MOVING_SIGNAL] = sd.mTargetSignal;
+    s.v[LD2410_HIST_STATIONARY_DIST] = (uint16_t)sd.sTargetDistance;
+    s.v[LD2410_HIST_STATIONARY_SIGNAL] = sd.sTargetSignal;
+    s.v[LD2410_HIST_DISTANCE] = (uint16_t)sd.distance;
+    // Gate arrays are only filled in engineering mode (N == 0 otherwise)
+    if (sd.mTargetSignals.N) {
+        for (uint8_t g = 0; g <= sd.mTargetSignals.N; g++) s.v[LD2410_HIST_MOVING_GATE0 + g] = sd.mTargetSignals.values[g];
+    }
+    if (sd.sTargetSignals.N) {
+        for (uint8_t g = 0; g <= sd.sTargetSignals.N; g++) s.v[LD2410_HIST_STATIONARY_GATE0 + g] = sd.sTargetSignals.values[g];
+    }
+    xSemaphoreTake(ld2410_history_lock, portMAX_DELAY);
+    ld2410_history.addSample(sd.timestamp, s);
+    xSemaphoreGive(ld2410_history_lock);
+}
+
+static void ld2410c_telemetry_add(const LD2410Driver::SensorData &sd) {
+    LD2410Telemetry::Record r;
+    r.timestampMs = sd.timestamp;
+    r.status = sd.status;
+    r.movingCm = (uint16_t)sd.mTargetDistance;
+    r.movingSignal = sd.mTargetSignal;
+    r.stationaryCm = (uint16_t)sd.sTargetDistance;
+    r.stationarySignal = sd.sTargetSignal;
+    r.distanceCm = (uint16_t)sd.distance;
+    r.movingN = sd.mTargetSignals.N;
+    r.stationaryN = sd.sTargetSignals.N;
+    if (sd.mTargetSignals.N) memcpy(r.movingGates, sd.mTargetSignals.values, sd.mTargetSignals.N + 1);
+    if (sd.sTargetSignals.N) memcpy(r.stationaryGates, sd.sTargetSignals.values, sd.sTargetSignals.N + 1);
+    ld2410_telemetry.push(r);
+}
+
+// Runs inside LD2410Driver::processData() for every decoded frame
+static void ld2410c_on_frame(const LD2410Driver::SensorData &sd, void *ctx) {
+    (void)ctx;
+    ld2410_watchdog.frame(sd.timestamp);
+    if (!ld2410_first_frame_ms) {
+        ld2410_first_frame_ms = sd.timestamp ? sd.timestamp : 1;
+        ld2410_warm_confirm_ms = ld2410_first_frame_ms + LD2410C_WARM_CONFIRM_MS;
+    }
+    // Same input again: once zones and trajectory have settled on it, feeding them changes nothing
+    ld2410_repeat_run = ld2410_sensor->frameRepeated() ? ld2410_repeat_run + 1 : 0;
+    bool settled = ld2410_repeat_run > LD2410C_REPEAT_SETTLE_FRAMES;
+    if (settled) ld2410_settled_skips++;
+    ld2410c_history_add(sd);
+    if (ld2410_telemetry.enabled()) ld2410c_telemetry_add(sd);
+    if (ld2410_tracking_enabled) {
+        uint8_t st = sd.status;
+        ld2410_track_moving.update(sd.timestamp, (uint16_t)sd.mTargetDistance, st == 1 || st == 3);
+        ld2410_track_stationary.update(sd.timestamp, (uint16_t)sd.sTargetDistance, st == 2 || st == 3);
+        ld2410_track_combined.update(sd.timestamp, (uint16_t)sd.distance, st && st < 4);
+    } else if (ld2410_track_combined.tracking() || ld2410_track_moving.tracking() || ld2410_track_stationary.tracking()) {
+        ld2410_track_moving.reset();
+        ld2410_track_stationary.reset();
+        ld2410_track_combined.reset();
+    }
+    bool gates = sd.mTargetSignals.N || sd.sTargetSignals.N;
+    ld2410_subgate.update(sd.timestamp, gates ? sd.mTargetSignals.values : nullptr, sd.mTargetSignals.N,
+                          gates ? sd.sTargetSignals.values : nullptr, sd.sTargetSignals.N);
+    if (settled) return;
+    ld2410_trajectory.update(sd.timestamp, sd.status, (uint16_t)sd.mTargetDistance, sd.mTargetSignal, sd.sTargetSignal,
+                             gates ? sd.mTargetSignals.values : nullptr, sd.mTargetSignals.N,
+                             gates ? sd.sTargetSignals.values : nullptr, sd.sTargetSignals.N);
+    if (ld2410_zones.count()) {
+        if (gates) {
+            ld2410_zones.evaluate(sd.mTargetSignals.values, sd.mTargetSignals.N, sd.sTargetSignals.values, sd.sTargetSignals.N);
+        } else {
+            ld2410_zones.evaluateTargets(sd.status, (uint16_t)sd.mTargetDistance, sd.mTargetSignal, (uint16_t)sd.sTargetDistance, sd.sTargetSignal);
+        }
+    }
+}
+
+// Layout documented with LD2410C_ATTR_COMMAND_RTT_STATS
+static void ld2410c_pack_rtt_stats(uint8_t *out) {
+    for (uint8_t c = 0; c < LD2410Driver::RTT_CLASSES; c++, out += 8) {
+        const LD2410Driver::RttStats &st = ld2410_sensor->getRttStats((LD2410Driver::RttClass)c);
+        uint32_t srtt = st.srtt_us / 100, var = st.rttvar_us / 100;
+        if (srtt > 0xFFFF) srtt = 0xFFFF;
+        if (var > 0xFFFF) var = 0xFFFF;
+        out[0] = srtt & 0xFF; out[1] = srtt >> 8;
+        out[2] = var & 0xFF; out[3] = var >> 8;
+        out[4] = st.rto_ms & 0xFF; out[5] = st.rto_ms >> 8;
+        out[6] = st.retries > 0xFF ? 0xFF : (uint8_t)st.retries;
+        out[7] = st.timeouts > 0xFF ? 0xFF : (uint8_t)st.timeouts;
+    }
+}
+
+// Empty-frame test of the trajectory analyzer follows the sensor thresholds
+static void ld2410c_gate_thresholds() {
+    const LD2410Driver::ValuesArray &mv = ld2410_sensor->getMovingThresholds();
+    const LD2410Driver::ValuesArray &st = ld2410_sensor->getStationaryThresholds();
+    ld2410_trajectory.setThresholds(mv.values, mv.N, st.values, st.N);
+    ld2410_subgate.setThresholds(mv.values, mv.N, st.values, st.N);
+}
+
+// Zones map cm onto gates: 20 cm gates reach only 180 cm, so a zone past the
+// last gate can never be occupied. Every resolution change goes through here.
+static void ld2410c_zones_resolution(uint8_t gateCm) {
+    ld2410_zones.setResolution(gateCm);
+    uint8_t was = __atomic_load_n(&ld2410_zone_reachable, __ATOMIC_RELAXED), now = 0;
+    for (uint8_t z = 0; z < ld2410_zones.count(); z++) {
+        const LD2410ZoneConfig &c = ld2410_zones.config(z);
+        if (ld2410_zones.gateMask(z)) {
+            now |= 1u << z;
+            ESP_LOGI(TAG_WRAPPER, "Zone %u: gates 0x%03X (%u cm gates)", z, ld2410_zones.gateMask(z), gateCm);
+            // Skipped at startup; endpoints are only created then
+            if (!(was & (1u << z)) && ld2410_zone_endpoints[z] == 0xFFFF && ld2410_zones_mapped) {
+                ESP_LOGW(TAG_WRAPPER, "Zone %u: %u-%u cm is in range but has no endpoint until restart", z, c.startCm, c.endCm);
+            }
+        } else {
+            ESP_LOGW(TAG_WRAPPER, "Zone %u: %u-%u cm lies past the last %u cm gate, never occupied", z, c.startCm, c.endCm, gateCm);
+        }
+    }
+    __atomic_store_n(&ld2410_zone_reachable, now, __ATOMIC_RELAXED);
+    ld2410_zones_mapped = true;
+}
+
+// SetZone: an empty range removes the zone, and with it any empty zones
+// left at the end of the list
+static bool ld2410c_set_zone(const uint16_t *a) {
+    LD2410ZoneConfig c;
+    c.startCm = a[1];
+    c.endCm = a[2];
+    c.movingThreshold = (uint8_t)a[3];
+    c.stationaryThreshold = (uint8_t)a[4];
+    c.holdFrames = (uint8_t)a[5];
+    if (!ld2410_zones.configure((uint8_t)a[0], c)) return false;
+    uint8_t n = ld2410_zones.count();
+    while (n && ld2410_zones.config(n - 1).startCm == ld2410_zones.config(n - 1).endCm) n--;
+    ld2410_zones.setCount(n);
+    ESP_LOGI(TAG_WRAPPER, "Zone %u: %u-%u cm, thresholds %u/%u, hold %u frames (%u zones)", a[0], c.startCm, c.endCm,
+             c.movingThreshold, c.stationaryThreshold, c.holdFrames, n);
+    ld2410c_zones_resolution(ld2410_zones.resolution());
+    return ld2410_zones.save();
+}
+
+// Re-read what the sensor holds after a write outside the profiles
+static void ld2410c_profiles_resync() {
+    ld2410_profiles.sensorParams(ld2410_sensor->getMovingThresholds(), ld2410_sensor->getStationaryThresholds(), ld2410_sensor->getNoOneWindow());
+}
+
+// One config session with only the frames the sensor does not hold yet.
+// The sensor streams nothing in config mode: the session is the blackout.
+static bool ld2410c_select_profile(uint8_t slot) {
+    const LD2410Profile *p = ld2410_profiles.get(slot);
+    if (!p) return false;
+    const uint8_t *frames[LD2410_PROFILE_FRAMES];
+    uint8_t n = ld2410_profiles.plan(slot, frames);
+    int64_t t0 = esp_timer_get_time();
+    bool ok = ld2410_sensor->writeParameterFrames(frames, n);
+    int64_t ms = (esp_timer_get_time() - t0) / 1000;
+    ld2410_profile_switch_ms = n ? (uint16_t)(ms > 0xFFFF ? 0xFFFF : ms) : 0;
+    if (!ok) {
+        ld2410_profiles.invalidate(); // some frames may have landed
+        ESP_LOGW(TAG_WRAPPER, "Profile %u (%s) failed after %u ms", slot, p->name, ld2410_profile_switch_ms);
+        return false;
+    }
+    ld2410_profiles.applied(slot);
+    ld2410_profiles.saveActive();
+    ESP_LOGI(TAG_WRAPPER, "Profile %u (%s): %u frames, %u ms without presence data", slot, p->name, n, ld2410_profile_switch_ms);
+    return true;
+}
+
+static bool ld2410c_save_profile(uint8_t slot) {
+    if (slot >= LD2410_PROFILE_MAX || !ld2410_sensor->requestParameters()) return false;
+    const LD2410Driver::ValuesArray &mv = ld2410_sensor->getMovingThresholds();
+    const LD2410Driver::ValuesArray &st = ld2410_sensor->getStationaryThresholds();
+    LD2410Profile p;
+    if (ld2410_profiles.get(slot)) p = *ld2410_profiles.get(slot); // gates beyond the max gates keep their values
+    else snprintf(p.name, sizeof(p.name), "custom%u", slot);
+    for (uint8_t g = 0; g <= mv.N; g++) p.moving[g] = mv.values[g];
+    for (uint8_t g = 0; g <= st.N; g++) p.stationary[g] = st.values[g];
+    p.maxMovingGate = mv.N;
+    p.maxStationaryGate = st.N;
+    p.noOneWindow = ld2410_sensor->getNoOneWindow();
+    ld2410_profiles.set(slot, p);
+    ld2410c_profiles_resync();
+    // Saved from what the sensor holds, so it is active unless unknown gates differ
+    if (!ld2410_profiles.plan(slot, nullptr)) {
+        ld2410_profiles.applied(slot);
+        ld2410_profiles.saveActive();
+    }
+    return ld2410_profiles.save(slot);
+}
+
+// Only MCU resets keep the sensor running (and the RTC memory intact)
+static bool ld2410c_warm_reset() {
+    switch (esp_reset_reason()) {
+        case ESP_RST_SW:
+        case ESP_RST_PANIC:
+        case ESP_RST_INT_WDT:
+        case ESP_RST_TASK_WDT:
+        case ESP_RST_WDT:
+            return true;
+        default:
+            return false;
+    }
+}
+
+static bool ld2410c_warm_valid() {
+    return ld2410_warm.magic == LD2410C_WARM_MAGIC && ld2410_warm.layout == LD2410C_WARM_LAYOUT &&
+           ld2410_warm.size == sizeof(ld2410_warm) &&
+           ld2410_warm.crc == esp_rom_crc32_le(0, (const uint8_t *)&ld2410_warm, offsetof(ld2410c_warm_record_t, crc));
+}
+
+// After anything that may change what the sensor holds
+static void ld2410c_warm_save() {
+    LD2410Driver::Snapshot snap;
+    if (!ld2410_sensor->snapshot(snap)) {
+        ld2410_warm.magic = 0; // nothing read: the next boot asks the sensor
+        return;
+    }
+    memset(&ld2410_warm, 0, sizeof(ld2410_warm));
+    ld2410_warm.layout = LD2410C_WARM_LAYOUT;
+    ld2410_warm.size = sizeof(ld2410_warm);
+    ld2410_warm.snap = snap;
+    ld2410_warm.magic = LD2410C_WARM_MAGIC;
+    ld2410_warm.crc = esp_rom_crc32_le(0, (const uint8_t *)&ld2410_warm, offsetof(ld2410c_warm_record_t, crc));
+}
+
+// Warm start: the restored state against the sensor's own. Someone may have
+// changed it while the MCU was down (Bluetooth app, firmware update).
+static void ld2410c_warm_confirm() {
+    LD2410Driver::Snapshot before, after;
+    bool had = ld2410_sensor->snapshot(before);
+    if (!ld2410_sensor->refreshSnapshot()) {
+        ld2410_warm_confirm_ms = (uint32_t)(esp_timer_get_time() / 1000ULL) + LD2410C_WARM_CONFIRM_MS;
+        return;
+    }
+    ld2410_warm_unconfirmed = false;
+    // Nothing restored to compare against counts as changed
+    if (had && ld2410_sensor->snapshot(after) && memcmp(&before, &after, sizeof(after)) == 0) {
+        ESP_LOGI(TAG_WRAPPER, "Warm start confirmed");
+        return;
+    }
+    ESP_LOGW(TAG_WRAPPER, "Warm start: sensor state changed while the MCU was down, reloading");
+    ld2410_start_kind = LD2410C_START_WARM_STALE;
+    ld2410_caps = ld2410_sensor->getCapabilities();
+    strncpy(ld2410_fw_str, ld2410_sensor->getFirmware().c_str(), sizeof(ld2410_fw_str) - 1);
+    ld2410c_profiles_resync();
+    uint8_t savedProfile = ld2410_profiles.load();
+    if (savedProfile != LD2410_PROFILE_NONE && ld2410_profiles.active() != savedProfile) ld2410c_select_profile(savedProfile);
+    ld2410c_gate_thresholds();
+    ld2410c_zones_resolution(ld2410_sensor->getResolution());
+    ld2410_subgate.setResolution(ld2410_sensor->getResolution());
+    ld2410_published_distinct = UINT32_MAX;
+    ld2410_caps_published = false;
+    ld2410c_warm_save();
+}
+
+static uint8_t ld2410c_run_command(const ld2410c_command_t &cmd) {
+    const uint16_t *a = cmd.args;
+    bool ok = false;
+    switch (cmd.id) {
+        case LD2410C_CMD_SET_GATE_THRESHOLDS:
+            ok = ld2410_sensor->setGateParameters(a[0], a[1], a[2]);
+            if (ok) ld2410c_profiles_resync();
+            else ld2410_profiles.invalidate();
+            break;
+        case LD2410C_CMD_SET_MAX_GATES:
+            ok = ld2410_sensor->setMaxGate(a[0], a[1], a[2]);
+            if (ok) ld2410c_profiles_resync();
+            else ld2410_profiles.invalidate();
+            break;
+        case LD2410C_CMD_SET_RESOLUTION:
+            if (!ld2410_sensor->supports(LD2410_CAP_RESOLUTION)) return LD2410C_CMD_STATUS_UNSUPPORTED;
+            // Takes effect after a sensor reboot
+            ok = ld2410_sensor->setResolution(a[0] != 0) && ld2410_sensor->requestReboot();
+            vTaskDelay(pdMS_TO_TICKS(1000));
+            ld2410c_zones_resolution(ld2410_sensor->getResolution());
+            ld2410_subgate.setResolution(ld2410_sensor->getResolution());
+            break;
+        case LD2410C_CMD_START_AUTO_THRESHOLDS:
+            if (!ld2410_sensor->supports(LD2410_CAP_AUTO_THRESHOLDS)) return LD2410C_CMD_STATUS_UNSUPPORTED;
+            ok = ld2410_sensor->autoThresholds(a[0] ? a[0] : 10); // progress shows in the frame status (4..6)
+            ld2410_profiles.invalidate(); // the sensor picks its own thresholds
+            break;
+        case LD2410C_CMD_REBOOT:
+            ok = ld2410_sensor->requestReboot();
+            vTaskDelay(pdMS_TO_TICKS(1000));
+            break;
+        case LD2410C_CMD_FACTORY_RESET:
+            ok = ld2410_sensor->requestReset() && ld2410_sensor->requestReboot();
+            vTaskDelay(pdMS_TO_TICKS(1000));
+            ld2410c_zones_resolution(ld2410_sensor->getResolution());
+            ld2410_subgate.setResolution(ld2410_sensor->getResolution());
+            ld2410_profiles.invalidate();
+            break;
+        case LD2410C_CMD_SELECT_PROFILE:
+            ok = ld2410c_select_profile(a[0]);
+            break;
+        case LD2410C_CMD_SAVE_PROFILE:
+            ok = ld2410c_save_profile(a[0]);
+            break;
+        case LD2410C_CMD_SET_ZONE:
+            ok = ld2410c_set_zone(a);
+            break;
+        default:
+            return LD2410C_CMD_STATUS_UNSUPPORTED;
+    }
+    return ok ? LD2410C_CMD_STATUS_SUCCESS : LD2410C_CMD_STATUS_FAILED;
+}
+
+static void ld2410c_sensor_task(void *arg) {
+    (void)arg;
+    for (;;) {
+        ld2410c_run_commands();
+        uart_event_t event;
+        if (!ld2410_uart_queue) {
+            vTaskDelay(pdMS_TO_TICKS(LD2410C_IDLE_WAKE_MS)); // UART reinstall failed; the watchdog retries
+        } else if (xQueueReceive(ld2410_uart_queue, &event, pdMS_TO_TICKS(LD2410C_IDLE_WAKE_MS)) == pdTRUE) {
+            if (event.type == UART_FIFO_OVF || event.type == UART_BUFFER_FULL) {
+                ESP_LOGW(TAG_WRAPPER, "UART RX overflow, flushing");
+                uart_flush_input(LD2410_UART_NUM);
+                xQueueReset(ld2410_uart_queue);
+                continue;
+            }
+        }
+        ld2410c_poll();
+    }
+}
+
+static esp_err_t ld2410c_uart_install() {
     uart_config_t uart_config = {
-        .baud_rate = 256000,
+        .baud_rate = LD2410_BAUD_RATE,
         .data_bits = UART_DATA_8_BITS,
         .parity    = UART_PARITY_DISABLE,
         .stop_bits = UART_STOP_BITS_1,
         .flow_ctrl = UART_HW_FLOWCTRL_DISABLE,
+        .rx_flow_ctrl_thresh = 0,
         .source_clk = UART_SCLK_DEFAULT,
     };
-    ESP_ERROR_CHECK(uart_param_config(LD2410_UART_NUM, &uart_config));
-    ESP_ERROR_CHECK(uart_set_pin(LD2410_UART_NUM, LD2410_TX_PIN, LD2410_RX_PIN, UART_PIN_NO_CHANGE, UART_PIN_NO_CHANGE));
-    ESP_ERROR_CHECK(uart_driver_install(LD2410_UART_NUM, 256, 0, 0, NULL, 0));
+    esp_err_t err = uart_param_config(LD2410_UART_NUM, &uart_config);
+    if (err == ESP_OK) err = uart_set_pin(LD2410_UART_NUM, LD2410_TX_PIN, LD2410_RX_PIN, UART_PIN_NO_CHANGE, UART_PIN_NO_CHANGE);
+    if (err == ESP_OK) err = uart_driver_install(LD2410_UART_NUM, 256, 0, 16, &ld2410_uart_queue, 0);
+    return err;
+}
+
+static const char *const ld2410_recovery_names[] = {"none", "exit config", "reboot", "baud scan", "UART reinstall"};
+
+// One watchdog stage; frames seen while it runs end the outage
+static void ld2410c_recover(LD2410Watchdog::Stage stage) {
+    uint32_t t0 = (uint32_t)(esp_timer_get_time() / 1000ULL);
+    bool ok = false;
+    switch (stage) {
+        case LD2410Watchdog::STAGE_EXIT_CONFIG:
+            ok = ld2410_sensor->forceConfigExit();
+            break;
+        case LD2410Watchdog::STAGE_REBOOT:
+            ok = ld2410_sensor->requestReboot();
+            vTaskDelay(pdMS_TO_TICKS(1000));
+            break;
+        case LD2410Watchdog::STAGE_BAUD_SCAN:
+            ok = ld2410_sensor->scanBaud() != 0;
+            break;
+        case LD2410Watchdog::STAGE_UART_REINSTALL:
+            uart_driver_delete(LD2410_UART_NUM);
+            ld2410_uart_queue = nullptr;
+            ok = ld2410c_uart_install() == ESP_OK;
+            break;
+        default:
+            return;
+    }
+    // Whatever brought the link back may have cost engineering mode; the
+    // next frames show the mode and the arbiter switches back if needed
+    if (ok) ld2410_sensor->end();
+    uint32_t now_ms = (uint32_t)(esp_timer_get_time() / 1000ULL);
+    ESP_LOGW(TAG_WRAPPER, "No valid frames: recovery #%u (%s) %s in %u ms", (unsigned)ld2410_watchdog.recoveries(),
+             ld2410_recovery_names[stage], ok ? "done" : "failed", (unsigned)(now_ms - t0));
+    ld2410_watchdog.finished(now_ms);
+}
+
+static void ld2410c_telemetry_loop(void *arg) {
+    (void)arg;
+    for (;;) {
+        vTaskDelay(pdMS_TO_TICKS(LD2410C_TELEMETRY_FLUSH_MS));
+        ld2410c_telemetry_pump();
+    }
+}
 
-    ld2410_sensor = new LD2410Driver(LD2410_UART_NUM, true);
+void ld2410c_init() {
+    ESP_LOGI(TAG_WRAPPER, "Initializing LD2410C sensor driver.");
+    bool warm = ld2410c_warm_reset() && ld2410c_warm_valid();
+
+    // Give the sensor a moment to power up fully before communication.
+    // After a warm reset it has been streaming all along.
+    if (!warm) vTaskDelay(pdMS_TO_TICKS(500));
+
+    // Initialize the UART driver
+    ESP_ERROR_CHECK(ld2410c_uart_install());
+
+    ld2410_history_lock = xSemaphoreCreateMutex();
+    ld2410_sensor = new LD2410Driver(LD2410_UART_NUM, LD2410C_DRIVER_DEBUG);
+    ld2410_sensor->setFrameCallback(ld2410c_on_frame, nullptr);
+    ld2410_sensor->setSkipRepeats(ld2410_skip_repeats);
+    for (uint8_t z = 0; z < sizeof(ld2410_default_zones) / sizeof(ld2410_default_zones[0]); z++) {
+        ld2410_zones.configure(z, ld2410_default_zones[z]);
+    }
+    if (ld2410_zones.load()) ESP_LOGI(TAG_WRAPPER, "%u zones from NVS", ld2410_zones.count());
     if (!ld2410_sensor->begin()) {
         ESP_LOGW(TAG_WRAPPER, "LD2410C sensor did not acknowledge exit config mode. This is often normal on startup. Continuing...");
     }
+    if (warm) {
+        // No queries below; a sensor left in config mode is the watchdog's first stage
+        ld2410_sensor->restore(ld2410_warm.snap);
+        ld2410_start_kind = LD2410C_START_WARM;
+        ld2410_warm_unconfirmed = true;
+        ESP_LOGI(TAG_WRAPPER, "Warm start (reset reason %d): sensor state from RTC memory", (int)esp_reset_reason());
+    }
 
     ESP_LOGI(TAG_WRAPPER, "LD2410C sensor initialized.");
     ld2410_init_time_ms = (uint32_t)(esp_timer_get_time() / 1000ULL);
@@ -53,14 +636,52 @@ void ld2410c_init() {
     } else {
         ESP_LOGW(TAG_WRAPPER, "Could not read LD2410C firmware version.");
     }
+    // Built once; unsupported commands fail fast from now on instead of timing out
+    ld2410_caps = ld2410_sensor->getCapabilities();
+
+    // The sensor keeps its parameters across power cycles, so restoring the
+    // saved profile is normally a read-back and no writes
+    for (uint8_t p = 0; p < sizeof(ld2410_default_profiles) / sizeof(ld2410_default_profiles[0]); p++) {
+        ld2410_profiles.set(p, ld2410_default_profiles[p]);
+    }
+    uint8_t savedProfile = ld2410_profiles.load();
+    if (warm || ld2410_sensor->requestParameters()) ld2410c_profiles_resync();
+    if (savedProfile != LD2410_PROFILE_NONE) ld2410c_select_profile(savedProfile);
+    ld2410c_gate_thresholds();
+    ld2410_subgate.setResolution(ld2410_sensor->getResolution());
+    ld2410c_warm_save();
+
+    if (ld2410_zones.count()) {
+        // Zones map cm onto gates; engineering mode (their per-gate energies)
+        // is switched on while someone is in the room
+        ld2410c_zones_resolution(ld2410_sensor->getResolution());
+    }
+
+    const LD2410Driver::RttStats &cfgRtt = ld2410_sensor->getRttStats(LD2410Driver::RTT_CONFIG);
+    const LD2410Driver::RttStats &qRtt = ld2410_sensor->getRttStats(LD2410Driver::RTT_QUERY);
+    ESP_LOGI(TAG_WRAPPER, "Command RTT: config %u us (deadline %u ms), query %u us (deadline %u ms), %u retries",
+             (unsigned)cfgRtt.srtt_us, cfgRtt.rto_ms, (unsigned)qRtt.srtt_us, qRtt.rto_ms, (unsigned)(cfgRtt.retries + qRtt.retries));
+
+    ld2410_watchdog.reset((uint32_t)(esp_timer_get_time() / 1000ULL));
+    ld2410_mode.reset((uint32_t)(esp_timer_get_time() / 1000ULL));
+    // Check-in grid starts when publishing does
+    ld2410_reports.setParams(ld2410_reports.params(), ld2410_init_time_ms + LD2410C_PUBLISH_HOLDOFF_MS);
+    ld2410_occupancy_mailbox = xQueueCreate(1, sizeof(ld2410c_occupancy_event_t));
+    ld2410_command_queue = xQueueCreate(LD2410C_COMMAND_QUEUE_LEN, sizeof(ld2410c_command_t));
+    ld2410_setting_queue = xQueueCreate(LD2410C_SETTING_QUEUE_LEN, sizeof(ld2410c_setting_t));
+    xTaskCreate(ld2410c_sensor_task, "ld2410c", LD2410C_TASK_STACK, nullptr, LD2410C_TASK_PRIO, nullptr);
+#ifdef LD2410C_TELEMETRY_COLLECTOR
+    ld2410c_telemetry_start(LD2410C_TELEMETRY_COLLECTOR, LD2410C_TELEMETRY_PORT);
+#endif
 }
 
 void ld2410c_poll() {
     // Trigger a lightweight read to update internal buffers by asking for presence.
     if (ld2410_sensor) {
-        // Read any pending UART frames (ACK or DATA). This updates internal status.
-        ld2410_sensor->check();
-        bool present = ld2410_sensor->presenceDetected();
+        // Drain pending UART frames (ACK or DATA) so every frame reaches the history.
+        for (int i = 0; i < 8 && ld2410_sensor->check() != LD2410Driver::FAIL; i++) {}
+        // A walk-out through the exit zone ends occupancy before the sensor's no-one window does
+        bool present = ld2410_sensor->presenceDetected() && !ld2410_trajectory.earlyClear();
         static uint8_t lastStatus = 0xFF;
         static bool warnedNoData = false;
         uint32_t now_ms = (uint32_t)(esp_timer_get_time() / 1000ULL);
@@ -76,6 +697,12 @@ void ld2410c_poll() {
                 case 6: ESP_LOGI(TAG_WRAPPER, "State: 6 Auto thresholds failed"); break;
                 default: ESP_LOGI(TAG_WRAPPER, "State: 0x%02X Invalid/Expired", st); break;
             }
+            if (st == 0xFF && lastStatus != 0xFF) {
+                ld2410_zones.reset();
+                xSemaphoreTake(ld2410_history_lock, portMAX_DELAY);
+                ld2410_history.markGap(now_ms);
+                xSemaphoreGive(ld2410_history_lock);
+            }
             lastStatus = st;
         }
         // If no valid data yet (status 0xFF) for > 3000 ms after init, warn once.
@@ -83,20 +710,81 @@ void ld2410c_poll() {
             ESP_LOGW(TAG_WRAPPER, "No LD2410C data frames received yet (status 0xFF). Check wiring, power, baud (256000), and TX/RX pins (TX GPIO2 -> sensor RX, RX GPIO3 -> sensor TX).");
             warnedNoData = true;
         }
-        (void)present; // present is derived from status
-
-        // Publish vendor telemetry periodically (simple change detection)
-        static uint32_t last_publish_ms = 0;
-        const uint32_t publish_interval_ms = 250; // throttle
-        if (now_ms - last_publish_ms >= publish_interval_ms) {
-            // Avoid publishing before Matter dynamic endpoint fully registered
-            if ((now_ms - ld2410_init_time_ms) < 4000) {
-                return;
+        LD2410Watchdog::Stage recovery = ld2410_watchdog.poll(now_ms);
+        if (recovery != LD2410Watchdog::STAGE_NONE) {
+            ld2410c_recover(recovery);
+            now_ms = (uint32_t)(esp_timer_get_time() / 1000ULL);
+        }
+        ld2410_last_status = st;
+        if (present != ld2410_present) {
+            if (!present && ld2410_trajectory.earlyClear()) ESP_LOGI(TAG_WRAPPER, "Left through the exit zone, clearing early");
+            ld2410_present = present;
+            ld2410_reports.edge(now_ms);
+            ld2410c_occupancy_event_t ev = { present, st, now_ms };
+            xQueueOverwrite(ld2410_occupancy_mailbox, &ev);
+            if (ld2410_occupancy_cb) ld2410_occupancy_cb(&ev, ld2410_occupancy_cb_ctx);
+        }
+        // Zone edges go out immediately, once the endpoints are registered
+        uint8_t zones = ld2410_zones.occupiedMask();
+        if (zones != ld2410_zone_published && (now_ms - ld2410_init_time_ms) >= LD2410C_PUBLISH_HOLDOFF_MS) {
+            // All slots: a zone removed while occupied still gets its clear
+            for (uint8_t z = 0; z < LD2410_MAX_ZONES; z++) {
+                bool occupied = (zones >> z) & 1;
+                if (occupied == (bool)((ld2410_zone_published >> z) & 1) || ld2410_zone_endpoints[z] == 0xFFFF) continue;
+                set_occupancy_attribute_value(ld2410_zone_endpoints[z], occupied);
+                ESP_LOGI(TAG_WRAPPER, "Zone %u %s", z, occupied ? "occupied" : "clear");
+            }
+            ld2410_zone_published = zones;
+            ld2410_reports.edge(now_ms);
+        }
+
+        // Engineering mode while someone needs gate data: zones with an
+        // endpoint while the sensor sees someone, auto thresholds, and
+        // subscribers / the application (ld2410c_set_gate_demand)
+        if (st != 0xFF && !ld2410_watchdog.stale() && __atomic_load_n(&ld2410_mode_auto, __ATOMIC_RELAXED)) {
+            uint8_t demand = __atomic_load_n(&ld2410_gate_demand, __ATOMIC_RELAXED);
+            bool zonesUsed = false;
+            for (uint8_t z = 0; z < ld2410_zones.count(); z++) zonesUsed |= ld2410_zone_endpoints[z] != 0xFFFF && ((ld2410_zone_reachable >> z) & 1);
+            if (zonesUsed && st >= 1 && st <= 3) demand |= LD2410ModeArbiter::DEMAND_ZONES;
+            if (st == 4) demand |= LD2410ModeArbiter::DEMAND_CALIBRATION;
+            bool eng = ld2410_sensor->inEnhancedMode();
+            if (ld2410_mode.update(now_ms, demand, eng) != eng) {
+                bool ok = ld2410_sensor->enhancedMode(!eng);
+                uint32_t t1 = (uint32_t)(esp_timer_get_time() / 1000ULL);
+                ld2410_mode.switched(t1, ok, t1 - now_ms);
+                ESP_LOGI(TAG_WRAPPER, "Engineering mode %s (demand 0x%02X): %s in %u ms", eng ? "off" : "on", demand,
+                         ok ? "done" : "failed", (unsigned)(t1 - now_ms));
+                now_ms = t1;
+            }
+        }
+
+        // Publish vendor telemetry when the schedule says so (simple change detection)
+        if ((now_ms - ld2410_init_time_ms) >= LD2410C_PUBLISH_HOLDOFF_MS && ld2410_reports.due(now_ms)) {
+            // Everything below reaches the Matter task as one batch
+            ld2410c_vendor_publish_begin();
+            if (!ld2410_caps_published) {
+                ld2410c_update_vendor_capabilities(ld2410_caps);
+                ld2410c_update_vendor_profile(ld2410_profiles.active(), ld2410_profile_switch_ms);
+                ld2410_caps_published = true;
+            }
+            // Boot: time to the first frame and how the driver state was obtained
+            static uint32_t pubFirstFrame = 0;
+            static uint8_t pubStartKind = 0xFF;
+            if (ld2410_first_frame_ms != pubFirstFrame || ld2410_start_kind != pubStartKind) {
+                pubFirstFrame = ld2410_first_frame_ms;
+                pubStartKind = ld2410_start_kind;
+                ld2410c_update_vendor_boot((uint16_t)(pubFirstFrame > 0xFFFF ? 0xFFFF : pubFirstFrame), pubStartKind);
             }
-            last_publish_ms = now_ms;
-            const LD2410Driver::SensorData &sd = ld2410_sensor->getSensorData();
+            // Aux / auto-threshold attributes are left untouched on firmware without them
+            bool hasAux = ld2410_caps & LD2410_CAP_AUX_CONTROL;
+            bool hasAuto = ld2410_caps & LD2410_CAP_AUTO_THRESHOLDS;
+            // Frame-derived attributes only move with a frame that differs from the last one
+            uint32_t distinct = ld2410_sensor->framesDecoded() - ld2410_sensor->framesRepeated();
+            bool fresh = distinct != ld2410_published_distinct;
+            ld2410_published_distinct = distinct;
+            if (!fresh) ld2410_publish_skips++;
             // Scalars
-            ld2410c_update_vendor_scalars(
+            if (fresh) ld2410c_update_vendor_scalars(
                 (uint16_t)ld2410_sensor->movingTargetDistance(),
                 ld2410_sensor->movingTargetSignal(),
                 (uint16_t)ld2410_sensor->stationaryTargetDistance(),
@@ -105,13 +793,72 @@ void ld2410c_poll() {
                 ld2410_sensor->inEnhancedMode(),
                 (uint16_t)ld2410_sensor->getRange_cm(),
                 ld2410_sensor->getLightLevel(),
-                ld2410_sensor->getLightThreshold(),
+                hasAux ? ld2410_sensor->getLightThreshold() : 0,
                 ld2410_sensor->getOutLevel(),
-                (uint8_t)ld2410_sensor->getAutoStatus()
+                hasAuto ? (uint8_t)ld2410_sensor->cachedAutoStatus() : (uint8_t)AutoStatus::NOT_SET
             );
 
+            ld2410c_update_vendor_recovery(ld2410_watchdog.recoveries(), ld2410_watchdog.stage());
+            if (ld2410_trajectory.state() != ld2410_trajectory_published) {
+                ld2410_trajectory_published = ld2410_trajectory.state();
+                ld2410c_update_vendor_trajectory(ld2410_trajectory_published);
+            }
+
+            // Command RTT stats only change when commands run
+            static uint8_t pubRtt[LD2410Driver::RTT_CLASSES * 8];
+            uint8_t rtt[sizeof(pubRtt)];
+            ld2410c_pack_rtt_stats(rtt);
+            if (memcmp(rtt, pubRtt, sizeof(rtt)) != 0) {
+                ld2410c_update_vendor_rtt_stats(rtt, sizeof(rtt));
+                memcpy(pubRtt, rtt, sizeof(rtt));
+            }
+
+            // Tracked distances: the reported values only move outside their deadband
+            static uint16_t pubTrack[3] = {0xFFFF, 0xFFFF, 0xFFFF};
+            static int16_t pubVel = 0x7FFF;
+            static bool pubTrackEnabled = false;
+            uint16_t trk[3] = { ld2410_track_moving.reportedCm(), ld2410_track_stationary.reportedCm(), ld2410_track_combined.reportedCm() };
+            int16_t vel = ld2410_track_moving.reportedVelocity();
+            if (trk[0] != pubTrack[0] || trk[1] != pubTrack[1] || trk[2] != pubTrack[2] || vel != pubVel || ld2410_tracking_enabled != pubTrackEnabled) {
+                ld2410c_update_vendor_tracking(trk[0], vel, trk[1], trk[2], ld2410_tracking_enabled);
+                pubTrack[0] = trk[0]; pubTrack[1] = trk[1]; pubTrack[2] = trk[2];
+                pubVel = vel;
+                pubTrackEnabled = ld2410_tracking_enabled;
+            }
+
+            // Sub-gate distance: only moves outside its deadband
+            static uint16_t pubSubGate = 0xFFFF;
+            if (ld2410_subgate.reportedCm() != pubSubGate) {
+                pubSubGate = ld2410_subgate.reportedCm();
+                ld2410c_update_vendor_subgate_distance(pubSubGate);
+            }
+
+            // Repeat share over the last window of frames
+            static uint32_t windowFrames = 0, windowRepeats = 0;
+            static uint8_t pubRepeatPct = 0xFF;
+            if (ld2410_sensor->framesDecoded() - windowFrames >= LD2410C_REPEAT_WINDOW_FRAMES) {
+                uint32_t n = ld2410_sensor->framesDecoded() - windowFrames;
+                uint8_t pct = (uint8_t)((ld2410_sensor->framesRepeated() - windowRepeats) * 100 / n);
+                if (pct != pubRepeatPct) ld2410c_update_vendor_frame_repeats(pct);
+                pubRepeatPct = pct;
+                windowFrames = ld2410_sensor->framesDecoded();
+                windowRepeats = ld2410_sensor->framesRepeated();
+            }
+
+            // Mode switches: count, cost of the last one, share of time in engineering mode
+            const LD2410ModeArbiter::Stats &ms = ld2410_mode.stats();
+            static uint32_t pubSwitches = UINT32_MAX;
+            static uint8_t pubEngPct = 0xFF;
+            uint64_t total = ms.engineeringMs + ms.basicMs;
+            uint8_t engPct = total ? (uint8_t)(ms.engineeringMs * 100 / total) : 0;
+            if (ms.switches + ms.failures != pubSwitches || engPct != pubEngPct) {
+                ld2410c_update_vendor_mode_stats(ms.switches, (uint16_t)(ms.lastSwitchMs > 0xFFFF ? 0xFFFF : ms.lastSwitchMs), engPct);
+                pubSwitches = ms.switches + ms.failures;
+                pubEngPct = engPct;
+            }
+
             // Arrays (signals & thresholds) only if enhanced mode
-            if (ld2410_sensor->inEnhancedMode()) {
+            if (fresh && ld2410_sensor->inEnhancedMode()) {
                 const auto &mvSig = ld2410_sensor->getMovingSignals();
                 const auto &stSig = ld2410_sensor->getStationarySignals();
                 const auto &mvThr = ld2410_sensor->getMovingThresholds();
@@ -124,20 +871,225 @@ void ld2410c_poll() {
                     ld2410_fw_str[0] ? ld2410_fw_str : nullptr
                 );
             }
+            ld2410c_vendor_publish_commit();
         }
     }
 }
 
+static void ld2410c_apply_setting(const ld2410c_setting_t &st) {
+    switch (st.id) {
+        case LD2410C_SETTING_WATCHDOG_TIMEOUT: {
+            LD2410Watchdog::Params p;
+            p.staleMs = st.a ? st.a : p.staleMs;
+            ld2410_watchdog.setParams(p);
+            break;
+        }
+        case LD2410C_SETTING_EXIT_ZONE: {
+            LD2410Trajectory::Params p = ld2410_trajectory.params();
+            p.exitStartCm = (uint16_t)st.a;
+            p.exitEndCm = (uint16_t)st.b;
+            ld2410_trajectory.setParams(p); // also clears its history
+            break;
+        }
+        case LD2410C_SETTING_REPORT_MODE: {
+            LD2410ReportScheduler::Params p = ld2410_reports.params();
+            p.checkInMs = st.a;
+            p.activeWindowMs = st.b ? st.b : LD2410C_ICD_ACTIVE_WINDOW_MS;
+            ld2410_reports.setParams(p, (uint32_t)(esp_timer_get_time() / 1000ULL));
+            break;
+        }
+        case LD2410C_SETTING_SKIP_REPEATS:
+            ld2410_skip_repeats = st.a != 0;
+            if (ld2410_sensor) ld2410_sensor->setSkipRepeats(ld2410_skip_repeats);
+            ld2410_repeat_run = 0;
+            break;
+        default:
+            break;
+    }
+}
+
+static void ld2410c_post_setting(uint8_t id, uint32_t a, uint32_t b) {
+    ld2410c_setting_t st = {id, a, b};
+    if (!ld2410_setting_queue) ld2410c_apply_setting(st); // no sensor task yet
+    else if (xQueueSend(ld2410_setting_queue, &st, 0) != pdTRUE) ESP_LOGW(TAG_WRAPPER, "Setting %u dropped: queue full", id);
+}
+
+void ld2410c_run_commands() {
+    ld2410c_setting_t st;
+    while (ld2410_setting_queue && xQueueReceive(ld2410_setting_queue, &st, 0) == pdTRUE) ld2410c_apply_setting(st);
+    if (ld2410_start_kind != LD2410C_START_COLD && !ld2410_first_frame_ms && !ld2410_warm_exit_sent &&
+        (uint32_t)(esp_timer_get_time() / 1000ULL) - ld2410_init_time_ms >= LD2410C_WARM_QUIET_MS) {
+        ld2410_warm_exit_sent = true;
+        bool ok = ld2410_sensor->forceConfigExit();
+        ESP_LOGW(TAG_WRAPPER, "Warm start: no frames after %u ms, config exit %s", LD2410C_WARM_QUIET_MS, ok ? "acknowledged" : "not acknowledged");
+    }
+    if (ld2410_warm_unconfirmed && ld2410_first_frame_ms &&
+        (int32_t)((uint32_t)(esp_timer_get_time() / 1000ULL) - ld2410_warm_confirm_ms) >= 0) {
+        ld2410c_warm_confirm();
+    }
+    ld2410c_command_t cmd;
+    while (ld2410_command_queue && xQueueReceive(ld2410_command_queue, &cmd, 0) == pdTRUE) {
+        uint32_t t0 = (uint32_t)(esp_timer_get_time() / 1000ULL);
+        uint8_t status = ld2410c_run_command(cmd);
+        ld2410c_gate_thresholds();
+        ld2410c_warm_save();
+        ld2410_published_distinct = UINT32_MAX; // thresholds / range may have changed
+        ESP_LOGI(TAG_WRAPPER, "Command 0x%02X -> status %u (%u ms)", cmd.id, status,
+                 (unsigned)((uint32_t)(esp_timer_get_time() / 1000ULL) - t0));
+        ld2410c_update_vendor_command_status(cmd.id, status);
+        ld2410c_update_vendor_profile(ld2410_profiles.active(), ld2410_profile_switch_ms);
+    }
+}
+
 bool ld2410c_is_present() {
     if (ld2410_sensor) {
-        return ld2410_sensor->presenceDetected();
+        return ld2410_present;
     }
     ESP_LOGW(TAG_WRAPPER, "ld2410c_is_present() called before initialization.");
     return false;
 }
 
 uint8_t ld2410c_status() {
-    if (ld2410_sensor) return ld2410_sensor->getStatus();
-    return 0xFF;
+    return ld2410_last_status;
 }
 
+uint8_t ld2410c_zone_count() {
+    return ld2410_zones.count();
+}
+
+bool ld2410c_zone_reachable(uint8_t zone) {
+    return zone < LD2410_MAX_ZONES && (__atomic_load_n(&ld2410_zone_reachable, __ATOMIC_RELAXED) >> zone) & 1;
+}
+
+void ld2410c_set_zone_endpoint(uint8_t zone, uint16_t endpoint_id) {
+    if (zone < LD2410_MAX_ZONES) ld2410_zone_endpoints[zone] = endpoint_id;
+}
+
+void ld2410c_set_tracking_enabled(bool enabled) {
+    ld2410_tracking_enabled = enabled; // trackers are reset on the sensor task
+}
+
+bool ld2410c_telemetry_start(const char *collector, uint16_t port) {
+    if (!ld2410_telemetry.start(collector, port ? port : LD2410C_TELEMETRY_PORT)) return false;
+    if (!ld2410_telemetry_task) {
+        xTaskCreate(ld2410c_telemetry_loop, "ld2410c_tlm", LD2410C_TELEMETRY_STACK, nullptr, LD2410C_TELEMETRY_PRIO, &ld2410_telemetry_task);
+    }
+    return true;
+}
+
+void ld2410c_telemetry_stop() {
+    ld2410_telemetry.stop();
+}
+
+void ld2410c_telemetry_pump() {
+    ld2410_telemetry.pump();
+}
+
+void ld2410c_telemetry_stats(ld2410c_telemetry_stats_t *out) {
+    LD2410Telemetry::Stats st = ld2410_telemetry.stats();
+    out->records = st.pushed;
+    out->queue_dropped = st.queueDropped;
+    out->datagrams = st.datagrams;
+    out->send_errors = st.sendErrors;
+}
+
+void ld2410c_set_watchdog_timeout(uint32_t stale_ms) {
+    ld2410c_post_setting(LD2410C_SETTING_WATCHDOG_TIMEOUT, stale_ms, 0);
+}
+
+void ld2410c_set_report_mode(uint32_t check_in_ms, uint32_t active_window_ms) {
+    ld2410c_post_setting(LD2410C_SETTING_REPORT_MODE, check_in_ms, active_window_ms);
+}
+
+void ld2410c_report_stats(ld2410c_report_stats_t *out) {
+    const LD2410ReportScheduler::Stats &st = ld2410_reports.stats();
+    out->check_in_ms = ld2410_reports.params().checkInMs;
+    out->bursts = st.bursts;
+    out->edges = st.edges;
+    out->piggybacked = st.piggybacked;
+    out->skipped = st.skipped;
+}
+
+void ld2410c_set_skip_repeats(bool on) {
+    ld2410c_post_setting(LD2410C_SETTING_SKIP_REPEATS, on, 0);
+}
+
+void ld2410c_frame_stats(ld2410c_frame_stats_t *out) {
+    out->frames = ld2410_sensor ? ld2410_sensor->framesDecoded() : 0;
+    out->repeated = ld2410_sensor ? ld2410_sensor->framesRepeated() : 0;
+    out->settled_skips = ld2410_settled_skips;
+    out->publish_skips = ld2410_publish_skips;
+}
+
+void ld2410c_set_gate_demand(uint8_t source, bool on) {
+    if (on) __atomic_fetch_or(&ld2410_gate_demand, source, __ATOMIC_RELAXED);
+    else __atomic_fetch_and(&ld2410_gate_demand, (uint8_t)~source, __ATOMIC_RELAXED);
+}
+
+void ld2410c_set_mode_auto(bool on) {
+    __atomic_store_n(&ld2410_mode_auto, on, __ATOMIC_RELAXED);
+}
+
+void ld2410c_mode_stats(ld2410c_mode_stats_t *out) {
+    const LD2410ModeArbiter::Stats &ms = ld2410_mode.stats();
+    out->engineering = ld2410_sensor && ld2410_sensor->inEnhancedMode();
+    out->demand = ld2410_mode.demand();
+    out->switches = ms.switches;
+    out->failures = ms.failures;
+    out->switch_ms = ms.switchMs;
+    out->engineering_ms = ms.engineeringMs;
+    out->basic_ms = ms.basicMs;
+}
+
+void ld2410c_boot_stats(ld2410c_boot_stats_t *out) {
+    out->start_kind = ld2410_start_kind;
+    out->first_frame_ms = ld2410_first_frame_ms;
+    out->confirmed = ld2410_start_kind != LD2410C_START_COLD && !ld2410_warm_unconfirmed;
+}
+
+void ld2410c_set_exit_zone(uint16_t start_cm, uint16_t end_cm) {
+    ld2410c_post_setting(LD2410C_SETTING_EXIT_ZONE, start_cm, end_cm);
+}
+
+bool ld2410c_submit_command(const ld2410c_command_t *cmd) {
+    if (!ld2410_command_queue || !cmd) return false;
+    return xQueueSend(ld2410_command_queue, cmd, 0) == pdTRUE;
+}
+
+void ld2410c_register_occupancy_callback(ld2410c_occupancy_callback_t cb, void *context) {
+    ld2410_occupancy_cb_ctx = context;
+    ld2410_occupancy_cb = cb;
+}
+
+bool ld2410c_wait_occupancy_event(ld2410c_occupancy_event_t *event, uint32_t timeout_ms) {
+    if (!ld2410_occupancy_mailbox || !event) return false;
+    TickType_t ticks = (timeout_ms == UINT32_MAX) ? portMAX_DELAY : pdMS_TO_TICKS(timeout_ms);
+    return xQueueReceive(ld2410_occupancy_mailbox, event, ticks) == pdTRUE;
+}
+
+size_t ld2410c_history_export_size() {
+    if (!ld2410_history_lock) return 0;
+    uint32_t now_ms = (uint32_t)(esp_timer_get_time() / 1000ULL);
+    xSemaphoreTake(ld2410_history_lock, portMAX_DELAY);
+    size_t n = ld2410_history.exportSize(now_ms);
+    xSemaphoreGive(ld2410_history_lock);
+    return n;
+}
+
+bool ld2410c_history_export_begin() {
+    if (!ld2410_history_lock) return false;
+    uint32_t now_ms = (uint32_t)(esp_timer_get_time() / 1000ULL);
+    xSemaphoreTake(ld2410_history_lock, portMAX_DELAY);
+    ld2410_history.beginExport(ld2410_history_cursor, now_ms);
+    xSemaphoreGive(ld2410_history_lock);
+    return true;
+}
+
+size_t ld2410c_history_export_read(uint8_t *buf, size_t cap, bool *done) {
+    if (!ld2410_history_lock || !buf) { if (done) *done = true; return 0; }
+    xSemaphoreTake(ld2410_history_lock, portMAX_DELAY);
+    size_t n = ld2410_history.readExport(ld2410_history_cursor, buf, cap);
+    if (done) *done = ld2410_history_cursor.done;
+    xSemaphoreGive(ld2410_history_lock);
+    return n;
+}
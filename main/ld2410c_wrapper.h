@@ -5,15 +5,186 @@ extern "C" {
 #endif
 
 #include <stdbool.h>
+#include <stddef.h>
 #include <cstdint>
 
+// Occupancy transition reported by the sensor task
+typedef struct {
+	bool present;
+	uint8_t status;        // raw status byte at the transition (0xFF = data expired)
+	uint32_t timestamp_ms; // since boot
+} ld2410c_occupancy_event_t;
+
+typedef void (*ld2410c_occupancy_callback_t)(const ld2410c_occupancy_event_t *event, void *context);
+
+// Sensor configuration commands, run on the sensor task. The ids are also
+// the vendor cluster command ids; args are the command fields in tag order.
+typedef enum {
+	LD2410C_CMD_SET_GATE_THRESHOLDS   = 0x00, // gate (0..8, 0xFF = all), moving, stationary (0..100)
+	LD2410C_CMD_SET_MAX_GATES         = 0x01, // moving gate, stationary gate (0..8), no-one window s
+	LD2410C_CMD_SET_RESOLUTION        = 0x02, // 1 = 20 cm gates, 0 = 75 cm
+	LD2410C_CMD_START_AUTO_THRESHOLDS = 0x03, // duration s (0 = sensor default 10 s)
+	LD2410C_CMD_REBOOT                = 0x04,
+	LD2410C_CMD_FACTORY_RESET         = 0x05,
+	LD2410C_CMD_SELECT_PROFILE        = 0x06, // slot (0..LD2410C_PROFILE_COUNT-1)
+	LD2410C_CMD_SAVE_PROFILE          = 0x07, // slot: store the sensor's current parameters there
+	LD2410C_CMD_SET_ZONE              = 0x08, // zone (0..LD2410C_ZONE_MAX-1), start cm, end cm (= start removes it),
+	                                          // moving, stationary threshold (0..100), hold frames
+	LD2410C_CMD_COUNT
+} ld2410c_command_id_t;
+
+typedef enum {
+	LD2410C_CMD_STATUS_SUCCESS     = 0x00,
+	LD2410C_CMD_STATUS_FAILED      = 0x01, // NAK or no ACK from the sensor
+	LD2410C_CMD_STATUS_UNSUPPORTED = 0x02, // sensor firmware lacks the command
+	LD2410C_CMD_STATUS_BUSY        = 0x03, // queue full, not run
+	LD2410C_CMD_STATUS_PENDING     = 0xFE, // queued or running
+	LD2410C_CMD_STATUS_NONE        = 0xFF
+} ld2410c_command_status_t;
+
+// Threshold profile slots (ld2410_profiles.h): 0 home, 1 night, 2 away, 3 unused
+// until saved. The selected slot and saved slots persist in NVS.
+#define LD2410C_PROFILE_COUNT 4
+
+typedef struct {
+	uint8_t id; // ld2410c_command_id_t
+	uint16_t args[6]; // 8-bit fields except the SetZone cm bounds
+} ld2410c_command_t;
+
+typedef struct {
+	uint32_t records;       // frames queued since start
+	uint32_t queue_dropped; // oldest records dropped under backpressure
+	uint32_t datagrams;
+	uint32_t send_errors;
+} ld2410c_telemetry_stats_t;
+
+typedef struct {
+	uint32_t check_in_ms; // 0 = continuous reporting
+	uint32_t bursts;      // telemetry flushes on the check-in grid
+	uint32_t edges;       // occupancy / zone edges, sent at once
+	uint32_t piggybacked; // telemetry flushed on an edge wake
+	uint32_t skipped;     // check-in windows missed entirely
+} ld2410c_report_stats_t;
+
+typedef struct {
+	uint32_t frames;         // data frames received
+	uint32_t repeated;       // ... identical to the previous one, not decoded
+	uint32_t settled_skips;  // repeated frames that also skipped zones / trajectory
+	uint32_t publish_skips;  // publishes without frame-derived attribute updates
+} ld2410c_frame_stats_t;
+
+// Consumers of per-gate data (ld2410_mode_arbiter.h); zones and auto
+// thresholds are tracked by the sensor task itself
+#define LD2410C_GATE_DEMAND_SUBSCRIPTION 0x02 // a subscription covers the gate signal attributes
+#define LD2410C_GATE_DEMAND_APP          0x08
+
+typedef struct {
+	bool engineering;        // sensor mode now
+	uint8_t demand;          // LD2410ModeArbiter::Demand bits at the last poll
+	uint32_t switches;
+	uint32_t failures;
+	uint32_t switch_ms;      // config-mode time of all switches
+	uint64_t engineering_ms; // time in each mode since init
+	uint64_t basic_ms;
+} ld2410c_mode_stats_t;
+
+// How ld2410c_init() got the sensor's firmware, protocol, resolution and
+// parameters: queried (cold), or restored from RTC memory after an MCU-only
+// reset and re-read in the background a few seconds after the first frame
+#define LD2410C_START_COLD       0
+#define LD2410C_START_WARM       1
+#define LD2410C_START_WARM_STALE 2 // the re-read found the sensor changed and reloaded
+
+typedef struct {
+	uint8_t start_kind;      // LD2410C_START_*
+	bool confirmed;          // warm start: re-read done
+	uint32_t first_frame_ms; // esp_timer ms at the first valid data frame, 0 = none yet
+} ld2410c_boot_stats_t;
+
+// Installs the UART and starts the sensor task, which owns the driver from then on.
 void ld2410c_init();
+// One sensor task iteration (drain frames, detect transitions, publish). Only the sensor task calls this.
 void ld2410c_poll();
+// Runs the queued configuration commands. Only the sensor task calls this.
+void ld2410c_run_commands();
 bool ld2410c_is_present();
 uint8_t ld2410c_status(); // returns raw status byte (0=no,1=move,2=still,3=both)
 
+// Distance zones (ld2410_zones.h); each gets its own OccupancySensing endpoint.
+// A zone past the last gate at the current resolution (20 cm gates reach
+// 180 cm) is not reachable and gets no endpoint. Zones are set with the
+// SetZone command and persist in NVS; a zone added or brought into range
+// after startup gets its endpoint at the next restart.
+#define LD2410C_ZONE_MAX 4
+uint8_t ld2410c_zone_count();
+bool ld2410c_zone_reachable(uint8_t zone);
+void ld2410c_set_zone_endpoint(uint8_t zone, uint16_t endpoint_id);
+
+// Alpha-beta distance tracking (ld2410_tracker.h), published as its own vendor attributes
+void ld2410c_set_tracking_enabled(bool enabled);
+
+// Stale-sensor watchdog (ld2410_watchdog.h): window without valid frames
+// before recovery starts, 0 = default 2000 ms. Safe from any task; after
+// ld2410c_init() it takes effect at the sensor task's next iteration.
+void ld2410c_set_watchdog_timeout(uint32_t stale_ms);
+
+// Early clear on walk-out (ld2410_trajectory.h): distance band of the room's
+// exit, default 300..450 cm; start == end disables. Safe from any task, like
+// ld2410c_set_watchdog_timeout().
+void ld2410c_set_exit_zone(uint16_t start_cm, uint16_t end_cm);
+
+// Vendor telemetry reporting (ld2410_report_scheduler.h): check_in_ms 0 =
+// every 250 ms; otherwise held and flushed once per check-in, radio kept on
+// for active_window_ms (0 = default). Occupancy edges always go out at once.
+// Defaults to the ICD server settings on an ICD build. Safe from any task,
+// like ld2410c_set_watchdog_timeout().
+void ld2410c_set_report_mode(uint32_t check_in_ms, uint32_t active_window_ms);
+void ld2410c_report_stats(ld2410c_report_stats_t *out);
+
+// Repeated-frame fast path (LD2410Driver::setSkipRepeats), on by default.
+// Safe from any task, like ld2410c_set_watchdog_timeout().
+void ld2410c_set_skip_repeats(bool on);
+void ld2410c_frame_stats(ld2410c_frame_stats_t *out);
+
+// Engineering mode runs while any consumer needs gate data and for 30 s
+// after the last one; safe from any task. Off leaves the sensor in whatever
+// mode it reports (replayed captures).
+void ld2410c_set_gate_demand(uint8_t source, bool on);
+void ld2410c_set_mode_auto(bool on);
+void ld2410c_mode_stats(ld2410c_mode_stats_t *out);
+
+void ld2410c_boot_stats(ld2410c_boot_stats_t *out);
+
+// Queues a command for the sensor task and returns at once; false when the
+// queue is full or before init. The result is published as the vendor
+// LastCommandId/LastCommandStatus attributes.
+bool ld2410c_submit_command(const ld2410c_command_t *cmd);
+
+// Full-rate UDP frame export (ld2410_telemetry.h for the datagram format).
+// collector is an IPv4/IPv6 literal, port 0 = LD2410C_TELEMETRY_PORT.
+bool ld2410c_telemetry_start(const char *collector, uint16_t port);
+void ld2410c_telemetry_stop();
+// One sender pass. Only the telemetry task calls this.
+void ld2410c_telemetry_pump();
+void ld2410c_telemetry_stats(ld2410c_telemetry_stats_t *out);
+
+// Callback runs on the sensor task for every transition; keep it short.
+void ld2410c_register_occupancy_callback(ld2410c_occupancy_callback_t cb, void *context);
+// Blocks until the next transition (UINT32_MAX = forever). Transitions not yet
+// consumed are coalesced: only the latest state is delivered.
+bool ld2410c_wait_occupancy_event(ld2410c_occupancy_event_t *event, uint32_t timeout_ms);
+
+// Frame history export (see ld2410_history.h for the stream format).
+// Single reader: begin, read until *done, nothing to release.
+size_t ld2410c_history_export_size();
+bool ld2410c_history_export_begin();
+size_t ld2410c_history_export_read(uint8_t *buf, size_t cap, bool *done);
+
 // Provided by MatterInterface to bind endpoint and update attributes
+void set_occupancy_attribute_value(uint16_t endpoint_id, bool occupied);
 void ld2410c_set_vendor_endpoint(uint16_t endpoint_id);
+void ld2410c_vendor_publish_begin(void);
+void ld2410c_vendor_publish_commit(void);
 void ld2410c_update_vendor_scalars(
 	uint16_t moving_dist_cm,
 	uint8_t moving_sig,
@@ -34,6 +205,23 @@ void ld2410c_update_vendor_arrays(
 	const uint8_t *stationary_thresholds, uint8_t st_len,
 	const char *fw_str
 );
+void ld2410c_update_vendor_capabilities(uint32_t capabilities);
+void ld2410c_update_vendor_rtt_stats(const uint8_t *stats, uint8_t len);
+void ld2410c_update_vendor_command_status(uint8_t command_id, uint8_t status);
+void ld2410c_update_vendor_recovery(uint32_t recoveries, uint8_t recovery_stage);
+void ld2410c_update_vendor_profile(uint8_t active_profile, uint16_t switch_ms);
+void ld2410c_update_vendor_trajectory(uint8_t state);
+void ld2410c_update_vendor_frame_repeats(uint8_t percent);
+void ld2410c_update_vendor_mode_stats(uint32_t switches, uint16_t last_switch_ms, uint8_t engineering_percent);
+void ld2410c_update_vendor_subgate_distance(uint16_t distance_cm);
+void ld2410c_update_vendor_boot(uint16_t first_frame_ms, uint8_t start_kind);
+void ld2410c_update_vendor_tracking(
+	uint16_t moving_dist_cm,
+	int16_t moving_velocity_cm_s,
+	uint16_t stationary_dist_cm,
+	uint16_t combined_dist_cm,
+	bool tracking_enabled
+);
 
 #ifdef __cplusplus
 }